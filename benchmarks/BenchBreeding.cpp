@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "Breeding.h"
+#include "WorkerPool.h"
+
+using namespace noname;
+
+namespace
+{
+    // Una generación de range(0) descendientes con range(1) hilos extra en el pool
+    void BM_BreedingGeneration(benchmark::State &state)
+    {
+        BreedingSimulator::Config config;
+        config.population = static_cast<size_t>(state.range(0));
+        WorkerPool pool{static_cast<size_t>(state.range(1))};
+        BreedingSimulator simulator{config};
+        simulator.seedFounders(pool);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(simulator.step(pool).mean);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_BreedingGeneration)->Args({1 << 14, 0})->Args({1 << 20, 0})->Args({1 << 20, 3})->Unit(benchmark::kMillisecond);
+}
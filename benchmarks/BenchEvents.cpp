@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "Event.h"
+#include "EventPayloads.h"
+#include "EventSubject.h"
+#include "EventQueue.h"
+#include "Character.h"
+
+// System includes
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace noname;
+
+namespace
+{
+    const std::string BENCH_CHARACTER_NAME = "Benchmark Hero";
+
+    // Evento DAMAGE_TAKEN como lo construía Character::takeDamage con la API de claves
+    void BM_EventStringKeys(benchmark::State &state)
+    {
+        int id = 0;
+        long long total = 0;
+        for (auto _ : state)
+        {
+            Event event(EventType::DAMAGE_TAKEN);
+            event.setData<std::string>("character_name", BENCH_CHARACTER_NAME);
+            event.setData<int>("damage", 5);
+            event.setData<int>("remaining_health", 100);
+            event.setData<int>("character_id", ++id);
+
+            // Lo que leía un observer (AchievementObserver::handleDamageTaken)
+            total += event.getData<std::string>("character_name").size();
+            total += event.getData<int>("damage");
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_EventTypedPayload(benchmark::State &state)
+    {
+        int id = 0;
+        long long total = 0;
+        for (auto _ : state)
+        {
+            DamagePayload payload{};
+            payload.targetId = ++id;
+            payload.damage = 5;
+            payload.remainingHealth = 100;
+            payload.targetName = BENCH_CHARACTER_NAME;
+            Event event = Event::make<EventType::DAMAGE_TAKEN>(payload);
+
+            const auto &damage = event.payload<EventType::DAMAGE_TAKEN>();
+            total += damage.targetName.size();
+            total += damage.damage;
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Observer sin migrar leyendo un evento tipado a través del adaptador
+    void BM_EventTypedPayloadStringKeyAdapter(benchmark::State &state)
+    {
+        int id = 0;
+        long long total = 0;
+        for (auto _ : state)
+        {
+            DamagePayload payload{};
+            payload.targetId = ++id;
+            payload.damage = 5;
+            payload.remainingHealth = 100;
+            payload.targetName = BENCH_CHARACTER_NAME;
+            Event event = Event::make<EventType::DAMAGE_TAKEN>(payload);
+
+            total += event.getData<std::string>("character_name").size();
+            total += event.getData<int>("damage");
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK(BM_EventStringKeys);
+BENCHMARK(BM_EventTypedPayload);
+BENCHMARK(BM_EventTypedPayloadStringKeyAdapter);
+
+namespace
+{
+    class BenchCountingObserver : public EventObserver
+    {
+    public:
+        explicit BenchCountingObserver(EventType handled) : _handled(handled) {}
+        void onEvent(const Event &) override { ++count; }
+        bool handlesEventType(EventType type) const override { return type == _handled; }
+        long long count{0};
+
+    private:
+        EventType _handled;
+    };
+
+    // Un subject con 8 observers de los que solo 2 manejan el evento notificado
+    void BM_EventSubjectNotify(benchmark::State &state)
+    {
+        LM.setLevel(Level::Error);
+        EventSubject subject;
+        std::vector<std::shared_ptr<BenchCountingObserver>> observers;
+        for (int i = 0; i < 8; ++i)
+        {
+            observers.push_back(std::make_shared<BenchCountingObserver>(i < 2 ? EventType::DAMAGE_TAKEN : EventType::LEVEL_UP));
+            subject.subscribe(observers.back());
+        }
+        Event event = Event::make<EventType::DAMAGE_TAKEN>(DamagePayload{});
+        for (auto _ : state)
+        {
+            subject.notifyObservers(event);
+        }
+        benchmark::DoNotOptimize(observers.front()->count);
+        state.SetItemsProcessed(state.iterations());
+        LM.setLevel(Level::Debug);
+    }
+}
+
+BENCHMARK(BM_EventSubjectNotify);
+
+namespace
+{
+    // takeDamage sobre 1000 personajes: 0 = observados con entrega inmediata,
+    // 1 = observados con entrega al final del tick, 2 = sin observers
+    void BM_CombatTickEvents(benchmark::State &state)
+    {
+        const bool deferred = state.range(0) == 1;
+        const bool observed = state.range(0) != 2;
+        LM.setLevel(Level::Error);
+        auto observer = std::make_shared<BenchCountingObserver>(EventType::DAMAGE_TAKEN);
+        std::vector<std::unique_ptr<Character>> characters;
+        for (int i = 0; i < 1000; ++i)
+        {
+            characters.push_back(std::make_unique<Character>("Bench"));
+            characters.back()->setDeferredNotifications(deferred);
+            if (observed)
+            {
+                characters.back()->subscribe(observer);
+            }
+        }
+        for (auto _ : state)
+        {
+            for (auto &character : characters)
+            {
+                character->takeDamage(1);
+                character->gainHealth(1);
+            }
+            EQ.flush();
+        }
+        benchmark::DoNotOptimize(observer->count);
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(characters.size()));
+        LM.setLevel(Level::Debug);
+    }
+}
+
+BENCHMARK(BM_CombatTickEvents)->Arg(0)->Arg(1)->Arg(2);
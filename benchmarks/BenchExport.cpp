@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "Exporters.h"
+#include "CharacterStore.h"
+
+// System includes
+#include <fstream>
+#include <filesystem>
+
+using namespace noname;
+
+namespace
+{
+    // Estadísticas de 1M filas del almacén a fichero; el argumento es el formato
+    void BM_ExportCharacterStats(benchmark::State &state)
+    {
+        CharacterStore store;
+        const int rows = 1 << 20;
+        store.reserve(rows);
+        for (int id = 0; id < rows; ++id)
+        {
+            auto slot = store.allocate(id);
+            store.experience(slot).gain(static_cast<unsigned long long>(id) * 37);
+            store.skills(slot).fill(static_cast<short>(id % 120));
+        }
+        const auto format = static_cast<ExportFormat>(state.range(0));
+        const auto path = std::filesystem::temp_directory_path() / ("noname_bench_stats" + std::string(ExportFormatExtension(format)));
+        for (auto _ : state)
+        {
+            std::ofstream out(path, std::ios::out | std::ios::trunc);
+            benchmark::DoNotOptimize(exportCharacterStats(store, out, format));
+        }
+        state.counters["bytes"] = static_cast<double>(std::filesystem::file_size(path));
+        std::filesystem::remove(path);
+        state.SetItemsProcessed(state.iterations() * rows);
+    }
+}
+
+BENCHMARK(BM_ExportCharacterStats)->Arg(static_cast<int>(ExportFormat::Csv))->Arg(static_cast<int>(ExportFormat::JsonLines))->Unit(benchmark::kMillisecond);
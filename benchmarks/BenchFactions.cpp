@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "Factions.h"
+
+// System includes
+#include <random>
+#include <vector>
+
+using namespace noname;
+
+namespace
+{
+    // range(0) facciones con hostilidades al azar y 1M de entidades repartidas entre ellas
+    void BM_FactionsFilterTargets(benchmark::State &state)
+    {
+        const int factionCount = static_cast<int>(state.range(0));
+        constexpr int ENTITIES = 1 << 20;
+        constexpr int CANDIDATES = 4096;
+        Factions factions;
+        std::mt19937 rng{3};
+        for (int i = 0; i < factionCount; ++i)
+        {
+            factions.addFaction("Faction");
+        }
+        for (int a = 0; a < factionCount; ++a)
+        {
+            for (int b = a + 1; b < factionCount; ++b)
+            {
+                factions.setHostile(static_cast<Factions::FactionId>(a), static_cast<Factions::FactionId>(b), rng() % 2 == 0);
+            }
+        }
+        std::uniform_int_distribution<int> pickFaction{0, factionCount - 1};
+        for (int id = 0; id < ENTITIES; ++id)
+        {
+            factions.join(id, static_cast<Factions::FactionId>(pickFaction(rng)));
+        }
+        std::uniform_int_distribution<int> pickEntity{0, ENTITIES - 1};
+        std::vector<int> candidates(CANDIDATES), targets;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            for (int &candidate : candidates)
+            {
+                candidate = pickEntity(rng);
+            }
+            state.ResumeTiming();
+            factions.filterTargets(pickEntity(rng), candidates, targets);
+            benchmark::DoNotOptimize(targets.data());
+        }
+        state.SetItemsProcessed(state.iterations() * CANDIDATES);
+    }
+}
+
+BENCHMARK(BM_FactionsFilterTargets)->Arg(16)->Arg(1024)->Unit(benchmark::kMicrosecond);
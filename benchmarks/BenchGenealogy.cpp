@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "Genealogy.h"
+
+// System includes
+#include <random>
+#include <vector>
+
+using namespace noname;
+
+namespace
+{
+    constexpr int FAMILY_GENERATIONS = 100;
+    constexpr int FAMILY_GENERATION_SIZE = 100000; // 10M miembros en total
+
+    // Población con apareamiento aleatorio dentro de cada generación; se construye una vez
+    Genealogy &familyTree()
+    {
+        static Genealogy genealogy = []() {
+            Genealogy tree;
+            tree.reserve(static_cast<size_t>(FAMILY_GENERATIONS) * FAMILY_GENERATION_SIZE);
+            std::mt19937 rng{42};
+            std::uniform_int_distribution<int> pick{0, FAMILY_GENERATION_SIZE - 1};
+            for (int id = 0; id < FAMILY_GENERATION_SIZE; ++id)
+            {
+                tree.addMember(id);
+            }
+            for (int generation = 1; generation < FAMILY_GENERATIONS; ++generation)
+            {
+                const int previous = (generation - 1) * FAMILY_GENERATION_SIZE;
+                for (int i = 0; i < FAMILY_GENERATION_SIZE; ++i)
+                {
+                    tree.addMember(generation * FAMILY_GENERATION_SIZE + i, previous + pick(rng), previous + pick(rng));
+                }
+            }
+            return tree;
+        }();
+        return genealogy;
+    }
+
+    int randomLastGenerationMember(std::mt19937 &rng)
+    {
+        std::uniform_int_distribution<int> pick{0, FAMILY_GENERATION_SIZE - 1};
+        return (FAMILY_GENERATIONS - 1) * FAMILY_GENERATION_SIZE + pick(rng);
+    }
+
+    void BM_GenealogyAncestors(benchmark::State &state)
+    {
+        auto &tree = familyTree();
+        std::mt19937 rng{7};
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(tree.getAncestors(randomLastGenerationMember(rng), static_cast<int>(state.range(0))));
+        }
+    }
+
+    void BM_GenealogyMostRecentCommonAncestor(benchmark::State &state)
+    {
+        auto &tree = familyTree();
+        std::mt19937 rng{7};
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(tree.getMostRecentCommonAncestor(randomLastGenerationMember(rng), randomLastGenerationMember(rng), static_cast<int>(state.range(0))));
+        }
+    }
+
+    // Parentesco en las últimas range(0) generaciones, entre parejas al azar de la última
+    void BM_GenealogyKinship(benchmark::State &state)
+    {
+        auto &tree = familyTree();
+        tree.setKinshipHorizon(FAMILY_GENERATIONS - 1 - static_cast<int>(state.range(0)));
+        std::mt19937 rng{7};
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(tree.getKinship(randomLastGenerationMember(rng), randomLastGenerationMember(rng)));
+        }
+        tree.setKinshipHorizon(0);
+    }
+
+    void BM_GenealogySignatureFilter(benchmark::State &state)
+    {
+        auto &tree = familyTree();
+        std::mt19937 rng{7};
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(tree.mayShareRecentAncestor(randomLastGenerationMember(rng), randomLastGenerationMember(rng)));
+        }
+    }
+}
+
+BENCHMARK(BM_GenealogyAncestors)->Arg(4)->Arg(8)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GenealogyMostRecentCommonAncestor)->Arg(4)->Arg(8)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GenealogyKinship)->Arg(4)->Arg(8)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GenealogySignatureFilter)->Unit(benchmark::kMicrosecond);
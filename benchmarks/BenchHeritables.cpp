@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "Heritables.h"
+#include "Rng.h"
+
+// System includes
+#include <random>
+#include <vector>
+
+using namespace noname;
+
+namespace
+{
+    // Lo que hacía cada Heritables() antes: un random_device y un mt19937 nuevos
+    void BM_HeritablesCreateRandomDevice(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            std::random_device rd;
+            std::mt19937 gen(rd());
+            std::uniform_int_distribution<> attributesDist(0, 100);
+            std::vector<short> heritables;
+            for (size_t i = 0; i < Heritables::COUNT; ++i)
+            {
+                heritables.push_back(static_cast<short>(attributesDist(gen)));
+            }
+            benchmark::DoNotOptimize(heritables.data());
+        }
+    }
+    BENCHMARK(BM_HeritablesCreateRandomDevice);
+
+    void BM_HeritablesCreate(benchmark::State &state)
+    {
+        Rng rng{1};
+        for (auto _ : state)
+        {
+            Heritables heritables{rng};
+            benchmark::DoNotOptimize(heritables);
+        }
+    }
+    BENCHMARK(BM_HeritablesCreate);
+
+    void BM_HeritablesBreed(benchmark::State &state)
+    {
+        Rng rng{1};
+        Heritables father{rng}, mother{rng}, child{rng};
+        for (auto _ : state)
+        {
+            child.determineHeritablesValues(father, mother, rng);
+            benchmark::DoNotOptimize(child);
+        }
+    }
+    BENCHMARK(BM_HeritablesBreed);
+}
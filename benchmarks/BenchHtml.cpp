@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "HtmlBuilder.h"
+#include "HtmlWriter.h"
+
+// System includes
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+using namespace noname;
+
+namespace
+{
+    // Tabla de ranking de range(0) filas construida con HtmlBuilder, como printRanking antes
+    void BM_HtmlBuilderRankingTable(benchmark::State &state)
+    {
+        const int rows = static_cast<int>(state.range(0));
+        for (auto _ : state)
+        {
+            HtmlBuilder table{"table"};
+            table.add_child("caption", "Ranking of: CLUB");
+            table.add_child(HtmlBuilder{"tr"}.add_child("th", "Player ID").add_child("th", "Level").add_child("th", "Skill"));
+            for (int row = 0; row < rows; ++row)
+            {
+                table.add_child(HtmlBuilder{"tr"}.add_child("td", std::to_string(row)).add_child("td", std::to_string(row % 100)).add_child("td", std::to_string(row % 1000)));
+            }
+            auto html = table.str();
+            benchmark::DoNotOptimize(html.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void writeRankingTable(HtmlWriter &writer, int rows)
+    {
+        writer.open("table");
+        writer.element("caption", "Ranking of: CLUB");
+        writer.open("tr").element("th", "Player ID").element("th", "Level").element("th", "Skill").close();
+        for (int row = 0; row < rows; ++row)
+        {
+            writer.open("tr").element("td", row).element("td", row % 100).element("td", row % 1000).close();
+        }
+        writer.close();
+    }
+
+    // La misma tabla en un std::string reutilizado entre iteraciones
+    void BM_HtmlWriterRankingTable(benchmark::State &state)
+    {
+        std::string html;
+        for (auto _ : state)
+        {
+            html.clear();
+            HtmlWriter writer{html};
+            writeRankingTable(writer, static_cast<int>(state.range(0)));
+            benchmark::DoNotOptimize(html.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // La misma tabla directamente a fichero, por bloques de 64 KiB
+    void BM_HtmlWriterRankingFile(benchmark::State &state)
+    {
+        const auto path = std::filesystem::temp_directory_path() / "noname_bench_ranking.html";
+        for (auto _ : state)
+        {
+            std::ofstream out(path, std::ios::out | std::ios::trunc);
+            HtmlWriter writer{out};
+            writeRankingTable(writer, static_cast<int>(state.range(0)));
+        }
+        std::filesystem::remove(path);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(BM_HtmlBuilderRankingTable)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HtmlWriterRankingTable)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HtmlWriterRankingFile)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
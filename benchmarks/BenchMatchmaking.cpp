@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "Matchmaking.h"
+#include "WorkerPool.h"
+
+// System includes
+#include <random>
+#include <vector>
+
+using namespace noname;
+
+namespace
+{
+    Matchmaker makeMatchmaker(int candidates)
+    {
+        Matchmaker matchmaker;
+        matchmaker.reserve(static_cast<size_t>(candidates));
+        std::mt19937 rng{5};
+        std::uniform_int_distribution<int> value{1, 100};
+        for (int id = 0; id < candidates; ++id)
+        {
+            std::array<short, HeritablesKdTree::DIMENSIONS> heritables;
+            for (short &heritable : heritables)
+            {
+                heritable = static_cast<short>(value(rng));
+            }
+            matchmaker.add(id, heritables);
+        }
+        matchmaker.build();
+        return matchmaker;
+    }
+
+    // Las 8 mejores parejas de un candidato al azar entre range(0)
+    void BM_MatchmakingFindPartners(benchmark::State &state)
+    {
+        const int candidates = static_cast<int>(state.range(0));
+        const Matchmaker matchmaker = makeMatchmaker(candidates);
+        std::mt19937 rng{9};
+        std::uniform_int_distribution<int> pick{0, candidates - 1};
+        std::vector<MatchCandidate> partners;
+        for (auto _ : state)
+        {
+            matchmaker.findPartners(pick(rng), 8, [](int, int) { return true; }, partners);
+            benchmark::DoNotOptimize(partners.data());
+        }
+    }
+
+    // Lo mismo recorriendo a todos los candidatos, como referencia
+    void BM_MatchmakingBruteForce(benchmark::State &state)
+    {
+        const int candidates = static_cast<int>(state.range(0));
+        std::vector<HeritablesKdTree::Point> points(static_cast<size_t>(candidates));
+        std::mt19937 rng{5};
+        std::uniform_real_distribution<float> value{1.0f, 100.0f};
+        for (auto &point : points)
+        {
+            for (float &coordinate : point)
+            {
+                coordinate = value(rng);
+            }
+        }
+        std::uniform_int_distribution<int> pick{0, candidates - 1};
+        std::vector<MatchCandidate> best;
+        for (auto _ : state)
+        {
+            const auto &query = points[static_cast<size_t>(pick(rng))];
+            best.clear();
+            for (int id = 0; id < candidates; ++id)
+            {
+                float distance = 0.0f;
+                for (size_t axis = 0; axis < query.size(); ++axis)
+                {
+                    const float diff = points[static_cast<size_t>(id)][axis] - query[axis];
+                    distance += diff * diff;
+                }
+                best.push_back({id, distance});
+            }
+            std::partial_sort(best.begin(), best.begin() + 8, best.end(), [](const auto &a, const auto &b) { return a.distance < b.distance; });
+            benchmark::DoNotOptimize(best.data());
+        }
+    }
+
+    // Emparejar a toda una generación de range(0) candidatos
+    void BM_MatchmakingPairGeneration(benchmark::State &state)
+    {
+        Matchmaker matchmaker = makeMatchmaker(static_cast<int>(state.range(0)));
+        WorkerPool pool;
+        for (auto _ : state)
+        {
+            auto pairs = matchmaker.pairGeneration(pool);
+            benchmark::DoNotOptimize(pairs.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(BM_MatchmakingFindPartners)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MatchmakingBruteForce)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MatchmakingPairGeneration)->Arg(100000)->Unit(benchmark::kMillisecond);
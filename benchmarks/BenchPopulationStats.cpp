@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "PopulationStats.h"
+#include "CharacterStore.h"
+#include "WorkerPool.h"
+
+// System includes
+#include <random>
+#include <vector>
+
+using namespace noname;
+
+namespace
+{
+    constexpr int WORLD_SIZE = 1 << 20;
+
+    // Almacén con WORLD_SIZE personajes, un 1% de filas liberadas
+    CharacterStore &world()
+    {
+        static CharacterStore store = []
+        {
+            CharacterStore created;
+            created.reserve(WORLD_SIZE);
+            Rng rng{1};
+            for (int id = 0; id < WORLD_SIZE; ++id)
+            {
+                const CharacterStore::Slot slot = created.allocate(id);
+                created.heritables(slot) = Heritables{rng};
+                for (short &skill : created.skills(slot))
+                {
+                    skill = static_cast<short>(rng.uniformInt(10, 120));
+                }
+            }
+            for (int id = 0; id < WORLD_SIZE; id += 100)
+            {
+                created.release(static_cast<CharacterStore::Slot>(id));
+            }
+            return created;
+        }();
+        return store;
+    }
+
+    template <bool SIMD>
+    void BM_PopulationMomentsSkills(benchmark::State &state)
+    {
+        const auto &column = world().skillsColumn();
+        const auto *values = reinterpret_cast<const std::int16_t *>(column.data());
+        for (auto _ : state)
+        {
+            populationstats::Moments<std::int16_t, CharacterStore::MAX_SKILLS> moments;
+#ifdef NONAME_SIMD_SSE2
+            if constexpr (SIMD)
+            {
+                populationstats::accumulateSse2(values, column.size(), moments);
+            }
+            else
+#endif
+            {
+                populationstats::accumulateScalar(values, column.size(), moments);
+            }
+            benchmark::DoNotOptimize(moments);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(column.size()));
+    }
+    BENCHMARK(BM_PopulationMomentsSkills<false>)->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_PopulationMomentsSkills<true>)->Unit(benchmark::kMillisecond);
+
+    template <bool SIMD>
+    void BM_PopulationMomentsHeritables(benchmark::State &state)
+    {
+        const auto &column = world().heritablesColumn();
+        const auto *values = reinterpret_cast<const std::uint8_t *>(column.data());
+        for (auto _ : state)
+        {
+            populationstats::Moments<std::uint8_t, Heritables::COUNT> moments;
+#ifdef NONAME_SIMD_SSE2
+            if constexpr (SIMD)
+            {
+                populationstats::accumulateSse2(values, column.size(), moments);
+            }
+            else
+#endif
+            {
+                populationstats::accumulateScalar(values, column.size(), moments);
+            }
+            benchmark::DoNotOptimize(moments);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(column.size()));
+    }
+    BENCHMARK(BM_PopulationMomentsHeritables<false>)->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_PopulationMomentsHeritables<true>)->Unit(benchmark::kMillisecond);
+
+    // Informe completo (heritables y skills, con histogramas) de un mundo de 1M personajes
+    void BM_PopulationReport(benchmark::State &state)
+    {
+        CharacterStore &store = world();
+        WorkerPool pool{static_cast<size_t>(state.range(0))};
+        const PopulationStatsOptions options{state.range(1) != 0, &pool};
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(computePopulationReport(store, options));
+        }
+    }
+    BENCHMARK(BM_PopulationReport)->Args({0, 0})->Args({0, 1})->Args({3, 1})->Unit(benchmark::kMillisecond);
+}
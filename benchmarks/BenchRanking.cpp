@@ -0,0 +1,205 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "Ranking.h"
+#include "RankingManager.h"
+#include "WorkerPool.h"
+
+// System includes
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+using namespace noname;
+
+namespace
+{
+    std::vector<RankingEntry> makeRankingEntries(size_t count)
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> skill(1, 1000);
+        std::vector<RankingEntry> entries;
+        entries.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            entries.push_back({static_cast<int>(i), static_cast<short>(skill(rng)), 1});
+        }
+        return entries;
+    }
+
+    // Como el Ranking anterior: push_back y ordenar todo en cada alta
+    void BM_RankingSortOnInsert(benchmark::State &state)
+    {
+        const auto entries = makeRankingEntries(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            std::vector<RankingEntry> ranking;
+            for (const auto &entry : entries)
+            {
+                ranking.push_back(entry);
+                std::sort(ranking.begin(), ranking.end(), RankingOrder{});
+            }
+            benchmark::DoNotOptimize(ranking.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_RankingTreeInsert(benchmark::State &state)
+    {
+        const auto entries = makeRankingEntries(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Ranking<SkillType::CLUB> ranking;
+            for (const auto &entry : entries)
+            {
+                ranking.updatePlayer(entry.playerId, entry.skill, entry.level);
+            }
+            benchmark::DoNotOptimize(ranking.size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Posición de un jugador: búsqueda lineal en el vector ordenado frente al
+    // índice de la instantánea publicada
+    void BM_RankingLinearRank(benchmark::State &state)
+    {
+        auto entries = makeRankingEntries(static_cast<size_t>(state.range(0)));
+        std::sort(entries.begin(), entries.end(), RankingOrder{});
+        int id = 0;
+        for (auto _ : state)
+        {
+            id = (id + 7919) % static_cast<int>(entries.size());
+            auto it = std::find_if(entries.begin(), entries.end(), [id](const RankingEntry &entry)
+                                   { return entry.playerId == id; });
+            benchmark::DoNotOptimize(it);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_RankingSnapshotRank(benchmark::State &state)
+    {
+        Ranking<SkillType::CLUB> ranking;
+        ranking.assignPlayers(makeRankingEntries(static_cast<size_t>(state.range(0))));
+        ranking.publish();
+        int id = 0;
+        for (auto _ : state)
+        {
+            id = (id + 7919) % static_cast<int>(ranking.size());
+            benchmark::DoNotOptimize(ranking.getPlayerRanking(id));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Una página de 100 filas en mitad del ranking: no debería depender del total
+    void BM_RankingExportPage(benchmark::State &state)
+    {
+        Ranking<SkillType::CLUB> ranking;
+        ranking.assignPlayers(makeRankingEntries(static_cast<size_t>(state.range(0))));
+        ranking.publish();
+        const auto directory = std::filesystem::temp_directory_path();
+        const size_t pageSize = 100;
+        const size_t page = ranking.getPageCount(pageSize) / 2;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(ranking.exportPage(page, pageSize, directory));
+        }
+        std::filesystem::remove(ranking.getPagePath(page, directory));
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pageSize));
+    }
+
+    // Ordenación de 1M filas; el argumento es el número de hilos del pool
+    void BM_RankingParallelSort(benchmark::State &state)
+    {
+        const auto entries = makeRankingEntries(1 << 20);
+        WorkerPool pool{static_cast<size_t>(state.range(0))};
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto keys = entries;
+            state.ResumeTiming();
+            parallelSort(pool, keys.begin(), keys.end(), RankingOrder{});
+            benchmark::DoNotOptimize(keys.data());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(entries.size()));
+    }
+
+    // Reconstrucción de las seis skills con 64k jugadores, sin exportar
+    void BM_RankingRefreshAll(benchmark::State &state)
+    {
+        LM.setLevel(Level::Error);
+        std::vector<std::unique_ptr<Player>> owned;
+        std::vector<const Player *> players;
+        for (int i = 0; i < (1 << 16); ++i)
+        {
+            owned.push_back(std::make_unique<Player>());
+            players.push_back(owned.back().get());
+        }
+        WorkerPool pool{static_cast<size_t>(state.range(0))};
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(RM.refreshAll(players, 0, pool).total);
+        }
+        RM.shutDown();
+        LM.setLevel(Level::Debug);
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(players.size()) * 6);
+    }
+
+    // Tick del escritor (1000 cambios de skill y una publicación) con
+    // range(0) hilos lectores consultando instantáneas sin parar
+    void BM_RankingWriterTickWithReaders(benchmark::State &state)
+    {
+        Ranking<SkillType::CLUB> ranking;
+        ranking.assignPlayers(makeRankingEntries(1 << 16));
+        ranking.publish();
+
+        std::atomic<bool> done{false};
+        std::atomic<long long> reads{0};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < state.range(0); ++r)
+        {
+            readers.emplace_back([&ranking, &done, &reads, r]()
+            {
+                long long local = 0;
+                int id = r;
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    auto snapshot = ranking.getSnapshot();
+                    id = (id + 7919) & 0xFFFF;
+                    benchmark::DoNotOptimize(snapshot->topK(100));
+                    benchmark::DoNotOptimize(snapshot->getPlayerRanking(id));
+                    ++local;
+                }
+                reads += local;
+            });
+        }
+
+        std::mt19937 rng(5);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                ranking.updateSkill(static_cast<int>(rng() & 0xFFFF), static_cast<short>(rng() % 1000));
+            }
+            benchmark::DoNotOptimize(ranking.publish());
+        }
+        done = true;
+        for (auto &reader : readers)
+        {
+            reader.join();
+        }
+        state.counters["reads"] = benchmark::Counter(static_cast<double>(reads.load()), benchmark::Counter::kIsRate);
+    }
+}
+
+BENCHMARK(BM_RankingSortOnInsert)->Arg(1 << 10)->Arg(1 << 12);
+BENCHMARK(BM_RankingTreeInsert)->Arg(1 << 10)->Arg(1 << 12)->Arg(1 << 19);
+BENCHMARK(BM_RankingLinearRank)->Arg(1 << 12)->Arg(1 << 19);
+BENCHMARK(BM_RankingSnapshotRank)->Arg(1 << 12)->Arg(1 << 19);
+BENCHMARK(BM_RankingExportPage)->Arg(1 << 12)->Arg(1 << 19);
+BENCHMARK(BM_RankingParallelSort)->Arg(0)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(BM_RankingRefreshAll)->Arg(0)->Arg(4)->UseRealTime();
+BENCHMARK(BM_RankingWriterTickWithReaders)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
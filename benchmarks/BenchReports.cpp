@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "Character.h"
+#include "CharacterStore.h"
+#include "CharacterReportCache.h"
+#include "CharacterReportSink.h"
+
+// System includes
+#include <memory>
+#include <vector>
+
+using namespace noname;
+
+namespace
+{
+    constexpr size_t REPORT_CHARACTERS = 10000;
+
+    struct ReportWorld
+    {
+        std::shared_ptr<CharacterStore> store{std::make_shared<CharacterStore>()};
+        std::vector<std::unique_ptr<Character>> characters;
+
+        ReportWorld()
+        {
+            characters.reserve(REPORT_CHARACTERS);
+            for (size_t i = 0; i < REPORT_CHARACTERS; ++i)
+            {
+                characters.push_back(std::make_unique<Character>("Creature", store));
+            }
+        }
+
+        // Cambia perMille de cada mil personajes
+        void changeSome(size_t perMille, size_t round)
+        {
+            const size_t changed = characters.size() * perMille / 1000;
+            for (size_t i = 0; i < changed; ++i)
+            {
+                characters[(round * changed + i) % characters.size()]->takeDamage(1);
+            }
+        }
+    };
+
+    // Pasada periódica anterior: informe nuevo para todos los personajes
+    void BM_ReportsRenderAll(benchmark::State &state)
+    {
+        ReportWorld world;
+        RS.startUp();
+        size_t round = 0;
+        for (auto _ : state)
+        {
+            world.changeSome(static_cast<size_t>(state.range(0)), round++);
+            for (const auto &character : world.characters)
+            {
+                character->writeCharacterInfo();
+            }
+            state.PauseTiming();
+            RS.flush();
+            state.ResumeTiming();
+        }
+        RS.shutDown();
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(REPORT_CHARACTERS));
+    }
+
+    // Con la caché: solo los personajes cuya versión ha cambiado
+    void BM_ReportsExportChanged(benchmark::State &state)
+    {
+        ReportWorld world;
+        CharacterReportCache cache;
+        for (const auto &character : world.characters)
+        {
+            cache.track(*character);
+        }
+        RS.startUp();
+        cache.exportChanged(*world.store);
+        RS.flush();
+        size_t round = 0;
+        for (auto _ : state)
+        {
+            world.changeSome(static_cast<size_t>(state.range(0)), round++);
+            benchmark::DoNotOptimize(cache.exportChanged(*world.store));
+            state.PauseTiming();
+            RS.flush();
+            state.ResumeTiming();
+        }
+        RS.shutDown();
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(REPORT_CHARACTERS));
+    }
+}
+
+// Argumento: personajes cambiados por cada mil
+BENCHMARK(BM_ReportsRenderAll)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReportsExportChanged)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
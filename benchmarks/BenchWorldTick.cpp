@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "CharacterStore.h"
+#include "CharacterData.h"
+
+// System includes
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace noname;
+
+namespace
+{
+    constexpr int REGEN_AMOUNT = 1;
+    constexpr int DAMAGE_AMOUNT = 1;
+
+    // Réplica del layout AoS anterior de Character: los datos calientes
+    // rodeados del resto de miembros (nombre, heredables, inventario,
+    // estrategia, observers...) y cada objeto en su propia reserva de memoria.
+    struct AosCharacter
+    {
+        int id{0};
+        std::string name{"Noname"};
+        short level{1};
+        short magicLevel{1};
+        HealthData health{};
+        ManaData mana{};
+        ExperienceData experience{};
+        ExperienceData magicExperience{};
+        CapacityData capacity{};
+        SpeedData speed{};
+        CharacterStore::SkillArray skills{};
+        CharacterStore::SkillArray skillTries{};
+        bool isDead{false};
+        std::vector<short> heritables = std::vector<short>(6, 50);
+        std::array<std::shared_ptr<void>, 11> inventory{};
+        std::unique_ptr<int> attackStrategy{std::make_unique<int>(0)};
+        std::vector<std::weak_ptr<void>> observers{};
+    };
+
+    std::vector<std::unique_ptr<AosCharacter>> makeAosWorld(size_t count)
+    {
+        // Reserva en orden aleatorio para que el heap no quede secuencial,
+        // como ocurre en un mundo que lleva tiempo creando y destruyendo criaturas.
+        std::vector<std::unique_ptr<AosCharacter>> pool(count);
+        std::vector<size_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), std::mt19937{42});
+        for (auto index : order)
+        {
+            pool[index] = std::make_unique<AosCharacter>();
+            pool[index]->id = static_cast<int>(index);
+        }
+        return pool;
+    }
+
+    void BM_WorldTickAoS(benchmark::State &state)
+    {
+        auto world = makeAosWorld(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            for (auto &creature : world)
+            {
+                creature->health.takeDamage(DAMAGE_AMOUNT);
+            }
+            for (auto &creature : world)
+            {
+                if (!creature->health.isDead())
+                {
+                    creature->health.heal(REGEN_AMOUNT);
+                    creature->mana.restore(REGEN_AMOUNT);
+                }
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_WorldTickSoA(benchmark::State &state)
+    {
+        CharacterStore store;
+        const auto count = static_cast<size_t>(state.range(0));
+        store.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            store.allocate(static_cast<int>(i));
+        }
+        for (auto _ : state)
+        {
+            store.applyDamage(DAMAGE_AMOUNT);
+            store.regenerate(REGEN_AMOUNT, REGEN_AMOUNT);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(BM_WorldTickAoS)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_WorldTickSoA)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMicrosecond);
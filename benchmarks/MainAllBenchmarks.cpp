@@ -0,0 +1,16 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchBreeding.cpp"
+#include "BenchEvents.cpp"
+#include "BenchExport.cpp"
+#include "BenchFactions.cpp"
+#include "BenchGenealogy.cpp"
+#include "BenchHeritables.cpp"
+#include "BenchHtml.cpp"
+#include "BenchMatchmaking.cpp"
+#include "BenchPopulationStats.cpp"
+#include "BenchRanking.cpp"
+#include "BenchReports.cpp"
+#include "BenchWorldTick.cpp"
+
+BENCHMARK_MAIN();
@@ -3,8 +3,12 @@
 
 #include "EventObserver.h"
 #include "LogManager.h"
-#include <unordered_map>
+#include "FlatIdMap.h"
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace noname
@@ -14,69 +18,149 @@ namespace noname
      * 
      * Rastrea estadísticas de personajes y desbloquea achievements
      * basados en eventos del juego.
+     *
+     * Las estadísticas se guardan por character_id en un vector denso (un
+     * FlatIdMap traduce id -> posición) y los achievements desbloqueados en
+     * un bitset por personaje. Cada lista de umbrales lleva un cursor por
+     * personaje con el siguiente umbral pendiente, así que comprobarla es O(1).
      */
     class AchievementObserver : public EventObserver {
+    public:
+        enum class Achievement : std::uint8_t {
+            FIRST_BLOOD,
+            WARRIOR,
+            VETERAN_FIGHTER,
+            DAMAGE_DEALER,
+            APPRENTICE,
+            JOURNEYMAN,
+            EXPERT,
+            MASTER,
+            LEGENDARY,
+            PERSISTENT,
+            FIRST_VICTORY,
+            SKILLED_FIGHTER,
+            COMBAT_MASTER,
+            COUNT
+        };
+        
+        static constexpr size_t ACHIEVEMENT_COUNT = static_cast<size_t>(Achievement::COUNT);
+        using AchievementSet = std::bitset<ACHIEVEMENT_COUNT>;
+        
     private:
-        // Estadísticas por personaje
-        std::unordered_map<std::string, int> damageDealt_;
-        std::unordered_map<std::string, int> damageTaken_;
-        std::unordered_map<std::string, int> experienceGained_;
-        std::unordered_map<std::string, int> levelsGained_;
-        std::unordered_map<std::string, int> combatsWon_;
-        std::unordered_map<std::string, int> deaths_;
+        struct AchievementInfo {
+            std::string_view name;
+            std::string_view description;
+        };
         
-        // Achievements desbloqueados por personaje
-        std::unordered_map<std::string, std::vector<std::string>> unlockedAchievements_;
+        static constexpr std::array<AchievementInfo, ACHIEVEMENT_COUNT> ACHIEVEMENTS = {{
+            {"First Blood", "Deal 100 damage total"},
+            {"Warrior", "Deal 1000 damage total"},
+            {"Veteran Fighter", "Deal 5000 damage total"},
+            {"Damage Dealer", "Deal 10000 damage total"},
+            {"Apprentice", "Reach level 5"},
+            {"Journeyman", "Reach level 10"},
+            {"Expert", "Reach level 20"},
+            {"Master", "Reach level 50"},
+            {"Legendary", "Reach level 100"},
+            {"Persistent", "Die 5 times but keep trying"},
+            {"First Victory", "Win your first combat"},
+            {"Skilled Fighter", "Win 10 combats"},
+            {"Combat Master", "Win 50 combats"},
+        }};
         
-        // Configuración de achievements
+        // Configuración de achievements, en orden creciente de valor
         struct AchievementThreshold {
             int value;
-            std::string name;
-            std::string description;
+            Achievement achievement;
         };
         
-        std::vector<AchievementThreshold> damageThresholds_ = {
-            {100, "First Blood", "Deal 100 damage total"},
-            {1000, "Warrior", "Deal 1000 damage total"},
-            {5000, "Veteran Fighter", "Deal 5000 damage total"},
-            {10000, "Damage Dealer", "Deal 10000 damage total"}
-        };
+        static constexpr std::array<AchievementThreshold, 4> DAMAGE_THRESHOLDS = {{
+            {100, Achievement::FIRST_BLOOD},
+            {1000, Achievement::WARRIOR},
+            {5000, Achievement::VETERAN_FIGHTER},
+            {10000, Achievement::DAMAGE_DEALER}
+        }};
+        
+        static constexpr std::array<AchievementThreshold, 5> LEVEL_THRESHOLDS = {{
+            {5, Achievement::APPRENTICE},
+            {10, Achievement::JOURNEYMAN},
+            {20, Achievement::EXPERT},
+            {50, Achievement::MASTER},
+            {100, Achievement::LEGENDARY}
+        }};
+        
+        static constexpr std::array<AchievementThreshold, 3> COMBAT_THRESHOLDS = {{
+            {1, Achievement::FIRST_VICTORY},
+            {10, Achievement::SKILLED_FIGHTER},
+            {50, Achievement::COMBAT_MASTER}
+        }};
         
-        std::vector<AchievementThreshold> levelThresholds_ = {
-            {5, "Apprentice", "Reach level 5"},
-            {10, "Journeyman", "Reach level 10"},
-            {20, "Expert", "Reach level 20"},
-            {50, "Master", "Reach level 50"},
-            {100, "Legendary", "Reach level 100"}
+        static constexpr int PERSISTENT_DEATHS = 5;
+        
+        // Estadísticas por personaje
+        struct CharacterStats {
+            int damageDealt{0};
+            int damageTaken{0};
+            int experienceGained{0};
+            int levelsGained{0};
+            int combatsWon{0};
+            int deaths{0};
+            AchievementSet unlocked{};
+            // Siguiente umbral pendiente de cada lista
+            std::uint8_t nextDamageThreshold{0};
+            std::uint8_t nextLevelThreshold{0};
+            std::uint8_t nextCombatThreshold{0};
+            int characterId{0};
+            std::string name; // Solo para mensajes y consultas por nombre
         };
         
+        std::vector<CharacterStats> stats_;
+        FlatIdMap<std::uint32_t> index_;
+        
+        static const CharacterStats& emptyStats() {
+            static const CharacterStats empty{};
+            return empty;
+        }
+        
     public:
         AchievementObserver() = default;
         
         void onEvent(const Event& event) override {
             switch (event.getType()) {
                 case EventType::DAMAGE_DEALT:
-                    handleDamageDealt(event);
+                    if (const auto* damage = event.tryPayload<DamagePayload>()) {
+                        handleDamageDealt(*damage);
+                    }
                     break;
                     
                 case EventType::DAMAGE_TAKEN:
-                    handleDamageTaken(event);
+                    if (const auto* damage = event.tryPayload<DamagePayload>()) {
+                        handleDamageTaken(*damage);
+                    }
                     break;
                     
                 case EventType::EXPERIENCE_GAINED:
-                    handleExperienceGained(event);
+                    if (const auto* experience = event.tryPayload<ExperiencePayload>()) {
+                        handleExperienceGained(*experience);
+                    }
                     break;
                     
                 case EventType::LEVEL_UP:
-                    handleLevelUp(event);
+                    if (const auto* level = event.tryPayload<LevelPayload>()) {
+                        handleLevelUp(*level);
+                    }
                     break;
                     
                 case EventType::CHARACTER_DIED:
-                    handleCharacterDied(event);
+                    if (const auto* character = event.tryPayload<CharacterPayload>()) {
+                        handleCharacterDied(*character);
+                    }
                     break;
                     
                 case EventType::COMBAT_ENDED:
-                    handleCombatEnded(event);
+                    if (const auto* combat = event.tryPayload<CombatPayload>()) {
+                        handleCombatEnded(*combat);
+                    }
                     break;
                     
                 default:
@@ -106,55 +190,103 @@ namespace noname
             return 75; // Prioridad media-baja
         }
         
-        // Métodos para obtener estadísticas
-        int getTotalDamageDealt(const std::string& character) const {
-            auto it = damageDealt_.find(character);
-            return it != damageDealt_.end() ? it->second : 0;
+        static std::string_view getAchievementName(Achievement achievement) {
+            return ACHIEVEMENTS[static_cast<size_t>(achievement)].name;
         }
         
-        int getTotalDamageTaken(const std::string& character) const {
-            auto it = damageTaken_.find(character);
-            return it != damageTaken_.end() ? it->second : 0;
-        }
+        // Métodos para obtener estadísticas por id
+        int getTotalDamageDealt(int characterId) const { return statsOf(characterId).damageDealt; }
+        int getTotalDamageTaken(int characterId) const { return statsOf(characterId).damageTaken; }
+        int getTotalExperienceGained(int characterId) const { return statsOf(characterId).experienceGained; }
+        int getLevelsGained(int characterId) const { return statsOf(characterId).levelsGained; }
+        int getCombatsWon(int characterId) const { return statsOf(characterId).combatsWon; }
+        int getDeaths(int characterId) const { return statsOf(characterId).deaths; }
+        AchievementSet getAchievementSet(int characterId) const { return statsOf(characterId).unlocked; }
         
-        int getTotalExperienceGained(const std::string& character) const {
-            auto it = experienceGained_.find(character);
-            return it != experienceGained_.end() ? it->second : 0;
+        bool hasAchievement(int characterId, Achievement achievement) const {
+            return statsOf(characterId).unlocked.test(static_cast<size_t>(achievement));
         }
         
-        int getLevelsGained(const std::string& character) const {
-            auto it = levelsGained_.find(character);
-            return it != levelsGained_.end() ? it->second : 0;
+        std::vector<std::string> getUnlockedAchievements(int characterId) const {
+            return achievementNames(statsOf(characterId).unlocked);
         }
         
-        int getCombatsWon(const std::string& character) const {
-            auto it = combatsWon_.find(character);
-            return it != combatsWon_.end() ? it->second : 0;
-        }
-        
-        int getDeaths(const std::string& character) const {
-            auto it = deaths_.find(character);
-            return it != deaths_.end() ? it->second : 0;
-        }
+        // Consultas por nombre (compatibilidad): los nombres no son únicos,
+        // se usa el primer personaje registrado con ese nombre. O(personajes).
+        int getTotalDamageDealt(const std::string& character) const { return statsOf(character).damageDealt; }
+        int getTotalDamageTaken(const std::string& character) const { return statsOf(character).damageTaken; }
+        int getTotalExperienceGained(const std::string& character) const { return statsOf(character).experienceGained; }
+        int getLevelsGained(const std::string& character) const { return statsOf(character).levelsGained; }
+        int getCombatsWon(const std::string& character) const { return statsOf(character).combatsWon; }
+        int getDeaths(const std::string& character) const { return statsOf(character).deaths; }
         
         std::vector<std::string> getUnlockedAchievements(const std::string& character) const {
-            auto it = unlockedAchievements_.find(character);
-            return it != unlockedAchievements_.end() ? it->second : std::vector<std::string>{};
+            return achievementNames(statsOf(character).unlocked);
         }
         
+        size_t getTrackedCharacterCount() const { return stats_.size(); }
+        
         /**
          * @brief Obtiene estadísticas completas de un personaje
          */
+        std::string getCharacterStats(int characterId) const {
+            return formatStats(statsOf(characterId));
+        }
+        
         std::string getCharacterStats(const std::string& character) const {
-            std::string stats = "=== " + character + " Statistics ===\n";
-            stats += "Damage Dealt: " + std::to_string(getTotalDamageDealt(character)) + "\n";
-            stats += "Damage Taken: " + std::to_string(getTotalDamageTaken(character)) + "\n";
-            stats += "Experience Gained: " + std::to_string(getTotalExperienceGained(character)) + "\n";
-            stats += "Levels Gained: " + std::to_string(getLevelsGained(character)) + "\n";
-            stats += "Combats Won: " + std::to_string(getCombatsWon(character)) + "\n";
-            stats += "Deaths: " + std::to_string(getDeaths(character)) + "\n";
+            const auto& stats = statsOf(character);
+            return formatStats(stats, &stats == &emptyStats() ? character : stats.name);
+        }
+        
+    private:
+        const CharacterStats& statsOf(int characterId) const {
+            const auto* position = index_.find(characterId);
+            return position ? stats_[*position] : emptyStats();
+        }
+        
+        const CharacterStats& statsOf(const std::string& name) const {
+            for (const auto& stats : stats_) {
+                if (stats.name == name) {
+                    return stats;
+                }
+            }
+            return emptyStats();
+        }
+        
+        CharacterStats& track(int characterId, std::string_view name) {
+            auto [position, inserted] = index_.tryEmplace(characterId, static_cast<std::uint32_t>(stats_.size()));
+            if (inserted) {
+                auto& stats = stats_.emplace_back();
+                stats.characterId = characterId;
+                stats.name = name;
+            }
+            return stats_[position];
+        }
+        
+        static std::vector<std::string> achievementNames(const AchievementSet& unlocked) {
+            std::vector<std::string> names;
+            for (size_t i = 0; i < ACHIEVEMENT_COUNT; ++i) {
+                if (unlocked.test(i)) {
+                    names.emplace_back(ACHIEVEMENTS[i].name);
+                }
+            }
+            return names;
+        }
+        
+        static std::string formatStats(const CharacterStats& character) {
+            return formatStats(character, character.name);
+        }
+        
+        static std::string formatStats(const CharacterStats& character, const std::string& name) {
+            std::string stats = "=== " + name + " Statistics ===\n";
+            stats += "Damage Dealt: " + std::to_string(character.damageDealt) + "\n";
+            stats += "Damage Taken: " + std::to_string(character.damageTaken) + "\n";
+            stats += "Experience Gained: " + std::to_string(character.experienceGained) + "\n";
+            stats += "Levels Gained: " + std::to_string(character.levelsGained) + "\n";
+            stats += "Combats Won: " + std::to_string(character.combatsWon) + "\n";
+            stats += "Deaths: " + std::to_string(character.deaths) + "\n";
             
-            auto achievements = getUnlockedAchievements(character);
+            auto achievements = achievementNames(character.unlocked);
             stats += "Achievements: " + std::to_string(achievements.size()) + "\n";
             for (const auto& achievement : achievements) {
                 stats += "  - " + achievement + "\n";
@@ -163,133 +295,78 @@ namespace noname
             return stats;
         }
         
-    private:
-        void handleDamageDealt(const Event& event) {
-            try {
-                auto attacker = event.getData<std::string>("attacker");
-                auto damage = event.getData<int>("damage");
-                
-                damageDealt_[attacker] += damage;
-                
-                // Verificar achievements de daño
-                checkDamageAchievements(attacker);
-                
-            } catch (const std::exception& e) {
-                LM.writeLog(Level::Error, "AchievementObserver: Error processing DAMAGE_DEALT: " + std::string(e.what()));
-            }
+        void handleDamageDealt(const DamagePayload& damage) {
+            auto& stats = track(damage.sourceId, damage.sourceName);
+            stats.damageDealt += damage.damage;
+            
+            // Verificar achievements de daño
+            advanceThresholds(stats, DAMAGE_THRESHOLDS, stats.nextDamageThreshold, stats.damageDealt);
         }
         
-        void handleDamageTaken(const Event& event) {
-            try {
-                auto character = event.getData<std::string>("character_name");
-                auto damage = event.getData<int>("damage");
-                
-                damageTaken_[character] += damage;
-                
-                // Podrías agregar achievements por resistencia aquí
-                
-            } catch (const std::exception& e) {
-                LM.writeLog(Level::Error, "AchievementObserver: Error processing DAMAGE_TAKEN: " + std::string(e.what()));
-            }
+        void handleDamageTaken(const DamagePayload& damage) {
+            auto& stats = track(damage.targetId, damage.targetName);
+            stats.damageTaken += damage.damage;
+            
+            // Podrías agregar achievements por resistencia aquí
         }
         
-        void handleExperienceGained(const Event& event) {
-            try {
-                auto character = event.getData<std::string>("character_name");
-                auto expGained = event.getData<int>("experience_gained");
-                
-                experienceGained_[character] += expGained;
-                
-            } catch (const std::exception& e) {
-                LM.writeLog(Level::Error, "AchievementObserver: Error processing EXPERIENCE_GAINED: " + std::string(e.what()));
-            }
+        void handleExperienceGained(const ExperiencePayload& experience) {
+            track(experience.characterId, experience.characterName).experienceGained += experience.gained;
         }
         
-        void handleLevelUp(const Event& event) {
-            try {
-                auto character = event.getData<std::string>("character_name");
-                auto newLevel = event.getData<int>("new_level");
-                
-                levelsGained_[character]++;
-                
-                // Verificar achievements de nivel
-                checkLevelAchievements(character, newLevel);
-                
-            } catch (const std::exception& e) {
-                LM.writeLog(Level::Error, "AchievementObserver: Error processing LEVEL_UP: " + std::string(e.what()));
-            }
+        void handleLevelUp(const LevelPayload& level) {
+            auto& stats = track(level.characterId, level.characterName);
+            stats.levelsGained++;
+            
+            // Verificar achievements de nivel
+            advanceThresholds(stats, LEVEL_THRESHOLDS, stats.nextLevelThreshold, level.newLevel);
         }
         
-        void handleCharacterDied(const Event& event) {
-            try {
-                auto character = event.getData<std::string>("character_name");
-                
-                deaths_[character]++;
-                
-                // Achievement por morirse muchas veces (humor negro)
-                if (deaths_[character] == 5) {
-                    unlockAchievement(character, "Persistent", "Die 5 times but keep trying");
-                }
-                
-            } catch (const std::exception& e) {
-                LM.writeLog(Level::Error, "AchievementObserver: Error processing CHARACTER_DIED: " + std::string(e.what()));
+        void handleCharacterDied(const CharacterPayload& character) {
+            auto& stats = track(character.characterId, character.characterName);
+            
+            // Achievement por morirse muchas veces (humor negro)
+            if (++stats.deaths == PERSISTENT_DEATHS) {
+                unlockAchievement(stats, Achievement::PERSISTENT);
             }
         }
         
-        void handleCombatEnded(const Event& event) {
-            try {
-                auto attacker = event.getData<std::string>("attacker");
-                auto hit = event.getDataOrDefault<bool>("hit", false);
-                
-                if (hit) {
-                    combatsWon_[attacker]++;
-                    
-                    // Achievements por combates ganados
-                    int wins = combatsWon_[attacker];
-                    if (wins == 1) {
-                        unlockAchievement(attacker, "First Victory", "Win your first combat");
-                    } else if (wins == 10) {
-                        unlockAchievement(attacker, "Skilled Fighter", "Win 10 combats");
-                    } else if (wins == 50) {
-                        unlockAchievement(attacker, "Combat Master", "Win 50 combats");
-                    }
-                }
-                
-            } catch (const std::exception& e) {
-                LM.writeLog(Level::Error, "AchievementObserver: Error processing COMBAT_ENDED: " + std::string(e.what()));
+        void handleCombatEnded(const CombatPayload& combat) {
+            if (!combat.hit) {
+                return;
             }
-        }
-        
-        void checkDamageAchievements(const std::string& character) {
-            int totalDamage = damageDealt_[character];
+            auto& stats = track(combat.attackerId, combat.attackerName);
+            stats.combatsWon++;
             
-            for (const auto& threshold : damageThresholds_) {
-                if (totalDamage >= threshold.value) {
-                    unlockAchievement(character, threshold.name, threshold.description);
-                }
-            }
+            // Achievements por combates ganados
+            advanceThresholds(stats, COMBAT_THRESHOLDS, stats.nextCombatThreshold, stats.combatsWon);
         }
         
-        void checkLevelAchievements(const std::string& character, int level) {
-            for (const auto& threshold : levelThresholds_) {
-                if (level >= threshold.value) {
-                    unlockAchievement(character, threshold.name, threshold.description);
-                }
+        /**
+         * @brief Desbloquea los umbrales alcanzados a partir del cursor del personaje
+         *
+         * Los umbrales están ordenados y un achievement no se pierde, así que
+         * el cursor solo avanza: cada comprobación mira un único umbral salvo
+         * cuando se desbloquea alguno.
+         */
+        template<size_t N>
+        void advanceThresholds(CharacterStats& stats, const std::array<AchievementThreshold, N>& thresholds,
+                               std::uint8_t& cursor, int value) {
+            while (cursor < N && value >= thresholds[cursor].value) {
+                unlockAchievement(stats, thresholds[cursor].achievement);
+                ++cursor;
             }
         }
         
-        void unlockAchievement(const std::string& character, const std::string& name, const std::string& description) {
-            auto& achievements = unlockedAchievements_[character];
-            
-            // Verificar si ya está desbloqueado
-            if (std::find(achievements.begin(), achievements.end(), name) != achievements.end()) {
+        void unlockAchievement(CharacterStats& stats, Achievement achievement) {
+            const auto bit = static_cast<size_t>(achievement);
+            if (stats.unlocked.test(bit)) {
                 return; // Ya desbloqueado
             }
+            stats.unlocked.set(bit);
             
-            achievements.push_back(name);
-            
-            LM.writeLog(Level::Info, 
-                "🏆 ACHIEVEMENT UNLOCKED: " + character + " earned '" + name + "' - " + description);
+            const auto& info = ACHIEVEMENTS[bit];
+            LM.log<Level::Info>("🏆 ACHIEVEMENT UNLOCKED: {} earned '{}' - {}", stats.name, info.name, info.description);
         }
     };
 }
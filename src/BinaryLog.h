@@ -0,0 +1,456 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <ostream>
+#include <charconv>
+#include <concepts>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+#include "LogFormat.h"
+
+/**
+ * @brief Formato binario del log
+ *
+ * Un fichero de log es una secuencia de sesiones. Cada sesión empieza con una
+ * cabecera, seguida de definiciones de formato y registros en cualquier orden
+ * (una definición puede llegar después del primer registro que la usa: el
+ * decodificador lee la sesión entera antes de mostrarla):
+ *
+ *   Session : 'H' magic[8] u64 periodNum u64 periodDen
+ *   Format  : 'F' u32 formatId u32 length char[length]
+ *   Record  : 'R' i64 ticks u8 level u32 formatId u16 argCount { u8 type payload }*
+ *
+ * Contenido de los argumentos: 'i' i64, 'u' u64, 'd' f64, 'b' u8,
+ * 's' u32 length char[length]. Los enteros se guardan en el orden de bytes
+ * nativo de quien escribe.
+ */
+namespace noname::binarylog
+{
+    inline constexpr char MAGIC[8] = {'N', 'N', 'B', 'L', 'O', 'G', '0', '1'};
+    inline constexpr std::uint32_t PLAIN_MESSAGE_FORMAT = 0; // "{}" con un único argumento de cadena
+
+    enum class Tag : std::uint8_t
+    {
+        Session = 'H',
+        Format = 'F',
+        Record = 'R'
+    };
+
+    enum class ArgType : std::uint8_t
+    {
+        Int = 'i',
+        UInt = 'u',
+        Double = 'd',
+        Bool = 'b',
+        String = 's'
+    };
+
+    /**
+     * @brief Añade los bytes de un valor trivialmente copiable
+     */
+    template <typename T>
+    void put(std::string &out, T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    inline void putString(std::string &out, std::string_view value)
+    {
+        put(out, static_cast<std::uint32_t>(value.size()));
+        out.append(value);
+    }
+
+    /**
+     * @brief Codificadores de argumentos; aceptan los mismos tipos que logformat::appendArg
+     */
+    inline void encodeArg(std::string &out, std::string_view value)
+    {
+        put(out, ArgType::String);
+        putString(out, value);
+    }
+    inline void encodeArg(std::string &out, const char *value) { encodeArg(out, std::string_view{value ? value : "(null)"}); }
+    inline void encodeArg(std::string &out, const std::string &value) { encodeArg(out, std::string_view{value}); }
+    inline void encodeArg(std::string &out, char value) { encodeArg(out, std::string_view{&value, 1}); }
+    inline void encodeArg(std::string &out, bool value)
+    {
+        put(out, ArgType::Bool);
+        put(out, static_cast<std::uint8_t>(value));
+    }
+
+    template <typename T>
+        requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+    void encodeArg(std::string &out, T value)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            put(out, ArgType::Double);
+            put(out, static_cast<double>(value));
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            put(out, ArgType::Int);
+            put(out, static_cast<std::int64_t>(value));
+        }
+        else
+        {
+            put(out, ArgType::UInt);
+            put(out, static_cast<std::uint64_t>(value));
+        }
+    }
+
+    template <typename T>
+        requires std::is_enum_v<T>
+    void encodeArg(std::string &out, T value)
+    {
+        if constexpr (requires { toLogString(value); })
+        {
+            encodeArg(out, toLogString(value));
+        }
+        else
+        {
+            encodeArg(out, static_cast<std::underlying_type_t<T>>(value));
+        }
+    }
+
+    template <typename F>
+        requires(std::invocable<const F &> && !std::is_convertible_v<F, std::string_view>)
+    void encodeArg(std::string &out, const F &producer)
+    {
+        encodeArg(out, producer());
+    }
+
+    /**
+     * @brief Cabecera de sesión con el periodo de los ticks de Clock
+     */
+    template <typename Clock>
+    void encodeSession(std::string &out)
+    {
+        put(out, Tag::Session);
+        out.append(MAGIC, sizeof(MAGIC));
+        put(out, static_cast<std::uint64_t>(Clock::period::num));
+        put(out, static_cast<std::uint64_t>(Clock::period::den));
+    }
+
+    /**
+     * @brief Definición del formato formatId
+     */
+    inline void encodeFormat(std::string &out, std::uint32_t formatId, std::string_view fmt)
+    {
+        put(out, Tag::Format);
+        put(out, formatId);
+        putString(out, fmt);
+    }
+
+    /**
+     * @brief Registro con sus argumentos sin formatear
+     */
+    template <typename... Args>
+    void encodeRecord(std::string &out, std::int64_t ticks, std::uint8_t level, std::uint32_t formatId, const Args &...args)
+    {
+        put(out, Tag::Record);
+        put(out, ticks);
+        put(out, level);
+        put(out, formatId);
+        put(out, static_cast<std::uint16_t>(sizeof...(Args)));
+        (encodeArg(out, args), ...);
+    }
+
+    /**
+     * @brief Convierte un log binario en líneas de texto: "YYYY-mm-dd HH:MM:SS [Level] : message"
+     */
+    class Decoder
+    {
+    private:
+        struct Reader
+        {
+            std::string_view data;
+            size_t pos{0};
+
+            template <typename T>
+            bool get(T &value)
+            {
+                if (pos + sizeof(T) > data.size())
+                {
+                    return false;
+                }
+                std::memcpy(&value, data.data() + pos, sizeof(T));
+                pos += sizeof(T);
+                return true;
+            }
+
+            bool getString(std::string_view &value)
+            {
+                std::uint32_t length;
+                if (!get(length) || pos + length > data.size())
+                {
+                    return false;
+                }
+                value = data.substr(pos, length);
+                pos += length;
+                return true;
+            }
+        };
+
+        static constexpr const char *LEVEL_NAMES[] = {"Debug", "Info", "Warning", "Error"};
+
+        std::string _error;
+        size_t _records{0};
+
+        bool skipArgs(Reader &reader, std::uint16_t count)
+        {
+            for (std::uint16_t i = 0; i < count; ++i)
+            {
+                std::string arg;
+                if (!readArg(reader, arg))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool readArg(Reader &reader, std::string &out)
+        {
+            ArgType type;
+            if (!reader.get(type))
+            {
+                return false;
+            }
+            char buffer[64];
+            switch (type)
+            {
+            case ArgType::Int:
+            {
+                std::int64_t value;
+                if (!reader.get(value))
+                    return false;
+                out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+                return true;
+            }
+            case ArgType::UInt:
+            {
+                std::uint64_t value;
+                if (!reader.get(value))
+                    return false;
+                out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+                return true;
+            }
+            case ArgType::Double:
+            {
+                double value;
+                if (!reader.get(value))
+                    return false;
+                out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+                return true;
+            }
+            case ArgType::Bool:
+            {
+                std::uint8_t value;
+                if (!reader.get(value))
+                    return false;
+                out.append(value ? "true" : "false");
+                return true;
+            }
+            case ArgType::String:
+            {
+                std::string_view value;
+                if (!reader.getString(value))
+                    return false;
+                out.append(value);
+                return true;
+            }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Decodifica una sesión y deja el lector al principio de la siguiente
+         */
+        bool decodeSession(Reader &reader, std::ostream &out)
+        {
+            std::uint64_t periodNum, periodDen;
+            char magic[sizeof(MAGIC)];
+            if (reader.pos + sizeof(MAGIC) > reader.data.size())
+            {
+                _error = "truncated session header";
+                return false;
+            }
+            std::memcpy(magic, reader.data.data() + reader.pos, sizeof(MAGIC));
+            reader.pos += sizeof(MAGIC);
+            if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || !reader.get(periodNum) || !reader.get(periodDen) || periodDen == 0)
+            {
+                _error = "invalid session header";
+                return false;
+            }
+
+            // Primera pasada: definiciones de formato de la sesión. Una cola
+            // dañada (casi siempre un registro cortado por un cierre brusco)
+            // termina ahí la sesión, pero los registros anteriores se muestran.
+            std::unordered_map<std::uint32_t, std::string_view> formats{{PLAIN_MESSAGE_FORMAT, "{}"}};
+            const size_t recordsStart = reader.pos;
+            size_t sessionEnd = reader.data.size();
+            bool complete = true;
+            while (reader.pos < reader.data.size())
+            {
+                const size_t recordStart = reader.pos;
+                Tag tag;
+                if (!reader.get(tag))
+                {
+                    break;
+                }
+                if (tag == Tag::Session)
+                {
+                    sessionEnd = recordStart;
+                    break;
+                }
+                if (tag == Tag::Format)
+                {
+                    std::uint32_t id;
+                    std::string_view fmt;
+                    if (!reader.get(id) || !reader.getString(fmt))
+                    {
+                        _error = "truncated format definition at offset " + std::to_string(recordStart);
+                        sessionEnd = recordStart;
+                        complete = false;
+                        break;
+                    }
+                    formats[id] = fmt;
+                }
+                else if (tag == Tag::Record)
+                {
+                    std::int64_t ticks;
+                    std::uint8_t level;
+                    std::uint32_t id;
+                    std::uint16_t count;
+                    if (!reader.get(ticks) || !reader.get(level) || !reader.get(id) || !reader.get(count) || !skipArgs(reader, count))
+                    {
+                        _error = "truncated record at offset " + std::to_string(recordStart);
+                        sessionEnd = recordStart;
+                        complete = false;
+                        break;
+                    }
+                }
+                else
+                {
+                    _error = "unknown tag at offset " + std::to_string(recordStart);
+                    sessionEnd = recordStart;
+                    complete = false;
+                    break;
+                }
+            }
+
+            // Segunda pasada: muestra los registros de [recordsStart, sessionEnd),
+            // ya validados por la primera
+            Reader records{reader.data.substr(0, sessionEnd), recordsStart};
+            reader.pos = sessionEnd;
+            std::string line;
+            std::vector<std::string> args;
+            while (records.pos < sessionEnd)
+            {
+                Tag tag;
+                if (!records.get(tag))
+                {
+                    break;
+                }
+                if (tag == Tag::Format)
+                {
+                    std::uint32_t id;
+                    std::string_view fmt;
+                    if (!records.get(id) || !records.getString(fmt))
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                std::int64_t ticks;
+                std::uint8_t level;
+                std::uint32_t id;
+                std::uint16_t count;
+                if (!records.get(ticks) || !records.get(level) || !records.get(id) || !records.get(count))
+                {
+                    break;
+                }
+                args.assign(count, std::string{});
+                bool argsRead = true;
+                for (auto &arg : args)
+                {
+                    argsRead = argsRead && readArg(records, arg);
+                }
+                if (!argsRead)
+                {
+                    break;
+                }
+
+                line.clear();
+                auto seconds = static_cast<std::time_t>(static_cast<long double>(ticks) * periodNum / periodDen);
+                std::tm local{};
+                localtime_r(&seconds, &local);
+                char stamp[32];
+                line.append(stamp, std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local));
+                line.append(" [");
+                line.append(level < std::size(LEVEL_NAMES) ? LEVEL_NAMES[level] : "?");
+                line.append("] : ");
+
+                auto format = formats.find(id);
+                std::string_view fmt = format != formats.end() ? format->second : std::string_view{"<unknown format>"};
+                bool found = true;
+                for (const auto &arg : args)
+                {
+                    fmt = logformat::appendUntilPlaceholder(line, fmt, found);
+                    if (!found)
+                    {
+                        break;
+                    }
+                    line.append(arg);
+                }
+                if (found)
+                {
+                    logformat::formatTo(line, fmt);
+                }
+                line.push_back('\n');
+                out << line;
+                ++_records;
+            }
+            return complete;
+        }
+
+    public:
+        /**
+         * @brief Escribe en out todas las sesiones de data
+         * @return false si data está dañado; los registros válidos anteriores
+         * al daño se escriben igualmente y getError() dice dónde está
+         */
+        bool decode(std::string_view data, std::ostream &out)
+        {
+            Reader reader{data};
+            _records = 0;
+            while (reader.pos < data.size())
+            {
+                Tag tag;
+                if (!reader.get(tag) || tag != Tag::Session)
+                {
+                    _error = "expected a session header at offset " + std::to_string(reader.pos - 1);
+                    return false;
+                }
+                if (!decodeSession(reader, out))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] const std::string &getError() const noexcept { return _error; }
+        [[nodiscard]] size_t getRecordCount() const noexcept { return _records; }
+    };
+}
@@ -0,0 +1,261 @@
+#ifndef __BREEDING_H__
+#define __BREEDING_H__
+
+// System includes
+#include <array>
+#include <vector>
+#include <span>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+// Local includes
+#include "Heritables.h"
+#include "Rng.h"
+#include "WorkerPool.h"
+
+namespace noname
+{
+    /**
+     * @brief Resumen de una generación: media, desviación típica, mínimo y
+     * máximo de cada heritable
+     */
+    struct GenerationStats
+    {
+        size_t generation{0};
+        size_t population{0};
+        std::array<double, Heritables::COUNT> mean{};
+        std::array<double, Heritables::COUNT> stddev{};
+        std::array<std::uint8_t, Heritables::COUNT> min{};
+        std::array<std::uint8_t, Heritables::COUNT> max{};
+    };
+
+    /**
+     * @brief Simulador de cría de poblaciones de heritables, sin personajes
+     *
+     * Cada generación sustituye entera a la anterior: cada descendiente elige
+     * padre y madre de la generación anterior (por torneo según la aptitud, o
+     * al azar si el torneo es de 1) y hereda con las mismas reglas que
+     * Character::determineHeritables().
+     *
+     * Cada descendiente usa su propio Rng, sembrado a partir de la semilla, la
+     * generación y su índice (Rng::mix()), así que el resultado no depende de
+     * cuántos hilos ni de cómo se reparta el trabajo. Las sumas de las
+     * estadísticas son enteras por la misma razón.
+     */
+    class BreedingSimulator
+    {
+    public:
+        using Weights = std::array<float, Heritables::COUNT>;
+
+        struct Config
+        {
+            size_t population{100000};
+            std::uint64_t seed{1};
+            // Candidatos por torneo al elegir cada progenitor; 1 es apareamiento al azar
+            unsigned tournament{1};
+            // Aptitud de un individuo: suma de sus heritables por estos pesos
+            Weights weights{1, 1, 1, 1, 1, 1};
+        };
+
+        static constexpr size_t MIN_CHUNK = 16384;
+
+    private:
+        struct Accumulator
+        {
+            std::array<std::uint64_t, Heritables::COUNT> sum{};
+            std::array<std::uint64_t, Heritables::COUNT> sumSquares{};
+            std::array<std::uint8_t, Heritables::COUNT> min{};
+            std::array<std::uint8_t, Heritables::COUNT> max{};
+
+            Accumulator() { min.fill(std::numeric_limits<std::uint8_t>::max()); }
+
+            void add(const Heritables::Values &values) noexcept
+            {
+                for (size_t i = 0; i < Heritables::COUNT; ++i)
+                {
+                    const std::uint64_t value = values[i];
+                    sum[i] += value;
+                    sumSquares[i] += value * value;
+                    min[i] = std::min(min[i], values[i]);
+                    max[i] = std::max(max[i], values[i]);
+                }
+            }
+
+            void merge(const Accumulator &other) noexcept
+            {
+                for (size_t i = 0; i < Heritables::COUNT; ++i)
+                {
+                    sum[i] += other.sum[i];
+                    sumSquares[i] += other.sumSquares[i];
+                    min[i] = std::min(min[i], other.min[i]);
+                    max[i] = std::max(max[i], other.max[i]);
+                }
+            }
+        };
+
+        Config _config;
+        std::vector<Heritables> _current, _next;
+        std::vector<float> _fitness, _nextFitness;
+        std::vector<Accumulator> _accumulators;
+        GenerationStats _stats;
+
+        /**
+         * @brief Rng del individuo index de la generación generation
+         */
+        [[nodiscard]] Rng streamFor(size_t generation, size_t index) const noexcept
+        {
+            return Rng{Rng::mix(_config.seed ^ Rng::mix((static_cast<std::uint64_t>(generation) << 40) ^ index))};
+        }
+
+        [[nodiscard]] float fitnessOf(const Heritables &heritables) const noexcept
+        {
+            float fitness = 0.0f;
+            for (size_t i = 0; i < Heritables::COUNT; ++i)
+            {
+                fitness += _config.weights[i] * heritables.values()[i];
+            }
+            return fitness;
+        }
+
+        [[nodiscard]] size_t pickParent(Rng &rng) const noexcept
+        {
+            // En 64 bits: la población puede pasar de INT_MAX
+            const std::uint64_t count = _current.size();
+            auto best = static_cast<size_t>(rng.uniformIndex(count));
+            for (unsigned round = 1; round < _config.tournament; ++round)
+            {
+                const auto candidate = static_cast<size_t>(rng.uniformIndex(count));
+                if (_fitness[candidate] > _fitness[best])
+                {
+                    best = candidate;
+                }
+            }
+            return best;
+        }
+
+        /**
+         * @brief Rellena individuos, aptitud y estadísticas de [0, count) por trozos en el pool
+         *
+         * produce(begin, end) rellena population[begin, end); la aptitud y las
+         * estadísticas se calculan después sobre el trozo, que aún está en caché.
+         */
+        template <typename F>
+        void fill(WorkerPool &pool, std::vector<Heritables> &population, std::vector<float> &fitness, F &&produce)
+        {
+            const size_t count = population.size();
+            const size_t chunks = std::max<size_t>(1, (count + MIN_CHUNK - 1) / MIN_CHUNK);
+            _accumulators.assign(chunks, Accumulator{});
+            pool.parallelFor(chunks, 1, [&](size_t firstChunk, size_t lastChunk)
+                             {
+                                 for (size_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+                                 {
+                                     const size_t begin = chunk * MIN_CHUNK;
+                                     const size_t end = std::min(count, begin + MIN_CHUNK);
+                                     produce(begin, end);
+                                     Accumulator &accumulator = _accumulators[chunk];
+                                     for (size_t index = begin; index < end; ++index)
+                                     {
+                                         fitness[index] = fitnessOf(population[index]);
+                                         accumulator.add(population[index].values());
+                                     }
+                                 } });
+            Accumulator total;
+            for (const auto &accumulator : _accumulators)
+            {
+                total.merge(accumulator);
+            }
+            _stats.population = count;
+            for (size_t i = 0; i < Heritables::COUNT; ++i)
+            {
+                const double n = static_cast<double>(std::max<size_t>(count, 1));
+                const double mean = static_cast<double>(total.sum[i]) / n;
+                _stats.mean[i] = mean;
+                _stats.stddev[i] = std::sqrt(std::max(0.0, static_cast<double>(total.sumSquares[i]) / n - mean * mean));
+                _stats.min[i] = count ? total.min[i] : 0;
+                _stats.max[i] = total.max[i];
+            }
+        }
+
+        /**
+         * @brief Cría los descendientes [begin, end) de la generación generation
+         *
+         * Los progenitores están repartidos al azar por toda la generación
+         * anterior: primero se eligen los de un lote y se piden a memoria
+         * (prefetch), y luego se cría el lote, en vez de esperar cada lectura.
+         */
+        void breed(size_t generation, size_t begin, size_t end) noexcept
+        {
+            constexpr size_t BATCH = 32;
+            std::array<Rng, BATCH> streams;
+            std::array<size_t, BATCH> fathers, mothers;
+            for (size_t first = begin; first < end; first += BATCH)
+            {
+                const size_t count = std::min(BATCH, end - first);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    streams[i] = streamFor(generation, first + i);
+                    fathers[i] = pickParent(streams[i]);
+                    mothers[i] = pickParent(streams[i]);
+                    __builtin_prefetch(&_current[fathers[i]]);
+                    __builtin_prefetch(&_current[mothers[i]]);
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                    _next[first + i].determineHeritablesValues(_current[fathers[i]], _current[mothers[i]], streams[i]);
+                }
+            }
+        }
+
+    public:
+        explicit BreedingSimulator(const Config &config) : _config(config)
+        {
+            _config.tournament = std::max(1u, _config.tournament);
+        }
+
+        /**
+         * @brief Crea la generación 0 con heritables al azar
+         */
+        const GenerationStats &seedFounders(WorkerPool &pool)
+        {
+            _current.assign(_config.population, Heritables{Heritables::Values{}});
+            _fitness.assign(_config.population, 0.0f);
+            _stats.generation = 0;
+            fill(pool, _current, _fitness, [this](size_t begin, size_t end)
+                 {
+                     for (size_t index = begin; index < end; ++index)
+                     {
+                         Rng rng = streamFor(0, index);
+                         _current[index] = Heritables{rng};
+                     } });
+            return _stats;
+        }
+
+        /**
+         * @brief Cría la siguiente generación a partir de la actual
+         */
+        const GenerationStats &step(WorkerPool &pool)
+        {
+            if (_current.empty())
+            {
+                return seedFounders(pool);
+            }
+            const size_t generation = _stats.generation + 1;
+            _next.resize(_current.size(), Heritables{Heritables::Values{}});
+            _nextFitness.resize(_current.size());
+            fill(pool, _next, _nextFitness, [this, generation](size_t begin, size_t end)
+                 { breed(generation, begin, end); });
+            _current.swap(_next);
+            _fitness.swap(_nextFitness);
+            _stats.generation = generation;
+            return _stats;
+        }
+
+        [[nodiscard]] std::span<const Heritables> getPopulation() const noexcept { return _current; }
+        [[nodiscard]] const GenerationStats &getStats() const noexcept { return _stats; }
+        [[nodiscard]] const Config &getConfig() const noexcept { return _config; }
+    };
+}
+
+#endif // __BREEDING_H__
@@ -1,9 +1,9 @@
 // Local includes
 #include "Character.h"
 #include "Utils.h"
-#include "HtmlBuilder.h"
+#include "HtmlWriter.h"
 #include "GameManager.h"
-#include "FileManager.h"
+#include "CharacterReportSink.h"
 #include "SkillsManager.h"
 #include "Inventory.h"
 #include "LogManager.h"
@@ -23,46 +23,40 @@ namespace noname
         return cont++;
     };
 
-    Character::Character() : _id{generateId()},
+    Character::Character() : Character(CharacterStore::defaultStore())
+    {
+    }
+
+    Character::Character(std::shared_ptr<CharacterStore> store) : _id{generateId()},
                              _name{"Noname"},
                              _level{0},
                              _magicLevel{0},
-                             health{},           // HealthData con valores por defecto
-                             mana{},             // ManaData con valores por defecto
-                             experience{},       // ExperienceData con valores por defecto
-                             magicExperience{},  // ExperienceData para maná gastado
-                             capacity{},         // CapacityData con valores por defecto
-                             speed{},            // SpeedData con valores por defecto
-                             skills{},           // std::array inicializado a 0
-                             skillTries{},       // std::array inicializado a 0
+                             _row{std::move(store), _id}, // Fila con los valores por defecto de CharacterData
                              _isDead{false},
-                             _heritables{},
                              _inventory{},
                              attackStrategy{std::make_unique<MeleeAttackStrategy>()}
     {
+        heritables() = Heritables{};
         setLevel(1);
         setMagicLevel(1);
-        writeCharacterInfo();
+        if (RS.isReportOnChangeEnabled())
+        {
+            writeCharacterInfo();
+        }
     }
 
     // Constructor de copia personalizado
-    Character::Character(const Character& other) :
+    Character::Character(const Character& other, std::shared_ptr<CharacterStore> store) :
         _id{generateId()}, // Nuevo ID para la copia
         _name{other._name},
         _level{other._level},
         _magicLevel{other._magicLevel},
-        health{other.health},
-        mana{other.mana},
-        experience{other.experience},
-        magicExperience{other.magicExperience},
-        capacity{other.capacity},
-        speed{other.speed},
-        skills{other.skills},
-        skillTries{other.skillTries},
+        _row{std::move(store), _id},
         _isDead{other._isDead},
-        _heritables{other._heritables},
         _inventory{other._inventory}
     {
+        _row.store().copyRow(_row.slot(), other._row.store(), other._row.slot());
+
         // Copia profunda de la estrategia de ataque
         if (other.attackStrategy) {
             // Como no tenemos un método clone virtual, creamos una nueva estrategia por defecto
@@ -77,17 +71,10 @@ namespace noname
             _name = other._name;
             _level = other._level;
             _magicLevel = other._magicLevel;
-            health = other.health;
-            mana = other.mana;
-            experience = other.experience;
-            magicExperience = other.magicExperience;
-            capacity = other.capacity;
-            speed = other.speed;
-            skills = other.skills;
-            skillTries = other.skillTries;
+            _row.store().copyRow(_row.slot(), other._row.store(), other._row.slot());
             _isDead = other._isDead;
-            _heritables = other._heritables;
             _inventory = other._inventory;
+            markChanged();
             
             // Copia profunda de la estrategia de ataque
             if (other.attackStrategy) {
@@ -102,158 +89,161 @@ namespace noname
     void Character::setLevel(short value) noexcept
     {
         _level = value;
-        experience.setNextLevelRequirement(GM.getExpForLevel(_level + 1));
+        experience().setNextLevelRequirement(GM.getExpForLevel(_level + 1));
         setMaxHealth();
         setMaxMana();
         setMaxCapacity();
         updateSpeed();
+        markChanged();
     }
 
     void Character::setMagicLevel(short value) noexcept
     {
         _magicLevel = value;
-        magicExperience.setNextLevelRequirement(GM.getManaForLevel(_level + 1));
+        magicExperience().setNextLevelRequirement(GM.getManaForLevel(_level + 1));
+        markChanged();
     }
 
     void Character::setMaxHealth() noexcept
     {
-        int newMaxHealth = health.maximum + _heritables.at(HeritableType::CONSTITUTION) + Utils::rollDie(1, _level);
-        health.setMaximum(newMaxHealth);
+        int newMaxHealth = health().maximum + heritables().at(HeritableType::CONSTITUTION) + Utils::rollDie(1, _level);
+        health().setMaximum(newMaxHealth);
+        markChanged();
     }
 
     void Character::setMaxMana() noexcept
     {
-        int newMaxMana = mana.maximum + _heritables.at(HeritableType::INTELLIGENCE) + Utils::rollDie(1, _level);
-        mana.setMaximum(newMaxMana);
+        int newMaxMana = mana().maximum + heritables().at(HeritableType::INTELLIGENCE) + Utils::rollDie(1, _level);
+        mana().setMaximum(newMaxMana);
+        markChanged();
     }
 
     void Character::setMaxCapacity() noexcept
     {
-        int newMaxCapacity = capacity.maximum + _heritables.at(HeritableType::STRENGTH) + _heritables.at(HeritableType::CONSTITUTION) + Utils::rollDie(1, _level);
-        capacity.setMaximum(newMaxCapacity);
+        int newMaxCapacity = capacity().maximum + heritables().at(HeritableType::STRENGTH) + heritables().at(HeritableType::CONSTITUTION) + Utils::rollDie(1, _level);
+        capacity().setMaximum(newMaxCapacity);
         updateCurrentCapacity();
     }
 
     void Character::updateCurrentCapacity() noexcept
     {
         int inventoryWeight = _inventory.getWeight();
-        capacity.current = std::max(0, capacity.maximum - inventoryWeight);
+        capacity().current = std::max(0, capacity().maximum - inventoryWeight);
+        markChanged();
     }
 
     void Character::setSpeed() noexcept
     {
-        int newBaseSpeed = speed.base + _heritables.at(HeritableType::STRENGTH) - _heritables.at(HeritableType::CONSTITUTION) + Utils::rollDie(1, _level);
-        speed.setBase(newBaseSpeed);
+        int newBaseSpeed = speed().base + heritables().at(HeritableType::STRENGTH) - heritables().at(HeritableType::CONSTITUTION) + Utils::rollDie(1, _level);
+        speed().setBase(newBaseSpeed);
         updateSpeed();
     }
 
     void Character::updateSpeed() noexcept
     {
         int penalty = _inventory.getWeight();
-        speed.updateCurrent(penalty);
+        speed().updateCurrent(penalty);
     }
 
     void Character::setSkill(SkillType skill, short value) noexcept
     {
-        skillTries.at(static_cast<size_t>(skill)) = value;
+        short &current = skills().at(static_cast<size_t>(skill));
+        if (current == value)
+        {
+            return;
+        }
+        current = value;
+        notifyObservers(EventType::SKILL_IMPROVED, [&]() { return createSkillEvent(EventType::SKILL_IMPROVED, skill); });
     }
 
     void Character::updateTries(SkillType skill) noexcept
     {
         size_t skillIndex = static_cast<size_t>(skill);
-        ++skillTries.at(skillIndex);
-        if (skillTries.at(skillIndex) >= SM.getSkill(skill).getTriesNeeded())
+        ++skillTries().at(skillIndex);
+        if (skillTries().at(skillIndex) >= SM.getSkill(skill).getTriesNeeded())
         {
-            skillTries.at(skillIndex) = 0;
-            ++skills.at(skillIndex);
-            LM.writeLog(Level::Debug, "New value of " + SkillToString(skill) + " = " + std::to_string(skills.at(skillIndex)));
+            skillTries().at(skillIndex) = 0;
+            ++skills().at(skillIndex);
+            LM.log<Level::Debug>("New value of {} = {}", skill, skills().at(skillIndex));
+            notifyObservers(EventType::SKILL_IMPROVED, [&]() { return createSkillEvent(EventType::SKILL_IMPROVED, skill); });
         }
     }
 
     // Helper methods for creating events
     Event Character::createHealthEvent(EventType type, int oldValue, int newValue) const {
-        Event event(type);
-        event.setData<std::string>("character_name", _name.get());
-        event.setData<int>("old_value", oldValue);
-        event.setData<int>("new_value", newValue);
-        event.setData<int>("character_level", _level.get());
-        event.setData<int>("character_id", _id.get());
-        return event;
+        return Event(type, StatChangePayload{_id.get(), _level.get(), oldValue, newValue, getNameView()});
     }
 
     Event Character::createManaEvent(EventType type, int oldValue, int newValue) const {
-        Event event(type);
-        event.setData<std::string>("character_name", _name.get());
-        event.setData<int>("old_value", oldValue);
-        event.setData<int>("new_value", newValue);
-        event.setData<int>("character_level", _level.get());
-        event.setData<int>("character_id", _id.get());
-        return event;
-    }
-
-    Event Character::createCombatEvent(EventType type, const std::string& target, int damage) const {
-        Event event(type);
-        event.setData<std::string>("attacker", _name.get());
-        event.setData<std::string>("target", target);
-        if (damage > 0) {
-            event.setData<int>("damage", damage);
-        }
-        event.setData<int>("attacker_level", _level.get());
-        event.setData<int>("attacker_id", _id.get());
-        return event;
+        return Event(type, StatChangePayload{_id.get(), _level.get(), oldValue, newValue, getNameView()});
+    }
+
+    Event Character::createCombatEvent(EventType type, const Character& target, int damage) const {
+        return Event(type, CombatPayload{_id.get(), target.getId(), _level.get(), damage, damage > 0,
+                                         getNameView(), target.getNameView()});
     }
 
     Event Character::createExperienceEvent(int expGained, int totalExp) const {
-        Event event(EventType::EXPERIENCE_GAINED);
-        event.setData<std::string>("character_name", _name.get());
-        event.setData<int>("experience_gained", expGained);
-        event.setData<int>("total_experience", totalExp);
-        event.setData<int>("character_level", _level.get());
-        event.setData<int>("character_id", _id.get());
-        return event;
+        return Event::make<EventType::EXPERIENCE_GAINED>({_id.get(), _level.get(), expGained,
+                                                          static_cast<unsigned long long>(totalExp), getNameView()});
     }
 
     Event Character::createLevelEvent(EventType type, int oldLevel, int newLevel) const {
-        Event event(type);
-        event.setData<std::string>("character_name", _name.get());
-        event.setData<int>("old_level", oldLevel);
-        event.setData<int>("new_level", newLevel);
-        event.setData<int>("character_id", _id.get());
-        return event;
+        return Event(type, LevelPayload{_id.get(), oldLevel, newLevel, getNameView()});
     }
 
     Event Character::createCharacterEvent(EventType type) const {
-        Event event(type);
-        event.setData<std::string>("character_name", _name.get());
-        event.setData<int>("final_level", _level.get());
-        event.setData<int>("character_id", _id.get());
-        return event;
+        return Event(type, CharacterPayload{_id.get(), _level.get(), getNameView()});
+    }
+
+    Event Character::createDamageDealtEvent(const Character& target, int damage, bool critical) const {
+        DamagePayload dealt{};
+        dealt.sourceId = _id.get();
+        dealt.targetId = target.getId();
+        dealt.damage = damage;
+        dealt.sourceLevel = _level.get();
+        dealt.critical = critical;
+        dealt.sourceName = getNameView();
+        dealt.targetName = target.getNameView();
+        return Event::make<EventType::DAMAGE_DEALT>(dealt);
+    }
+
+    Event Character::createDamageTakenEvent(int damage) const {
+        DamagePayload taken{};
+        taken.targetId = _id.get();
+        taken.damage = damage;
+        taken.remainingHealth = health().current;
+        taken.targetName = getNameView();
+        return Event::make<EventType::DAMAGE_TAKEN>(taken);
+    }
+
+    Event Character::createSkillEvent(EventType type, SkillType skill) const {
+        return Event(type, SkillPayload{_id.get(), skill, getSkill(skill), getNameView()});
     }
 
     void Character::gainExperience(int value) noexcept
     {
         if (value <= 0)
         {
-            LM.writeLog(Level::Warning, "Invalid experience value: " + std::to_string(value));
+            LM.log<Level::Warning>("Invalid experience value: {}", value);
             return;
         }
 
-        int oldExp = experience.current;
+        int oldExp = experience().current;
         int oldLevel = _level.get();
         
-        experience.gain(value);
+        experience().gain(value);
+        markChanged();
 
         // Notificar experiencia ganada
-        Event expEvent = createExperienceEvent(value, experience.current);
-        notifyObservers(expEvent);
+        notifyObservers(EventType::EXPERIENCE_GAINED, [&]() { return createExperienceEvent(value, experience().current); });
 
-        while (experience.hasLeveledUp())
+        while (experience().hasLeveledUp())
         {
             setLevel(_level + 1);
             
             // Notificar subida de nivel
-            Event levelEvent = createLevelEvent(EventType::LEVEL_UP, oldLevel, _level.get());
-            notifyObservers(levelEvent);
+            notifyObservers(EventType::LEVEL_UP, [&]() { return createLevelEvent(EventType::LEVEL_UP, oldLevel, _level.get()); });
             
             oldLevel = _level.get(); // Actualizar para múltiples level ups
         }
@@ -263,7 +253,8 @@ namespace noname
     {
         if (value > 0)
         {
-            health.heal(value);
+            health().heal(value);
+            markChanged();
         }
         // Error handling TBD
     }
@@ -285,14 +276,14 @@ namespace noname
     bool Character::performAttack(Character& target) 
     {
         if (!attackStrategy) {
-            LM.writeLog(Level::Debug, "No attack strategy set for character " + std::to_string(_id));
+            LM.log<Level::Debug>("No attack strategy set for character {}", _id.get());
             return false;
         }
         
         int damage = calculateAttackDamage();
         
         if (damage <= 0) {
-            LM.writeLog(Level::Debug, "Character " + std::to_string(_id) + " missed the attack or had no damage");
+            LM.log<Level::Debug>("Character {} missed the attack or had no damage", _id.get());
             return false;
         }
         
@@ -303,16 +294,11 @@ namespace noname
         }
         
         // Log del ataque
-        std::string attackType = attackStrategy->isCriticalHit() ? "critical" : "normal";
-        LM.writeLog(Level::Debug, "Character " + std::to_string(_id) + 
-                   " performed " + attackType + " attack with damage: " + std::to_string(damage));
+        const bool critical = attackStrategy->isCriticalHit();
+        LM.log<Level::Debug>("Character {} performed {} attack with damage: {}", _id.get(), critical ? "critical" : "normal", damage);
         
         // Emitir evento de ataque exitoso
-        Event damageEvent(EventType::DAMAGE_DEALT);
-        damageEvent.setData<int>("character_id", _id.get());
-        damageEvent.setData<int>("damage", damage);
-        damageEvent.setData<std::string>("description", attackType + " attack dealt " + std::to_string(damage) + " damage");
-        notifyObservers(damageEvent);
+        notifyObservers(EventType::DAMAGE_DEALT, [&]() { return createDamageDealtEvent(target, damage, critical); });
         
         // Aplicar daño al objetivo
         target.defense(damage);
@@ -333,51 +319,46 @@ namespace noname
         setLevel(_level);
         setMaxHealth();
         setMaxMana();
-        health.current = health.maximum;
-        mana.current = mana.maximum;
+        health().current = health().maximum;
+        mana().current = mana().maximum;
         _isDead = false;
+        markChanged();
     }
 
     void Character::takeDamage(int value) noexcept
     {
         if (value <= 0)
         {
-            LM.writeLog(Level::Warning, "Invalid damage value: " + std::to_string(value));
+            LM.log<Level::Warning>("Invalid damage value: {}", value);
             return;
         }
 
-        int oldHealth = health.current;
-        health.takeDamage(value);
+        int oldHealth = health().current;
+        health().takeDamage(value);
+        markChanged();
 
         // Notificar daño recibido
-        Event damageEvent(EventType::DAMAGE_TAKEN);
-        damageEvent.setData<std::string>("character_name", _name.get());
-        damageEvent.setData<int>("damage", value);
-        damageEvent.setData<int>("remaining_health", health.current);
-        damageEvent.setData<int>("character_id", _id.get());
-        notifyObservers(damageEvent);
+        notifyObservers(EventType::DAMAGE_TAKEN, [&]() { return createDamageTakenEvent(value); });
 
         // Notificar cambio de salud
-        Event healthEvent = createHealthEvent(EventType::HEALTH_CHANGED, oldHealth, health.current);
-        notifyObservers(healthEvent);
+        notifyObservers(EventType::HEALTH_CHANGED, [&]() { return createHealthEvent(EventType::HEALTH_CHANGED, oldHealth, health().current); });
 
-        if (health.isDead() && !_isDead)
+        if (health().isDead() && !_isDead)
         {
             _isDead = true;
-            LM.writeLog(Level::Info, "Character " + std::to_string(_id) + " has died.");
+            LM.log<Level::Info>("Character {} has died.", _id.get());
             
             // Notificar muerte
-            Event deathEvent = createCharacterEvent(EventType::CHARACTER_DIED);
-            notifyObservers(deathEvent);
+            notifyObservers(EventType::CHARACTER_DIED, [&]() { return createCharacterEvent(EventType::CHARACTER_DIED); });
             
             // Penalización de experiencia por muerte
-            unsigned long long expPenalty = static_cast<unsigned long long>(std::ceil((experience.current * 25) / 100.0));
-            experience.current = std::max(0ULL, experience.current - expPenalty);
+            unsigned long long expPenalty = static_cast<unsigned long long>(std::ceil((experience().current * 25) / 100.0));
+            experience().current = std::max(0ULL, experience().current - expPenalty);
 
             // Verificar si pierde niveles
-            while (experience.current < GM.getExpForLevel(_level - 1))
+            while (experience().current < GM.getExpForLevel(_level - 1))
             {
-                experience.setNextLevelRequirement(GM.getExpForLevel(_level));
+                experience().setNextLevelRequirement(GM.getExpForLevel(_level));
                 --_level;
             }
         }
@@ -385,13 +366,14 @@ namespace noname
 
     void Character::useMana(int value) noexcept
     {
-        if (value > 0 && mana.consume(value))
+        if (value > 0 && mana().consume(value))
         {
-            magicExperience.gain(value);
-            if (magicExperience.hasLeveledUp())
+            markChanged();
+            magicExperience().gain(value);
+            if (magicExperience().hasLeveledUp())
             {
                 ++_magicLevel;
-                magicExperience.setNextLevelRequirement(GM.getManaForLevel(_magicLevel + 1));
+                magicExperience().setNextLevelRequirement(GM.getManaForLevel(_magicLevel + 1));
             }
         }
         // Error handling TBD
@@ -401,37 +383,41 @@ namespace noname
     {
         if (value > 0)
         {
-            mana.restore(value);
+            mana().restore(value);
+            markChanged();
         }
         // Error handling TBD
     }
 
     void Character::writeCharacterInfo() const
     {
-        FileManager characterFile;
-        characterFile.initOutputFile("character-" + _id.toString() + ".html");
-        characterFile.startUp();
-
-        auto title{"Character Info: " + _id.toString()};
-
-        HtmlBuilder infoTable{"table"};
-        infoTable.add_child("caption", title);
-        infoTable.add_child(_id.toHtmlBuilder("Player ID"));
-        infoTable.add_child(_name.toHtmlBuilder("Name"));
-        infoTable.add_child(_level.toHtmlBuilder("Level"));
-        infoTable.add_child(_magicLevel.toHtmlBuilder("Magic Level"));
-        infoTable.add_child(Property<int>(health.current).toHtmlBuilder("Current Health"));
-        infoTable.add_child(Property<int>(health.maximum).toHtmlBuilder("Maximum Health"));
-        infoTable.add_child(Property<int>(mana.current).toHtmlBuilder("Current Mana"));
-        infoTable.add_child(Property<int>(mana.maximum).toHtmlBuilder("Maximum Mana"));
-        infoTable.add_child(Property<int>(capacity.current).toHtmlBuilder("Current Capacity"));
-        infoTable.add_child(Property<int>(capacity.maximum).toHtmlBuilder("Maximum Capacity"));
-        infoTable.add_child(Property<unsigned long long>(experience.current).toHtmlBuilder("Current Experience"));
-        infoTable.add_child(Property<unsigned long long>(experience.nextLevel).toHtmlBuilder("Next Level Experience"));
-        infoTable.add_child(Property<unsigned long long>(magicExperience.current).toHtmlBuilder("Current Mana Wasted"));
-        infoTable.add_child(Property<unsigned long long>(magicExperience.nextLevel).toHtmlBuilder("Next Level Mana Wasted"));
+        std::string html;
+        html.reserve(2048);
+        renderCharacterInfo(html);
+        RS.submit(_id, std::move(html));
+    }
+
+    void Character::renderCharacterInfo(std::string &html) const
+    {
+        HtmlWriter writer{html};
+        writer.open("table");
+        writer.open("caption").text("Character Info: ", _id.get()).close();
+        _id.writeHtml(writer, "Player ID");
+        _name.writeHtml(writer, "Name");
+        _level.writeHtml(writer, "Level");
+        _magicLevel.writeHtml(writer, "Magic Level");
+        Property<int>(health().current).writeHtml(writer, "Current Health");
+        Property<int>(health().maximum).writeHtml(writer, "Maximum Health");
+        Property<int>(mana().current).writeHtml(writer, "Current Mana");
+        Property<int>(mana().maximum).writeHtml(writer, "Maximum Mana");
+        Property<int>(capacity().current).writeHtml(writer, "Current Capacity");
+        Property<int>(capacity().maximum).writeHtml(writer, "Maximum Capacity");
+        Property<unsigned long long>(experience().current).writeHtml(writer, "Current Experience");
+        Property<unsigned long long>(experience().nextLevel).writeHtml(writer, "Next Level Experience");
+        Property<unsigned long long>(magicExperience().current).writeHtml(writer, "Current Mana Wasted");
+        Property<unsigned long long>(magicExperience().nextLevel).writeHtml(writer, "Next Level Mana Wasted");
         // Add Heritables here
-        characterFile.write(infoTable.str());
+        writer.close();
     }
 
     void Character::attack(Character &character) noexcept
@@ -448,7 +434,7 @@ namespace noname
     void Character::defense(short damage) noexcept
     {
         auto shield{10};
-        auto defense{shield + ((skills.at(Utils::toInt(SkillType::SHIELDING)) + 10) / 40)};
+        auto defense{shield + ((skills().at(Utils::toInt(SkillType::SHIELDING)) + 10) / 40)};
         if (damage <= defense) {
             updateTries(SkillType::SHIELDING);
             // No emitir evento aquí ya que no hay daño
@@ -456,7 +442,7 @@ namespace noname
         else
         {
             int actualDamage = damage - defense;
-            LM.writeLog(Level::Debug, "Character " + std::to_string(_id) + " has been damaged with " + std::to_string(actualDamage));
+            LM.log<Level::Debug>("Character {} has been damaged with {}", _id.get(), actualDamage);
             takeDamage(actualDamage);  // esto emitirá el evento DAMAGE_TAKEN
         }
     }
@@ -465,17 +451,17 @@ namespace noname
     {
         if (!item)
         {
-            LM.writeLog(Level::Error, "Attempted to pick a null item.");
+            LM.log<Level::Error>("Attempted to pick a null item.");
             return;
         }
 
-        if (capacity.getAvailable() < item->getWeight())
+        if (capacity().getAvailable() < item->getWeight())
         {
-            LM.writeLog(Level::Debug, "Character " + std::to_string(_id) + " lacks capacity for item " + item->getName());
+            LM.log<Level::Debug>("Character {} lacks capacity for item {}", _id.get(), [&item]() { return item->getName(); });
             return;
         }
 
-        LM.writeLog(Level::Debug, "Character " + std::to_string(_id) + " has picked item " + item->getName());
+        LM.log<Level::Debug>("Character {} has picked item {}", _id.get(), [&item]() { return item->getName(); });
         _inventory.storeItem(std::move(item), slot);
         updateCurrentCapacity();
     }
@@ -491,7 +477,7 @@ namespace noname
     void Character::drop(ItemSlotType slot) noexcept
     {
         auto item{_inventory.dropItem(slot)};
-        LM.writeLog(Level::Debug, "Character " + std::to_string(_id) + " has droped item " + item->getName());
+        LM.log<Level::Debug>("Character {} has droped item {}", _id.get(), [&item]() { return item->getName(); });
         auto weapon = getWeapon();
         if (!weapon)
         {
@@ -503,7 +489,15 @@ namespace noname
 
     void Character::determineHeritables(const Character &father, const Character &mother) noexcept
     {
-        _heritables.determineHeritablesValues(father._heritables, mother._heritables);
-        writeCharacterInfo();
+        determineHeritables(father, mother, Rng::threadLocal());
+    }
+
+    void Character::determineHeritables(const Character &father, const Character &mother, Rng &rng) noexcept
+    {
+        heritables().determineHeritablesValues(father.heritables(), mother.heritables(), rng);
+        if (RS.isReportOnChangeEnabled())
+        {
+            writeCharacterInfo();
+        }
     }
 }
@@ -20,6 +20,7 @@
 #include "EventSubject.h"
 #include "Event.h"
 #include "CharacterData.h"
+#include "CharacterStore.h"
 
 namespace noname
 {
@@ -27,7 +28,7 @@ namespace noname
     {
     public:
         // Constructor de copia personalizado para manejar unique_ptr
-        Character(const Character& other);
+        Character(const Character& other) : Character(other, other._row.sharedStore()) {}
         Character& operator=(const Character& other);
         Character(Character&&) = default;
         Character& operator=(Character&&) = default;
@@ -39,27 +40,41 @@ namespace noname
         Property<short> _level;
         Property<short> _magicLevel;
         
-        // Datos agrupados (sin Property overhead)
-        HealthData health;
-        ManaData mana;
-        ExperienceData experience;
-        ExperienceData magicExperience; // Para nivel mágico
-        CapacityData capacity;
-        SpeedData speed;
+        // Datos agrupados: viven en una fila del CharacterStore (layout SoA)
+        CharacterRow _row;
         
-        // Arrays estáticos para skills (tamaño conocido)
-        static constexpr size_t MAX_SKILLS = static_cast<size_t>(SkillType::LAST_SKILL);
-        std::array<short, MAX_SKILLS> skills;
-        std::array<short, MAX_SKILLS> skillTries;
+        static constexpr size_t MAX_SKILLS = CharacterStore::MAX_SKILLS;
         
         // Otros datos simples
         bool _isDead{false};
-        Heritables _heritables;
         Inventory _inventory;
         
         // Strategy Pattern para combate
         std::unique_ptr<AttackStrategy> attackStrategy;
 
+        // Acceso a la fila del almacén
+        HealthData &health() noexcept { return _row.store().health(_row.slot()); }
+        const HealthData &health() const noexcept { return _row.store().health(_row.slot()); }
+        ManaData &mana() noexcept { return _row.store().mana(_row.slot()); }
+        const ManaData &mana() const noexcept { return _row.store().mana(_row.slot()); }
+        ExperienceData &experience() noexcept { return _row.store().experience(_row.slot()); }
+        const ExperienceData &experience() const noexcept { return _row.store().experience(_row.slot()); }
+        ExperienceData &magicExperience() noexcept { return _row.store().magicExperience(_row.slot()); }
+        const ExperienceData &magicExperience() const noexcept { return _row.store().magicExperience(_row.slot()); }
+        CapacityData &capacity() noexcept { return _row.store().capacity(_row.slot()); }
+        const CapacityData &capacity() const noexcept { return _row.store().capacity(_row.slot()); }
+        SpeedData &speed() noexcept { return _row.store().speed(_row.slot()); }
+        const SpeedData &speed() const noexcept { return _row.store().speed(_row.slot()); }
+        CharacterStore::SkillArray &skills() noexcept { return _row.store().skills(_row.slot()); }
+        const CharacterStore::SkillArray &skills() const noexcept { return _row.store().skills(_row.slot()); }
+        CharacterStore::SkillArray &skillTries() noexcept { return _row.store().skillTries(_row.slot()); }
+        const CharacterStore::SkillArray &skillTries() const noexcept { return _row.store().skillTries(_row.slot()); }
+        Heritables &heritables() noexcept { return _row.store().heritables(_row.slot()); }
+        const Heritables &heritables() const noexcept { return _row.store().heritables(_row.slot()); }
+
+        // Sube la versión de estado tras cambiar algo que aparece en el informe
+        void markChanged() noexcept { _row.store().touch(_row.slot()); }
+
         static int generateId() noexcept;
         void setLevel(short value) noexcept;
         void setMagicLevel(short value) noexcept;
@@ -72,45 +87,61 @@ namespace noname
         void setSkill(SkillType skill, short value) noexcept;
         void updateTries(SkillType skill) noexcept;
 
-        // Helper methods for creating events
+        // Helper methods for creating events. Call them through
+        // notifyObservers(type, factory) so nothing is built when nobody listens.
         Event createHealthEvent(EventType type, int oldValue, int newValue) const;
         Event createManaEvent(EventType type, int oldValue, int newValue) const;
-        Event createCombatEvent(EventType type, const std::string& target, int damage = 0) const;
+        Event createCombatEvent(EventType type, const Character& target, int damage = 0) const;
         Event createExperienceEvent(int expGained, int totalExp) const;
         Event createLevelEvent(EventType type, int oldLevel, int newLevel) const;
         Event createCharacterEvent(EventType type) const;
+        Event createDamageDealtEvent(const Character& target, int damage, bool critical) const;
+        Event createDamageTakenEvent(int damage) const;
+        Event createSkillEvent(EventType type, SkillType skill) const;
 
     public:
         Character();
+        explicit Character(std::shared_ptr<CharacterStore> store);
         explicit Character(std::string_view name) : Character() { _name = std::string(name); }
+        Character(std::string_view name, std::shared_ptr<CharacterStore> store) : Character(std::move(store)) { _name = std::string(name); }
+        Character(const Character &other, std::shared_ptr<CharacterStore> store);
 
         bool operator==(const Character &p) const noexcept { return _id == p._id; }
 
         [[nodiscard]] int getId() const noexcept { return _id; }
         [[nodiscard]] std::string getName() const noexcept { return _name; }
-        [[nodiscard]] unsigned long long getExperience() const noexcept { return experience.current; }
-        [[nodiscard]] unsigned long long getManaWasted() const noexcept { return magicExperience.current; }
+        [[nodiscard]] std::string_view getNameView() const noexcept { return _name.getRef(); }
+        [[nodiscard]] unsigned long long getExperience() const noexcept { return experience().current; }
+        [[nodiscard]] unsigned long long getManaWasted() const noexcept { return magicExperience().current; }
         [[nodiscard]] short getLevel() const noexcept { return _level; }
         [[nodiscard]] short getMagicLevel() const noexcept { return _magicLevel; }
-        [[nodiscard]] short getSkill(SkillType skill) const noexcept { return skills.at(static_cast<size_t>(skill)); }
-        [[nodiscard]] int getCurrentHealth() const noexcept { return health.current; }
-        [[nodiscard]] int getMaxHealth() const noexcept { return health.maximum; }
-        [[nodiscard]] int getCurrentMana() const noexcept { return mana.current; }
-        [[nodiscard]] int getMaxMana() const noexcept { return mana.maximum; }
-        [[nodiscard]] bool isDead() const noexcept { return health.isDead(); }
-        [[nodiscard]] short getHeritable(HeritableType value) const noexcept { return _heritables.at(value); }
+        [[nodiscard]] short getSkill(SkillType skill) const noexcept { return skills().at(static_cast<size_t>(skill)); }
+        [[nodiscard]] int getCurrentHealth() const noexcept { return health().current; }
+        [[nodiscard]] int getMaxHealth() const noexcept { return health().maximum; }
+        [[nodiscard]] int getCurrentMana() const noexcept { return mana().current; }
+        [[nodiscard]] int getMaxMana() const noexcept { return mana().maximum; }
+        [[nodiscard]] bool isDead() const noexcept { return health().isDead(); }
+        [[nodiscard]] short getHeritable(HeritableType value) const noexcept { return heritables().at(value); }
         [[nodiscard]] short getAttackDamage() noexcept;
         [[nodiscard]] std::shared_ptr<Weapon> getWeapon() const noexcept { return _inventory.getWeapon(); }
         
-        // Getters adicionales para acceso a las estructuras completas
-        [[nodiscard]] const HealthData& getHealthData() const noexcept { return health; }
-        [[nodiscard]] const ManaData& getManaData() const noexcept { return mana; }
-        [[nodiscard]] const ExperienceData& getExperienceData() const noexcept { return experience; }
-        [[nodiscard]] const ExperienceData& getMagicExperienceData() const noexcept { return magicExperience; }
-        [[nodiscard]] const CapacityData& getCapacityData() const noexcept { return capacity; }
-        [[nodiscard]] const SpeedData& getSpeedData() const noexcept { return speed; }
+        // Getters adicionales para acceso a las estructuras completas; devuelven
+        // copias porque crear otro personaje puede mover las columnas del almacén
+        [[nodiscard]] HealthData getHealthData() const noexcept { return health(); }
+        [[nodiscard]] ManaData getManaData() const noexcept { return mana(); }
+        [[nodiscard]] ExperienceData getExperienceData() const noexcept { return experience(); }
+        [[nodiscard]] ExperienceData getMagicExperienceData() const noexcept { return magicExperience(); }
+        [[nodiscard]] CapacityData getCapacityData() const noexcept { return capacity(); }
+        [[nodiscard]] SpeedData getSpeedData() const noexcept { return speed(); }
+        [[nodiscard]] const CharacterStore& getStore() const noexcept { return _row.store(); }
+        [[nodiscard]] CharacterStore::Slot getStoreSlot() const noexcept { return _row.slot(); }
+        // Cambia con el nivel, la vida, el maná, la experiencia, la capacidad y el inventario
+        [[nodiscard]] std::uint32_t getStateVersion() const noexcept { return _row.store().version(_row.slot()); }
         
+        // Encola el informe HTML del personaje en el CharacterReportSink (RS)
         void writeCharacterInfo() const;
+        // Añade el informe HTML del personaje al final de html
+        void renderCharacterInfo(std::string &html) const;
         [[nodiscard]] const InventorySlots &getInventorySlots() const noexcept { return _inventory.getSlots(); }
 
         // Strategy Pattern para combate
@@ -140,6 +171,7 @@ namespace noname
 
         // Others
         void determineHeritables(const Character &father, const Character &mother) noexcept;
+        void determineHeritables(const Character &father, const Character &mother, Rng &rng) noexcept;
     };
 }
 
@@ -0,0 +1,192 @@
+#ifndef __CHARACTER_REPORT_CACHE_H__
+#define __CHARACTER_REPORT_CACHE_H__
+
+// System includes
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Local includes
+#include "Character.h"
+#include "CharacterStore.h"
+#include "CharacterReportSink.h"
+#include "FlatIdMap.h"
+
+namespace noname
+{
+    /**
+     * @brief Informes HTML de personajes que solo se regeneran si han cambiado
+     *
+     * Guarda el último informe de cada personaje registrado junto con la
+     * versión de estado con la que se generó (Character::getStateVersion()).
+     * exportChanged() recorre solo las filas que el almacén ha marcado como
+     * cambiadas, así que una exportación periódica cuesta en proporción a los
+     * personajes que han cambiado y no al total.
+     *
+     * Guarda punteros a los personajes: hay que llamar a untrack() antes de
+     * destruirlos.
+     */
+    class CharacterReportCache
+    {
+    private:
+        struct Entry
+        {
+            const Character *character;
+            std::uint32_t version;
+            bool rendered;
+            std::string html;
+        };
+
+        std::vector<Entry> _entries;
+        FlatIdMap<std::uint32_t> _index;
+        std::vector<CharacterStore::Slot> _dirtySlots;
+        std::vector<int> _newIds; // Registrados y aún sin informe
+        size_t _renders{0};
+
+        size_t exportIfChanged(int id)
+        {
+            std::uint32_t *index = _index.find(id);
+            if (!index || !refresh(_entries[*index]))
+            {
+                return 0;
+            }
+            RS.submit(id, _entries[*index].html);
+            return 1;
+        }
+
+        bool refresh(Entry &entry)
+        {
+            const std::uint32_t version = entry.character->getStateVersion();
+            if (entry.rendered && entry.version == version)
+            {
+                return false;
+            }
+            entry.html.clear();
+            entry.character->renderCharacterInfo(entry.html);
+            entry.version = version;
+            entry.rendered = true;
+            ++_renders;
+            return true;
+        }
+
+    public:
+        void reserve(size_t count)
+        {
+            _entries.reserve(count);
+            _index.reserve(count);
+        }
+
+        /**
+         * @brief Registra un personaje; su primer informe se genera en la siguiente exportación
+         */
+        void track(const Character &character)
+        {
+            auto [index, inserted] = _index.tryEmplace(character.getId(), static_cast<std::uint32_t>(_entries.size()));
+            if (inserted)
+            {
+                _entries.push_back(Entry{&character, 0, false, {}});
+            }
+            else
+            {
+                _entries[index].character = &character;
+                _entries[index].rendered = false;
+            }
+            _newIds.push_back(character.getId());
+        }
+
+        bool untrack(int id)
+        {
+            const std::uint32_t *found = _index.find(id);
+            if (!found)
+            {
+                return false;
+            }
+            const std::uint32_t index = *found;
+            _index.erase(id);
+            if (index + 1 != _entries.size())
+            {
+                _entries[index] = std::move(_entries.back());
+                *_index.find(_entries[index].character->getId()) = index;
+            }
+            _entries.pop_back();
+            return true;
+        }
+
+        void clear()
+        {
+            _entries.clear();
+            _index.clear();
+            _dirtySlots.clear();
+            _newIds.clear();
+        }
+
+        /**
+         * @brief Regenera los informes de los personajes registrados cuyas filas
+         * de store han cambiado y los encola en RS
+         *
+         * Consume la lista de filas cambiadas del almacén (CharacterStore::takeDirtySlots()).
+         * Los personajes registrados desde la última exportación se exportan
+         * aunque su fila no esté marcada.
+         * @return Número de informes regenerados
+         */
+        size_t exportChanged(CharacterStore &store)
+        {
+            size_t exported = 0;
+            for (int id : _newIds)
+            {
+                exported += exportIfChanged(id);
+            }
+            _newIds.clear();
+
+            store.takeDirtySlots(_dirtySlots);
+            for (CharacterStore::Slot slot : _dirtySlots)
+            {
+                if (store.isLive(slot))
+                {
+                    exported += exportIfChanged(store.id(slot));
+                }
+            }
+            return exported;
+        }
+
+        /**
+         * @brief Compara la versión de todos los personajes registrados y
+         * exporta los que han cambiado, estén en el almacén que estén
+         *
+         * No consume la lista de filas cambiadas de ningún almacén.
+         * @return Número de informes regenerados
+         */
+        size_t exportAll()
+        {
+            size_t exported = 0;
+            for (auto &entry : _entries)
+            {
+                if (refresh(entry))
+                {
+                    RS.submit(entry.character->getId(), entry.html);
+                    ++exported;
+                }
+            }
+            _newIds.clear();
+            return exported;
+        }
+
+        /**
+         * @brief Último informe generado, o nullptr si no hay ninguno
+         */
+        [[nodiscard]] const std::string *getReport(int id) const noexcept
+        {
+            const std::uint32_t *index = _index.find(id);
+            return index && _entries[*index].rendered ? &_entries[*index].html : nullptr;
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return _entries.size(); }
+        [[nodiscard]] bool contains(int id) const noexcept { return _index.contains(id); }
+
+        // Informes generados desde que se creó la caché
+        [[nodiscard]] size_t getRenderCount() const noexcept { return _renders; }
+    };
+}
+
+#endif // __CHARACTER_REPORT_CACHE_H__
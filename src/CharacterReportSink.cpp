@@ -0,0 +1,173 @@
+#include "CharacterReportSink.h"
+#include "LogManager.h"
+
+namespace noname
+{
+    CharacterReportSink::~CharacterReportSink()
+    {
+        stopBackgroundFlush();
+    }
+
+    void CharacterReportSink::startUp() noexcept
+    {
+        setType("CharacterReportSink");
+        LM.writeLog(Level::Debug, "CharacterReportSink::startUp");
+        std::lock_guard<std::mutex> lock(_writeMutex);
+        openShards();
+        Manager::startUp();
+    }
+
+    void CharacterReportSink::shutDown() noexcept
+    {
+        stopBackgroundFlush();
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(_writeMutex);
+            closeShards();
+        }
+        Manager::shutDown();
+        LM.writeLog(Level::Debug, "CharacterReportSink::shutDown");
+    }
+
+    void CharacterReportSink::openShards()
+    {
+        closeShards();
+        for (size_t shard = 0; shard < _shardCount; ++shard)
+        {
+            auto file = std::make_unique<FileManager>();
+            file->initOutputFile(getShardPath(shard));
+            file->startUp();
+            _shards.push_back(std::move(file));
+        }
+    }
+
+    void CharacterReportSink::closeShards()
+    {
+        for (auto &file : _shards)
+        {
+            file->shutDown();
+        }
+        _shards.clear();
+    }
+
+    std::filesystem::path CharacterReportSink::getShardPath(size_t shard) const
+    {
+        if (_shardCount == 1)
+        {
+            return CHARACTER_REPORTS_NAME.string() + ".html";
+        }
+        return CHARACTER_REPORTS_NAME.string() + "-" + std::to_string(shard) + ".html";
+    }
+
+    void CharacterReportSink::setShardCount(size_t count) noexcept
+    {
+        if (isStarted())
+        {
+            flush();
+        }
+        std::lock_guard<std::mutex> lock(_writeMutex);
+        _shardCount = count > 0 ? count : 1;
+        if (!_shards.empty())
+        {
+            openShards();
+        }
+    }
+
+    void CharacterReportSink::submit(int id, std::string html)
+    {
+        bool wakeWorker = false;
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _pending.push_back({id, std::move(html)});
+            wakeWorker = _pending.size() >= _batchSize;
+        }
+        if (wakeWorker)
+        {
+            _wakeUp.notify_one();
+        }
+    }
+
+    size_t CharacterReportSink::getPendingCount()
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        return _pending.size();
+    }
+
+    void CharacterReportSink::flush()
+    {
+        std::vector<Report> batch;
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            batch.swap(_pending);
+        }
+        if (!batch.empty())
+        {
+            writeBatch(batch);
+        }
+    }
+
+    void CharacterReportSink::writeBatch(std::vector<Report> &batch)
+    {
+        // El reparto se hace con el mismo número de ficheros que está abierto
+        std::lock_guard<std::mutex> lock(_writeMutex);
+        if (_shards.empty())
+        {
+            // Puede llamarse desde el hilo en segundo plano: no se arranca aquí
+            LM.log<Level::Error>("CharacterReportSink::flush without startUp, dropping {} reports", batch.size());
+            return;
+        }
+
+        // Un único write por fichero y lote
+        const size_t shardCount = _shards.size();
+        std::vector<std::string> buffers(shardCount);
+        for (auto &report : batch)
+        {
+            auto shard = static_cast<size_t>(report.id) % shardCount;
+            buffers[shard] += report.html;
+        }
+
+        for (size_t shard = 0; shard < shardCount; ++shard)
+        {
+            if (!buffers[shard].empty())
+            {
+                _shards[shard]->write(buffers[shard]);
+            }
+        }
+        _written += batch.size();
+    }
+
+    void CharacterReportSink::startBackgroundFlush(std::chrono::milliseconds interval)
+    {
+        stopBackgroundFlush();
+        _stopWorker = false;
+        _worker = std::thread([this, interval]()
+        {
+            std::unique_lock<std::mutex> lock(_queueMutex);
+            while (!_stopWorker)
+            {
+                _wakeUp.wait_for(lock, interval, [this]()
+                                 { return _stopWorker || _pending.size() >= _batchSize; });
+                lock.unlock();
+                flush();
+                lock.lock();
+            }
+            // Lo encolado antes de parar, aunque el hilo no llegara a esperar
+            lock.unlock();
+            flush();
+        });
+    }
+
+    void CharacterReportSink::stopBackgroundFlush()
+    {
+        if (!_worker.joinable())
+        {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _stopWorker = true;
+        }
+        _wakeUp.notify_one();
+        _worker.join();
+    }
+}
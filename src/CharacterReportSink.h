@@ -0,0 +1,89 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <filesystem>
+#include <condition_variable>
+
+#include "Singleton.h"
+#include "Manager.h"
+#include "FileManager.h"
+
+// Two-letter acronym for easier access to manager
+#define RS noname::CharacterReportSink::getInstance()
+
+namespace noname
+{
+    const std::filesystem::path CHARACTER_REPORTS_NAME = "characters";
+
+    /**
+     * @brief Cola de informes de personajes escritos por lotes
+     *
+     * Los informes se encolan en memoria y se escriben juntos en un único
+     * fichero consolidado (characters.html) o en un pequeño conjunto de
+     * ficheros repartidos por id (characters-<n>.html). La escritura se hace
+     * bajo demanda con flush() o periódicamente desde un hilo en segundo plano.
+     */
+    class CharacterReportSink : public Manager, public Singleton<CharacterReportSink>
+    {
+    private:
+        struct Report
+        {
+            int id;
+            std::string html;
+        };
+
+        std::vector<Report> _pending;
+        std::vector<std::unique_ptr<FileManager>> _shards;
+        // Los lee el hilo en segundo plano y los consultores sin tomar los mutex
+        std::atomic<size_t> _shardCount{1};
+        std::atomic<size_t> _batchSize{1024};
+        bool _reportOnChange{false};
+        std::atomic<size_t> _written{0};
+
+        std::mutex _queueMutex;
+        std::mutex _writeMutex;
+        std::condition_variable _wakeUp;
+        std::thread _worker;
+        bool _stopWorker{false};
+
+        void openShards();
+        void closeShards();
+        void writeBatch(std::vector<Report> &batch);
+
+    public:
+        ~CharacterReportSink() override;
+
+        void startUp() noexcept override;
+        void shutDown() noexcept override;
+
+        // Encola un informe; no hace ninguna operación de entrada/salida
+        void submit(int id, std::string html);
+
+        // Escribe todos los informes pendientes; sin startUp() los descarta
+        void flush();
+
+        void startBackgroundFlush(std::chrono::milliseconds interval);
+        void stopBackgroundFlush();
+
+        // Número de ficheros entre los que se reparten los informes (1 = consolidado)
+        void setShardCount(size_t count) noexcept;
+        [[nodiscard]] size_t getShardCount() const noexcept { return _shardCount; }
+
+        // Informes pendientes que despiertan al hilo en segundo plano
+        void setBatchSize(size_t size) noexcept { _batchSize = size > 0 ? size : 1; }
+
+        // Si es true, Character encola su informe al crearse o al heredar
+        void setReportOnChange(bool value) noexcept { _reportOnChange = value; }
+        [[nodiscard]] bool isReportOnChangeEnabled() const noexcept { return _reportOnChange; }
+
+        [[nodiscard]] size_t getPendingCount();
+        [[nodiscard]] size_t getWrittenCount() const noexcept { return _written; }
+        [[nodiscard]] std::filesystem::path getShardPath(size_t shard) const;
+    };
+}
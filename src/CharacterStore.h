@@ -0,0 +1,378 @@
+#ifndef __CHARACTER_STORE_H__
+#define __CHARACTER_STORE_H__
+
+// System includes
+#include <array>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <thread>
+#include <stdexcept>
+
+// Local includes
+#include "CharacterData.h"
+#include "Heritables.h"
+#include "Skill.h"
+#include "LogManager.h"
+
+namespace noname
+{
+    /**
+     * @brief Almacén Structure-of-Arrays de los datos de los personajes
+     *
+     * Cada estructura de CharacterData vive en un array denso propio, indexado
+     * por el slot de la entidad. Los recorridos masivos (regeneración, daño de
+     * área...) iteran los arrays de forma lineal sin pasar por los objetos
+     * Character, que solo actúan como fachada sobre una fila del almacén.
+     *
+     * Un almacén pertenece al primer hilo que reserva una fila en él y no
+     * tiene sincronización: allocate() desde otro hilo lanza
+     * std::logic_error, y release() desde otro hilo (por ejemplo, un
+     * Character destruido en un worker) deja la fila ocupada y registra un
+     * error en vez de tocar la lista de libres. Las referencias que devuelven los accesores por fila
+     * solo valen hasta el siguiente allocate() o reserve(), que pueden hacer
+     * crecer las columnas.
+     */
+    class CharacterStore
+    {
+    public:
+        using Slot = std::uint32_t;
+        static constexpr Slot INVALID_SLOT = std::numeric_limits<Slot>::max();
+        static constexpr size_t MAX_SKILLS = static_cast<size_t>(SkillType::LAST_SKILL);
+        using SkillArray = std::array<short, MAX_SKILLS>;
+
+    private:
+        std::vector<int> _ids;
+        std::vector<HealthData> _health;
+        std::vector<ManaData> _mana;
+        std::vector<ExperienceData> _experience;
+        std::vector<ExperienceData> _magicExperience;
+        std::vector<CapacityData> _capacity;
+        std::vector<SpeedData> _speed;
+        std::vector<SkillArray> _skills;
+        std::vector<SkillArray> _skillTries;
+        std::vector<Heritables> _heritables;
+        std::vector<std::uint8_t> _live;
+
+        // Versión de cada fila y filas cambiadas desde el último takeDirtySlots()
+        std::vector<std::uint32_t> _versions;
+        std::vector<std::uint8_t> _dirty;
+        std::vector<Slot> _dirtySlots;
+
+        std::vector<Slot> _freeSlots;
+        size_t _liveCount{0};
+
+        // Hilo propietario; se fija en el primer allocate()
+        std::thread::id _owner;
+
+        void resetRow(Slot slot) noexcept
+        {
+            _health[slot] = HealthData{};
+            _mana[slot] = ManaData{};
+            _experience[slot] = ExperienceData{};
+            _magicExperience[slot] = ExperienceData{};
+            _capacity[slot] = CapacityData{};
+            _speed[slot] = SpeedData{};
+            _skills[slot] = SkillArray{};
+            _skillTries[slot] = SkillArray{};
+            _heritables[slot] = Heritables{Heritables::Values{}};
+        }
+
+    public:
+        /**
+         * @brief Almacén de los personajes creados sin almacén explícito
+         *
+         * Hay uno por hilo, así que crear personajes en hilos distintos no
+         * comparte columnas.
+         */
+        static std::shared_ptr<CharacterStore> defaultStore()
+        {
+            thread_local std::shared_ptr<CharacterStore> store = std::make_shared<CharacterStore>();
+            return store;
+        }
+
+        /**
+         * @brief Reserva una fila con los valores por defecto de CharacterData
+         * @param id Identificador del personaje propietario de la fila
+         * @return Slot asignado (reutiliza slots liberados antes de crecer)
+         */
+        Slot allocate(int id)
+        {
+            const std::thread::id current = std::this_thread::get_id();
+            if (_owner == std::thread::id{})
+            {
+                _owner = current;
+            }
+            else if (_owner != current)
+            {
+                throw std::logic_error("CharacterStore::allocate() called from a thread that does not own the store");
+            }
+            Slot slot;
+            if (!_freeSlots.empty())
+            {
+                slot = _freeSlots.back();
+                _freeSlots.pop_back();
+                resetRow(slot);
+            }
+            else
+            {
+                slot = static_cast<Slot>(_ids.size());
+                _ids.emplace_back();
+                _health.emplace_back();
+                _mana.emplace_back();
+                _experience.emplace_back();
+                _magicExperience.emplace_back();
+                _capacity.emplace_back();
+                _speed.emplace_back();
+                _skills.emplace_back();
+                _skillTries.emplace_back();
+                _heritables.emplace_back(Heritables::Values{});
+                _live.emplace_back();
+                _versions.emplace_back();
+                _dirty.emplace_back();
+            }
+            _ids[slot] = id;
+            _live[slot] = 1;
+            ++_liveCount;
+            touch(slot);
+            return slot;
+        }
+
+        /**
+         * @brief Libera una fila para que pueda reutilizarse
+         *
+         * Solo desde el hilo propietario: desde otro la fila no se libera.
+         */
+        void release(Slot slot) noexcept
+        {
+            if (slot >= _live.size() || !_live[slot])
+            {
+                return;
+            }
+            if (_owner != std::this_thread::get_id())
+            {
+                LM.log<Level::Error>("CharacterStore::release() of slot {} from a thread that does not own the store", slot);
+                return;
+            }
+            _live[slot] = 0;
+            --_liveCount;
+            _freeSlots.push_back(slot);
+        }
+
+        /**
+         * @brief Copia todos los datos de una fila (excepto el id) desde otro almacén
+         */
+        void copyRow(Slot destination, const CharacterStore &source, Slot slot) noexcept
+        {
+            _health[destination] = source._health[slot];
+            _mana[destination] = source._mana[slot];
+            _experience[destination] = source._experience[slot];
+            _magicExperience[destination] = source._magicExperience[slot];
+            _capacity[destination] = source._capacity[slot];
+            _speed[destination] = source._speed[slot];
+            _skills[destination] = source._skills[slot];
+            _skillTries[destination] = source._skillTries[slot];
+            _heritables[destination] = source._heritables[slot];
+            touch(destination);
+        }
+
+        void reserve(size_t rows)
+        {
+            _ids.reserve(rows);
+            _health.reserve(rows);
+            _mana.reserve(rows);
+            _experience.reserve(rows);
+            _magicExperience.reserve(rows);
+            _capacity.reserve(rows);
+            _speed.reserve(rows);
+            _skills.reserve(rows);
+            _skillTries.reserve(rows);
+            _heritables.reserve(rows);
+            _live.reserve(rows);
+            _versions.reserve(rows);
+            _dirty.reserve(rows);
+        }
+
+        /**
+         * @brief Marca una fila como cambiada
+         *
+         * Sube su versión y la apunta una sola vez en la lista de filas
+         * cambiadas, de modo que quien la consuma no tenga que recorrer el
+         * almacén entero para saber qué ha cambiado.
+         */
+        void touch(Slot slot) noexcept
+        {
+            ++_versions[slot];
+            if (!_dirty[slot])
+            {
+                _dirty[slot] = 1;
+                _dirtySlots.push_back(slot);
+            }
+        }
+
+        /**
+         * @brief Versión de la fila; solo crece, también al reutilizar el slot
+         */
+        [[nodiscard]] std::uint32_t version(Slot slot) const noexcept { return _versions[slot]; }
+
+        /**
+         * @brief Entrega las filas cambiadas desde la última llamada y vacía la lista
+         *
+         * Las filas pueden estar ya liberadas: hay que comprobarlo con isLive().
+         * Pensado para un único consumidor por almacén.
+         */
+        void takeDirtySlots(std::vector<Slot> &slots)
+        {
+            slots.clear();
+            slots.swap(_dirtySlots);
+            for (Slot slot : slots)
+            {
+                _dirty[slot] = 0;
+            }
+        }
+
+        [[nodiscard]] size_t dirtyCount() const noexcept { return _dirtySlots.size(); }
+
+        // Número de filas (incluidas las libres) y de filas en uso
+        [[nodiscard]] size_t size() const noexcept { return _ids.size(); }
+        [[nodiscard]] size_t liveCount() const noexcept { return _liveCount; }
+        [[nodiscard]] bool isLive(Slot slot) const noexcept { return slot < _live.size() && _live[slot]; }
+
+        // Acceso a una fila
+        [[nodiscard]] int id(Slot slot) const noexcept { return _ids[slot]; }
+        [[nodiscard]] HealthData &health(Slot slot) noexcept { return _health[slot]; }
+        [[nodiscard]] const HealthData &health(Slot slot) const noexcept { return _health[slot]; }
+        [[nodiscard]] ManaData &mana(Slot slot) noexcept { return _mana[slot]; }
+        [[nodiscard]] const ManaData &mana(Slot slot) const noexcept { return _mana[slot]; }
+        [[nodiscard]] ExperienceData &experience(Slot slot) noexcept { return _experience[slot]; }
+        [[nodiscard]] const ExperienceData &experience(Slot slot) const noexcept { return _experience[slot]; }
+        [[nodiscard]] ExperienceData &magicExperience(Slot slot) noexcept { return _magicExperience[slot]; }
+        [[nodiscard]] const ExperienceData &magicExperience(Slot slot) const noexcept { return _magicExperience[slot]; }
+        [[nodiscard]] CapacityData &capacity(Slot slot) noexcept { return _capacity[slot]; }
+        [[nodiscard]] const CapacityData &capacity(Slot slot) const noexcept { return _capacity[slot]; }
+        [[nodiscard]] SpeedData &speed(Slot slot) noexcept { return _speed[slot]; }
+        [[nodiscard]] const SpeedData &speed(Slot slot) const noexcept { return _speed[slot]; }
+        [[nodiscard]] SkillArray &skills(Slot slot) noexcept { return _skills[slot]; }
+        [[nodiscard]] const SkillArray &skills(Slot slot) const noexcept { return _skills[slot]; }
+        [[nodiscard]] SkillArray &skillTries(Slot slot) noexcept { return _skillTries[slot]; }
+        [[nodiscard]] const SkillArray &skillTries(Slot slot) const noexcept { return _skillTries[slot]; }
+        [[nodiscard]] Heritables &heritables(Slot slot) noexcept { return _heritables[slot]; }
+        [[nodiscard]] const Heritables &heritables(Slot slot) const noexcept { return _heritables[slot]; }
+
+        // Acceso a las columnas completas para recorridos lineales
+        [[nodiscard]] const std::vector<int> &ids() const noexcept { return _ids; }
+        [[nodiscard]] const std::vector<HealthData> &healthColumn() const noexcept { return _health; }
+        [[nodiscard]] const std::vector<ManaData> &manaColumn() const noexcept { return _mana; }
+        [[nodiscard]] const std::vector<ExperienceData> &experienceColumn() const noexcept { return _experience; }
+        [[nodiscard]] const std::vector<ExperienceData> &magicExperienceColumn() const noexcept { return _magicExperience; }
+        [[nodiscard]] const std::vector<CapacityData> &capacityColumn() const noexcept { return _capacity; }
+        [[nodiscard]] const std::vector<SpeedData> &speedColumn() const noexcept { return _speed; }
+        [[nodiscard]] const std::vector<SkillArray> &skillsColumn() const noexcept { return _skills; }
+        [[nodiscard]] const std::vector<SkillArray> &skillTriesColumn() const noexcept { return _skillTries; }
+        [[nodiscard]] const std::vector<Heritables> &heritablesColumn() const noexcept { return _heritables; }
+        [[nodiscard]] const std::vector<std::uint8_t> &liveColumn() const noexcept { return _live; }
+
+        /**
+         * @brief Regenera vida y maná de todos los personajes vivos
+         *
+         * Recorrido lineal sobre las columnas de vida y maná. Los personajes
+         * muertos no regeneran: vuelven con Character::respawn().
+         */
+        void regenerate(int healthAmount, int manaAmount) noexcept
+        {
+            const size_t rows = _ids.size();
+            for (size_t slot = 0; slot < rows; ++slot)
+            {
+                if (_live[slot] && !_health[slot].isDead())
+                {
+                    const int health = _health[slot].current;
+                    const int mana = _mana[slot].current;
+                    _health[slot].heal(healthAmount);
+                    _mana[slot].restore(manaAmount);
+                    // Los que ya estaban al máximo no cambian de versión
+                    if (_health[slot].current != health || _mana[slot].current != mana)
+                    {
+                        touch(static_cast<Slot>(slot));
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Aplica daño a todos los personajes del almacén
+         *
+         * No emite eventos ni aplica la penalización por muerte; para daño con
+         * efectos secundarios hay que pasar por Character::takeDamage().
+         */
+        void applyDamage(int amount) noexcept
+        {
+            const size_t rows = _ids.size();
+            for (size_t slot = 0; slot < rows; ++slot)
+            {
+                if (_live[slot])
+                {
+                    const int health = _health[slot].current;
+                    _health[slot].takeDamage(amount);
+                    if (_health[slot].current != health)
+                    {
+                        touch(static_cast<Slot>(slot));
+                    }
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Propiedad (RAII) de una fila de CharacterStore
+     *
+     * Solo se puede mover: el origen queda sin fila y el destructor la libera.
+     */
+    class CharacterRow
+    {
+    private:
+        std::shared_ptr<CharacterStore> _store;
+        CharacterStore::Slot _slot{CharacterStore::INVALID_SLOT};
+
+    public:
+        CharacterRow(std::shared_ptr<CharacterStore> store, int id)
+            : _store{std::move(store)}, _slot{_store->allocate(id)} {}
+
+        CharacterRow(const CharacterRow &) = delete;
+        CharacterRow &operator=(const CharacterRow &) = delete;
+
+        CharacterRow(CharacterRow &&other) noexcept
+            : _store{std::move(other._store)},
+              _slot{std::exchange(other._slot, CharacterStore::INVALID_SLOT)} {}
+
+        CharacterRow &operator=(CharacterRow &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                _store = std::move(other._store);
+                _slot = std::exchange(other._slot, CharacterStore::INVALID_SLOT);
+            }
+            return *this;
+        }
+
+        ~CharacterRow() { reset(); }
+
+        void reset() noexcept
+        {
+            if (_store && _slot != CharacterStore::INVALID_SLOT)
+            {
+                _store->release(_slot);
+            }
+            _slot = CharacterStore::INVALID_SLOT;
+        }
+
+        [[nodiscard]] CharacterStore &store() const noexcept { return *_store; }
+        [[nodiscard]] const std::shared_ptr<CharacterStore> &sharedStore() const noexcept { return _store; }
+        [[nodiscard]] CharacterStore::Slot slot() const noexcept { return _slot; }
+    };
+}
+
+#endif // __CHARACTER_STORE_H__
@@ -114,7 +114,10 @@ namespace noname
          * @brief Activa/desactiva logging verboso
          */
         void setVerboseLogging(bool verbose) {
-            verboseLogging_ = verbose;
+            if (verboseLogging_ != verbose) {
+                verboseLogging_ = verbose;
+                invalidateSubscriptions(); // Cambia handlesEventType()
+            }
         }
         
         bool isVerboseLoggingEnabled() const {
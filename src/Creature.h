@@ -26,10 +26,12 @@ namespace noname
     public:
         Creature() : Character() {}
         Creature(const std::string &name, const CreatureType &type) : Character(name), _type{type} {}
+        Creature(const Creature &other) = default;
+        Creature(const Creature &other, std::shared_ptr<CharacterStore> store) : Character(other, std::move(store)), _type{other._type} {}
 
         void getInfoForRanking(HtmlBuilder &builder, const SkillType &skill)
         {
-            builder.add_child(HtmlBuilder{"tr"}.add_child("td", _id.toString()).add_child("td", _level.toString()).add_child("td", std::to_string(skills.at(Utils::toInt(skill)))));
+            builder.add_child(HtmlBuilder{"tr"}.add_child("td", _id.toString()).add_child("td", _level.toString()).add_child("td", std::to_string(skills().at(Utils::toInt(skill)))));
         }
     };
 }
@@ -7,6 +7,8 @@
 #include "LogManager.h"
 #include "Creature.h"
 #include "Relationships.h"
+#include "FlatIdMap.h"
+#include "Factions.h"
 
 // System includes
 #include <vector>
@@ -22,7 +24,30 @@ namespace noname
 
     private:
         std::unordered_map<std::string, std::shared_ptr<noname::Creature>> _creatures;
+        FlatIdMap<std::shared_ptr<Creature>> _creaturesById;
         Relationships<Creature> _relationships;
+        Factions _factions;
+
+        void addCreature(std::shared_ptr<Creature> creature)
+        {
+            _creaturesById.tryEmplace(creature->getId(), creature);
+            _creatures.emplace(creature->getName(), std::move(creature));
+        }
+
+        // Criaturas registradas para los ids dados; no copia ninguna
+        std::vector<std::shared_ptr<Creature>> creaturesWithIds(const std::vector<int> &ids) const
+        {
+            std::vector<std::shared_ptr<Creature>> result;
+            result.reserve(ids.size());
+            for (int id : ids)
+            {
+                if (const auto *creature = _creaturesById.find(id))
+                {
+                    result.push_back(*creature);
+                }
+            }
+            return result;
+        }
 
     public:
         void startUp() noexcept
@@ -36,6 +61,9 @@ namespace noname
         void shutDown() noexcept
         {
             _creatures.clear();
+            _creaturesById.clear();
+            _relationships = {};
+            _factions.clear();
             Manager::shutDown();
             LM.writeLog(Level::Debug, "CreaturesManager::shutDown");
         }
@@ -44,9 +72,16 @@ namespace noname
         {
             std::shared_ptr<Creature> rat = std::make_shared<Creature>("Rat", CreatureType::BEAST);
             std::shared_ptr<Creature> cat = std::make_shared<Creature>("Cat", CreatureType::BEAST);
-            _creatures.emplace(rat->getName(), rat);
-            _creatures.emplace(cat->getName(), cat);
+            addCreature(rat);
+            addCreature(cat);
             _relationships.add_predator_and_prey(*cat, *rat);
+
+            // Los depredadores pueden atacar a sus presas
+            const auto cats = _factions.addFaction("Cats");
+            const auto rats = _factions.addFaction("Rats");
+            _factions.join(cat->getId(), cats);
+            _factions.join(rat->getId(), rats);
+            _factions.setHostile(cats, rats);
         }
 
         std::unordered_map<std::string, std::shared_ptr<noname::Creature>> getCreaturesList() const
@@ -59,26 +94,33 @@ namespace noname
             return _creatures.at(name);
         }
 
-        std::vector<std::shared_ptr<Creature>> findPreyOf(const std::string &name)
+        std::shared_ptr<Creature> findCreature(int id) const
         {
-            auto prey = _relationships.find_prey_of(name);
-            std::vector<std::shared_ptr<Creature>> preyPtrs;
-            for (auto &p : prey)
-            {
-                preyPtrs.push_back(std::make_shared<Creature>(p));
-            }
-            return preyPtrs;
+            const auto *creature = _creaturesById.find(id);
+            return creature ? *creature : nullptr;
         }
 
-        std::vector<std::shared_ptr<Creature>> findPredatorOf(const std::string &name)
+        [[nodiscard]] const Relationships<Creature> &getRelationships() const noexcept { return _relationships; }
+        [[nodiscard]] Factions &getFactions() noexcept { return _factions; }
+        [[nodiscard]] const Factions &getFactions() const noexcept { return _factions; }
+
+        /**
+         * @brief Si attacker puede atacar a target según sus facciones, en tiempo constante
+         */
+        [[nodiscard]] bool mayAttack(const Character &attacker, const Character &target) const noexcept
         {
-            auto predators = _relationships.find_predator_of(name);
-            std::vector<std::shared_ptr<Creature>> predatorPtrs;
-            for (auto &predator : predators)
-            {
-                predatorPtrs.push_back(std::make_shared<Creature>(predator));
-            }
-            return predatorPtrs;
+            return _factions.mayAttack(attacker.getId(), target.getId());
+        }
+
+        // Devuelven las criaturas registradas, no copias
+        std::vector<std::shared_ptr<Creature>> findPreyOf(const std::string &name) const
+        {
+            return creaturesWithIds(_relationships.find_prey_of(name));
+        }
+
+        std::vector<std::shared_ptr<Creature>> findPredatorOf(const std::string &name) const
+        {
+            return creaturesWithIds(_relationships.find_predator_of(name));
         }
     };
 }
@@ -2,9 +2,13 @@
 #define __EVENT_H__
 
 #include "EventTypes.h"
+#include "EventPayloads.h"
 #include <any>
 #include <unordered_map>
 #include <string>
+#include <string_view>
+#include <optional>
+#include <variant>
 #include <vector>
 #include <stdexcept>
 
@@ -14,12 +18,37 @@ namespace noname
      * @brief Clase Event - Representa un evento del sistema
      * 
      * Encapsula información sobre eventos que ocurren en el juego.
-     * Usa std::any para permitir datos tipados flexibles.
+     * Los datos van en un payload tipado por EventType (ver EventPayloads.h),
+     * que se construye sin reservar memoria. La API de claves de texto
+     * (setData/getData) se mantiene como adaptador sobre el payload para los
+     * observers que todavía no han migrado.
      */
     class Event {
     private:
         EventType type_;
-        std::unordered_map<std::string, std::any> data_;
+        EventPayload payload_;
+        std::unordered_map<std::string, std::any> data_; // Datos extra añadidos con setData
+        
+        template<typename T, typename F>
+        static std::optional<T> convertField(const F& field) {
+            if constexpr (std::is_same_v<T, F>) {
+                return field;
+            } else if constexpr (std::is_same_v<T, std::string> && std::is_same_v<F, std::string_view>) {
+                return std::string(field);
+            } else if constexpr (std::is_arithmetic_v<T> && std::is_arithmetic_v<F> &&
+                                 std::is_same_v<T, bool> == std::is_same_v<F, bool>) {
+                return static_cast<T>(field);
+            } else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && std::is_enum_v<F>) {
+                return static_cast<T>(field);
+            } else {
+                return std::nullopt;
+            }
+        }
+        
+        template<typename Visitor>
+        void visitFields(Visitor&& visit) const {
+            std::visit([this, &visit](const auto& payload) { forEachField(payload, type_, visit); }, payload_);
+        }
         
     public:
         /**
@@ -28,11 +57,65 @@ namespace noname
          */
         explicit Event(EventType type) : type_(type) {}
         
+        /**
+         * @brief Constructor con payload tipado
+         * @param type Tipo de evento
+         * @param payload Datos del evento
+         */
+        Event(EventType type, EventPayload payload) : type_(type), payload_(std::move(payload)) {}
+        
+        /**
+         * @brief Crea un evento comprobando en compilación que el payload corresponde al tipo
+         */
+        template<EventType T>
+        static Event make(PayloadFor_t<T> payload) {
+            return Event(T, std::move(payload));
+        }
+        
         /**
          * @brief Obtiene el tipo de evento
          */
         EventType getType() const { return type_; }
         
+        /**
+         * @brief Obtiene el payload tipado de un EventType
+         * @tparam T Tipo de evento esperado
+         * @return Referencia al payload
+         * @throws std::runtime_error si el evento es de otro tipo o no tiene payload
+         */
+        template<EventType T>
+        const PayloadFor_t<T>& payload() const {
+            using Payload = PayloadFor_t<T>;
+            static_assert(!std::is_same_v<Payload, std::monostate>, "EventType without a typed payload");
+            const auto* value = std::get_if<Payload>(&payload_);
+            if (type_ != T || !value) {
+                throw std::runtime_error(std::string("Event ") + eventTypeToString(type_) +
+                                         " does not carry a " + eventTypeToString(T) + " payload");
+            }
+            return *value;
+        }
+        
+        /**
+         * @brief Obtiene el payload si es del tipo indicado
+         * @return Puntero al payload o nullptr
+         */
+        template<typename Payload>
+        const Payload* tryPayload() const {
+            return std::get_if<Payload>(&payload_);
+        }
+        
+        const EventPayload& getPayload() const { return payload_; }
+        
+        /**
+         * @brief Llama a visit(std::string_view&) con cada nombre del payload
+         *
+         * Permite reapuntar los nombres a una copia que viva tanto como el evento.
+         */
+        template<typename Visitor>
+        void forEachName(Visitor&& visit) {
+            std::visit([&visit](auto& payload) { noname::forEachName(payload, visit); }, payload_);
+        }
+        
         /**
          * @brief Agrega datos tipados al evento
          * @tparam T Tipo de dato
@@ -50,16 +133,36 @@ namespace noname
          * @param key Clave del dato
          * @return Valor del dato
          * @throws std::runtime_error si la clave no existe o el tipo es incorrecto
+         *
+         * Busca primero en los datos añadidos con setData y después en los
+         * campos del payload, con los nombres de clave de la API anterior.
          */
         template<typename T>
         T getData(const std::string& key) const {
-            auto it = data_.find(key);
-            if (it != data_.end()) {
-                try {
-                    return std::any_cast<T>(it->second);
-                } catch (const std::bad_any_cast& e) {
-                    throw std::runtime_error("Invalid data type for key '" + key + "': " + e.what());
+            if (!data_.empty()) {
+                auto it = data_.find(key);
+                if (it != data_.end()) {
+                    try {
+                        return std::any_cast<T>(it->second);
+                    } catch (const std::bad_any_cast& e) {
+                        throw std::runtime_error("Invalid data type for key '" + key + "': " + e.what());
+                    }
+                }
+            }
+            
+            std::optional<T> value;
+            bool found = false;
+            visitFields([&](std::string_view name, const auto& field) {
+                if (!found && name == key) {
+                    found = true;
+                    value = convertField<T>(field);
                 }
+            });
+            if (value) {
+                return *value;
+            }
+            if (found) {
+                throw std::runtime_error("Invalid data type for key '" + key + "'");
             }
             throw std::runtime_error("Key not found: " + key);
         }
@@ -86,7 +189,12 @@ namespace noname
          * @return true si la clave existe
          */
         bool hasData(const std::string& key) const {
-            return data_.find(key) != data_.end();
+            if (data_.find(key) != data_.end()) {
+                return true;
+            }
+            bool found = false;
+            visitFields([&](std::string_view name, const auto&) { found = found || name == key; });
+            return found;
         }
         
         /**
@@ -99,6 +207,7 @@ namespace noname
             for (const auto& pair : data_) {
                 keys.push_back(pair.first);
             }
+            visitFields([&keys](std::string_view name, const auto&) { keys.emplace_back(name); });
             return keys;
         }
         
@@ -106,7 +215,9 @@ namespace noname
          * @brief Obtiene el número de datos almacenados
          */
         size_t getDataCount() const {
-            return data_.size();
+            size_t count = data_.size();
+            visitFields([&count](std::string_view, const auto&) { ++count; });
+            return count;
         }
         
         /**
@@ -114,6 +225,7 @@ namespace noname
          */
         void clearData() {
             data_.clear();
+            payload_ = std::monostate{};
         }
         
         /**
@@ -121,15 +233,14 @@ namespace noname
          */
         std::string toString() const {
             std::string result = "Event[" + std::string(eventTypeToString(type_)) + "]";
-            if (!data_.empty()) {
+            auto keys = getKeys();
+            if (!keys.empty()) {
                 result += " with data: ";
-                for (const auto& pair : data_) {
-                    result += pair.first + ", ";
+                for (const auto& key : keys) {
+                    result += key + ", ";
                 }
                 // Remover la última coma y espacio
-                if (result.size() >= 2) {
-                    result.erase(result.size() - 2);
-                }
+                result.erase(result.size() - 2);
             }
             return result;
         }
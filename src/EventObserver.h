@@ -2,6 +2,8 @@
 #define __EVENT_OBSERVER_H__
 
 #include "Event.h"
+#include <atomic>
+#include <span>
 #include <string>
 
 namespace noname
@@ -13,15 +15,64 @@ namespace noname
      * que quieren recibir notificaciones de eventos.
      */
     class EventObserver {
+    private:
+        static inline std::atomic<std::uint64_t> subscriptionEpoch_{0};
+        
+    protected:
+        /**
+         * @brief Avisa a los subjects de que handlesEventType(), isActive() o
+         * getPriority() de este observer han cambiado
+         *
+         * Los subjects leen esos valores al suscribir y los guardan en sus
+         * tablas de despacho; las reconstruyen en la siguiente notificación.
+         */
+        static void invalidateSubscriptions() noexcept {
+            subscriptionEpoch_.fetch_add(1, std::memory_order_release);
+        }
+        
     public:
         virtual ~EventObserver() = default;
         
+        static std::uint64_t getSubscriptionEpoch() noexcept {
+            return subscriptionEpoch_.load(std::memory_order_acquire);
+        }
+        
+        /**
+         * @brief Tipos de evento que recibe este observer
+         */
+        EventMask getSubscriptionMask() const {
+            if (!isActive()) {
+                return 0;
+            }
+            EventMask mask = 0;
+            for (size_t i = 0; i < EVENT_TYPE_COUNT; ++i) {
+                if (handlesEventType(static_cast<EventType>(i))) {
+                    mask |= eventMaskOf(static_cast<EventType>(i));
+                }
+            }
+            return mask;
+        }
+        
         /**
          * @brief Método llamado cuando ocurre un evento
          * @param event El evento que ha ocurrido
          */
         virtual void onEvent(const Event& event) = 0;
         
+        /**
+         * @brief Entrega en lote de los eventos diferidos de un tick
+         * @param events Eventos en el orden en que se emitieron
+         * 
+         * Implementación por defecto: llama a onEvent con cada uno. Los
+         * observers que procesan muchos eventos pueden sobrescribirlo para
+         * hacerlo en una sola pasada.
+         */
+        virtual void onEvents(std::span<const Event> events) {
+            for (const auto& event : events) {
+                onEvent(event);
+            }
+        }
+        
         /**
          * @brief Obtiene un identificador único del observer
          * @return String que identifica únicamente este observer
@@ -36,7 +87,9 @@ namespace noname
          * @return true si maneja este tipo de evento
          * 
          * Implementación por defecto: maneja todos los eventos.
-         * Los observers pueden sobrescribir este método para filtrar eventos.
+         * Los observers pueden sobrescribir este método para filtrar eventos;
+         * si la respuesta cambia después de suscribirse deben llamar a
+         * invalidateSubscriptions().
          */
         virtual bool handlesEventType(EventType eventType) const {
             return true; // Por defecto maneja todos los eventos
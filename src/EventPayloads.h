@@ -0,0 +1,251 @@
+#ifndef __EVENT_PAYLOADS_H__
+#define __EVENT_PAYLOADS_H__
+
+#include "EventTypes.h"
+#include "Skill.h"
+#include <variant>
+#include <string_view>
+#include <type_traits>
+
+namespace noname
+{
+    /*
+     * Datos tipados de cada EventType. Solo contienen enteros y vistas de
+     * texto: construir un evento no reserva memoria. Los nombres apuntan al
+     * nombre de los personajes implicados y son válidos mientras esos
+     * personajes existan y no cambien de nombre; EventQueue guarda su propia
+     * copia de los nombres de los eventos diferidos (ver forEachName).
+     */
+
+    /**
+     * @brief HEALTH_CHANGED, MANA_CHANGED y cambios de propiedades heredables
+     */
+    struct StatChangePayload {
+        int characterId{0};
+        int level{0};
+        int oldValue{0};
+        int newValue{0};
+        std::string_view characterName{};
+    };
+
+    /**
+     * @brief DAMAGE_DEALT (source ataca a target) y DAMAGE_TAKEN (target recibe el daño)
+     */
+    struct DamagePayload {
+        int sourceId{0};
+        int targetId{0};
+        int damage{0};
+        int remainingHealth{0};
+        int sourceLevel{0};
+        bool critical{false};
+        std::string_view sourceName{};
+        std::string_view targetName{};
+    };
+
+    /**
+     * @brief COMBAT_STARTED y COMBAT_ENDED
+     */
+    struct CombatPayload {
+        int attackerId{0};
+        int defenderId{0};
+        int attackerLevel{0};
+        int damage{0};
+        bool hit{false};
+        std::string_view attackerName{};
+        std::string_view defenderName{};
+    };
+
+    /**
+     * @brief EXPERIENCE_GAINED
+     */
+    struct ExperiencePayload {
+        int characterId{0};
+        int level{0};
+        int gained{0};
+        unsigned long long total{0};
+        std::string_view characterName{};
+    };
+
+    /**
+     * @brief LEVEL_UP y MAGIC_LEVEL_UP
+     */
+    struct LevelPayload {
+        int characterId{0};
+        int oldLevel{0};
+        int newLevel{0};
+        std::string_view characterName{};
+    };
+
+    /**
+     * @brief CHARACTER_DIED y CHARACTER_RESPAWNED
+     */
+    struct CharacterPayload {
+        int characterId{0};
+        int level{0};
+        std::string_view characterName{};
+    };
+
+    /**
+     * @brief SKILL_IMPROVED y SKILL_USED
+     */
+    struct SkillPayload {
+        int characterId{0};
+        SkillType skill{SkillType::FIST};
+        int value{0};
+        std::string_view characterName{};
+    };
+
+    /**
+     * @brief Eventos de inventario
+     */
+    struct ItemPayload {
+        int characterId{0};
+        int itemId{0};
+        std::string_view characterName{};
+    };
+
+    using EventPayload = std::variant<std::monostate, StatChangePayload, DamagePayload, CombatPayload,
+                                      ExperiencePayload, LevelPayload, CharacterPayload, SkillPayload, ItemPayload>;
+
+    /**
+     * @brief Tipo de payload asociado a cada EventType (resuelto en compilación)
+     */
+    template<EventType T>
+    struct PayloadFor { using type = std::monostate; };
+
+    template<> struct PayloadFor<EventType::DAMAGE_TAKEN> { using type = DamagePayload; };
+    template<> struct PayloadFor<EventType::DAMAGE_DEALT> { using type = DamagePayload; };
+    template<> struct PayloadFor<EventType::COMBAT_STARTED> { using type = CombatPayload; };
+    template<> struct PayloadFor<EventType::COMBAT_ENDED> { using type = CombatPayload; };
+    template<> struct PayloadFor<EventType::HEALTH_CHANGED> { using type = StatChangePayload; };
+    template<> struct PayloadFor<EventType::MANA_CHANGED> { using type = StatChangePayload; };
+    template<> struct PayloadFor<EventType::EXPERIENCE_GAINED> { using type = ExperiencePayload; };
+    template<> struct PayloadFor<EventType::LEVEL_UP> { using type = LevelPayload; };
+    template<> struct PayloadFor<EventType::MAGIC_LEVEL_UP> { using type = LevelPayload; };
+    template<> struct PayloadFor<EventType::CHARACTER_DIED> { using type = CharacterPayload; };
+    template<> struct PayloadFor<EventType::CHARACTER_RESPAWNED> { using type = CharacterPayload; };
+    template<> struct PayloadFor<EventType::ITEM_EQUIPPED> { using type = ItemPayload; };
+    template<> struct PayloadFor<EventType::ITEM_UNEQUIPPED> { using type = ItemPayload; };
+    template<> struct PayloadFor<EventType::ITEM_PICKED_UP> { using type = ItemPayload; };
+    template<> struct PayloadFor<EventType::ITEM_DROPPED> { using type = ItemPayload; };
+    template<> struct PayloadFor<EventType::SKILL_IMPROVED> { using type = SkillPayload; };
+    template<> struct PayloadFor<EventType::SKILL_USED> { using type = SkillPayload; };
+    template<> struct PayloadFor<EventType::STRENGTH_CHANGED> { using type = StatChangePayload; };
+    template<> struct PayloadFor<EventType::DEXTERITY_CHANGED> { using type = StatChangePayload; };
+    template<> struct PayloadFor<EventType::INTELLIGENCE_CHANGED> { using type = StatChangePayload; };
+    template<> struct PayloadFor<EventType::CONSTITUTION_CHANGED> { using type = StatChangePayload; };
+
+    template<EventType T>
+    using PayloadFor_t = typename PayloadFor<T>::type;
+
+    /*
+     * Vistas de nombre de cada payload, para quien necesite reapuntarlas a
+     * una copia propia. Cada función llama a visit(vista) por cada nombre.
+     */
+    template<typename Visitor>
+    void forEachName(std::monostate&, Visitor&&) {}
+
+    template<typename Visitor>
+    void forEachName(DamagePayload& p, Visitor&& visit) {
+        visit(p.sourceName);
+        visit(p.targetName);
+    }
+
+    template<typename Visitor>
+    void forEachName(CombatPayload& p, Visitor&& visit) {
+        visit(p.attackerName);
+        visit(p.defenderName);
+    }
+
+    template<typename Payload, typename Visitor>
+        requires requires(Payload& p) { p.characterName; }
+    void forEachName(Payload& p, Visitor&& visit) {
+        visit(p.characterName);
+    }
+
+    /*
+     * Tablas de campos para el adaptador de claves de texto (Event::getData).
+     * Cada función llama a visit(clave, valor) con los nombres que usaban los
+     * eventos basados en std::any.
+     */
+    template<typename Visitor>
+    void forEachField(const std::monostate&, EventType, Visitor&&) {}
+
+    template<typename Visitor>
+    void forEachField(const StatChangePayload& p, EventType, Visitor&& visit) {
+        visit("character_name", p.characterName);
+        visit("old_value", p.oldValue);
+        visit("new_value", p.newValue);
+        visit("character_level", p.level);
+        visit("character_id", p.characterId);
+    }
+
+    template<typename Visitor>
+    void forEachField(const DamagePayload& p, EventType type, Visitor&& visit) {
+        visit("damage", p.damage);
+        if (type == EventType::DAMAGE_TAKEN) {
+            visit("character_name", p.targetName);
+            visit("character_id", p.targetId);
+            visit("remaining_health", p.remainingHealth);
+        } else {
+            visit("attacker", p.sourceName);
+            visit("target", p.targetName);
+            visit("attacker_level", p.sourceLevel);
+            visit("attacker_id", p.sourceId);
+            visit("character_id", p.sourceId);
+            visit("critical", p.critical);
+        }
+    }
+
+    template<typename Visitor>
+    void forEachField(const CombatPayload& p, EventType, Visitor&& visit) {
+        visit("attacker", p.attackerName);
+        visit("defender", p.defenderName);
+        visit("attacker_level", p.attackerLevel);
+        visit("attacker_id", p.attackerId);
+        visit("defender_id", p.defenderId);
+        visit("damage", p.damage);
+        visit("hit", p.hit);
+    }
+
+    template<typename Visitor>
+    void forEachField(const ExperiencePayload& p, EventType, Visitor&& visit) {
+        visit("character_name", p.characterName);
+        visit("experience_gained", p.gained);
+        visit("total_experience", p.total);
+        visit("character_level", p.level);
+        visit("character_id", p.characterId);
+    }
+
+    template<typename Visitor>
+    void forEachField(const LevelPayload& p, EventType type, Visitor&& visit) {
+        visit("character_name", p.characterName);
+        visit("old_level", p.oldLevel);
+        visit(type == EventType::MAGIC_LEVEL_UP ? "new_magic_level" : "new_level", p.newLevel);
+        visit("character_id", p.characterId);
+    }
+
+    template<typename Visitor>
+    void forEachField(const CharacterPayload& p, EventType, Visitor&& visit) {
+        visit("character_name", p.characterName);
+        visit("final_level", p.level);
+        visit("character_id", p.characterId);
+    }
+
+    template<typename Visitor>
+    void forEachField(const SkillPayload& p, EventType, Visitor&& visit) {
+        visit("character_name", p.characterName);
+        visit("skill", p.skill);
+        visit("value", p.value);
+        visit("character_id", p.characterId);
+    }
+
+    template<typename Visitor>
+    void forEachField(const ItemPayload& p, EventType, Visitor&& visit) {
+        visit("character_name", p.characterName);
+        visit("item_id", p.itemId);
+        visit("character_id", p.characterId);
+    }
+}
+
+#endif // __EVENT_PAYLOADS_H__
@@ -0,0 +1,267 @@
+#ifndef __EVENT_QUEUE_H__
+#define __EVENT_QUEUE_H__
+
+// System includes
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <span>
+#include <cstdint>
+#include <algorithm>
+
+// Local includes
+#include "Singleton.h"
+#include "Manager.h"
+#include "Event.h"
+#include "EventObserver.h"
+#include "LogManager.h"
+
+// Two-letter acronym for easier access to manager
+#define EQ noname::EventQueue::getInstance()
+
+namespace noname
+{
+    class EventSubject;
+
+    /**
+     * @brief Cola de eventos diferidos del tick actual
+     *
+     * Los subjects en modo diferido no llaman a sus observers al emitir un
+     * evento: lo copian aquí, en el lote del observer que lo recibirá. Al
+     * final del tick flush() entrega a cada observer todos sus eventos en una
+     * única llamada a onEvents(), en el orden en que se emitieron.
+     *
+     * No es thread-safe: se usa desde el bucle del juego.
+     */
+    class EventQueue : public Manager, public Singleton<EventQueue>
+    {
+    private:
+        struct Batch
+        {
+            std::weak_ptr<EventObserver> owner;
+            EventObserver *observer;
+            std::vector<Event> events;
+            std::vector<const EventSubject *> sources; // Paralelo a events
+            // Copias de los nombres de los payloads; un deque no mueve sus
+            // elementos al crecer, así que las vistas de events siguen válidas
+            std::deque<std::string> names;
+        };
+
+        std::vector<Batch> _batches;
+        size_t _lastBatch{0};
+        size_t _pending{0};
+        unsigned long long _delivered{0};
+
+        // Estático para que los subjects puedan consultarlo incluso durante la
+        // destrucción de los singletons
+        static inline std::uint64_t _generation{1};
+
+        Batch &batchFor(const std::weak_ptr<EventObserver> &owner, EventObserver *observer)
+        {
+            // Pocos observers distintos y casi siempre el mismo que la vez anterior.
+            // Un observer nuevo puede ocupar la dirección de otro ya destruido
+            if (_lastBatch < _batches.size() && _batches[_lastBatch].observer == observer &&
+                !_batches[_lastBatch].owner.expired())
+            {
+                return _batches[_lastBatch];
+            }
+            for (size_t i = 0; i < _batches.size(); ++i)
+            {
+                if (_batches[i].observer == observer && !_batches[i].owner.expired())
+                {
+                    _lastBatch = i;
+                    return _batches[i];
+                }
+            }
+            _batches.push_back({owner, observer, {}, {}, {}});
+            _lastBatch = _batches.size() - 1;
+            return _batches.back();
+        }
+
+        void clear()
+        {
+            for (auto &batch : _batches)
+            {
+                batch.events.clear();
+                batch.sources.clear();
+                batch.names.clear();
+            }
+            _pending = 0;
+        }
+
+    public:
+        ~EventQueue() override
+        {
+            ++_generation;
+        }
+
+        void startUp() noexcept override
+        {
+            Manager::setType("EventQueue");
+            LM.writeLog(Level::Debug, "EventQueue::startUp");
+            Manager::startUp();
+        }
+
+        void shutDown() noexcept override
+        {
+            // Los eventos pendientes pueden apuntar a personajes que ya no existen
+            clear();
+            _batches.clear();
+            ++_generation;
+            Manager::shutDown();
+            LM.writeLog(Level::Debug, "EventQueue::shutDown");
+        }
+
+        /**
+         * @brief Guarda una copia del evento para entregarla en el próximo flush()
+         *
+         * Los nombres del payload se copian también: el personaje al que
+         * apuntan puede destruirse o cambiar de nombre antes del flush().
+         */
+        void enqueue(const EventSubject *source, const std::weak_ptr<EventObserver> &owner,
+                     EventObserver *observer, const Event &event)
+        {
+            Batch &batch = batchFor(owner, observer);
+            batch.events.push_back(event);
+            batch.events.back().forEachName([&batch](std::string_view &name)
+                                            { name = batch.names.emplace_back(name); });
+            batch.sources.push_back(source);
+            ++_pending;
+        }
+
+        /**
+         * @brief Entrega los eventos pendientes, un lote por observer
+         * @return Número de eventos entregados
+         *
+         * Los eventos que se emitan durante la entrega quedan para el
+         * siguiente flush().
+         */
+        size_t flush()
+        {
+            if (_pending == 0)
+            {
+                return 0;
+            }
+            ++_generation;
+            _pending = 0;
+
+            // Los observers de mayor prioridad reciben su lote primero
+            std::stable_sort(_batches.begin(), _batches.end(), [](const Batch &a, const Batch &b)
+            {
+                auto lockedA = a.owner.lock();
+                auto lockedB = b.owner.lock();
+                if (!lockedA || !lockedB)
+                {
+                    return lockedA && !lockedB;
+                }
+                return lockedA->getPriority() < lockedB->getPriority();
+            });
+
+            size_t delivered = 0;
+            std::vector<Event> events;
+            std::vector<const EventSubject *> sources;
+            std::deque<std::string> names;
+            // Por índice: onEvents puede añadir lotes nuevos
+            for (size_t i = 0; i < _batches.size(); ++i)
+            {
+                if (_batches[i].events.empty())
+                {
+                    continue;
+                }
+                events.swap(_batches[i].events);
+                sources.swap(_batches[i].sources);
+                names.swap(_batches[i].names);
+                auto owner = _batches[i].owner.lock();
+                if (owner)
+                {
+                    try
+                    {
+                        owner->onEvents(std::span<const Event>(events));
+                        delivered += events.size();
+                    }
+                    catch (const std::exception &e)
+                    {
+                        LM.log<Level::Error>("Observer {} error: {}", [&owner]() { return owner->getObserverId(); }, e.what());
+                    }
+                    catch (...)
+                    {
+                        LM.log<Level::Error>("Observer {} unknown error", [&owner]() { return owner->getObserverId(); });
+                    }
+                }
+                events.clear();
+                sources.clear();
+                names.clear();
+                // Reutilizar la memoria del lote si no llegaron eventos nuevos
+                if (_batches[i].events.empty())
+                {
+                    events.swap(_batches[i].events);
+                    sources.swap(_batches[i].sources);
+                    names.swap(_batches[i].names);
+                }
+            }
+
+            _batches.erase(std::remove_if(_batches.begin(), _batches.end(), [](const Batch &batch)
+                                          { return batch.owner.expired(); }),
+                           _batches.end());
+            _lastBatch = 0;
+            _delivered += delivered;
+            LM.log<Level::Debug>("EventQueue delivered {} deferred events", delivered);
+            return delivered;
+        }
+
+        /**
+         * @brief Descarta los eventos pendientes emitidos por un subject
+         *
+         * Lo llama el subject al destruirse: no se entregan eventos de
+         * subjects que ya no existen.
+         */
+        void discard(const EventSubject *source)
+        {
+            for (auto &batch : _batches)
+            {
+                size_t kept = 0;
+                for (size_t i = 0; i < batch.events.size(); ++i)
+                {
+                    if (batch.sources[i] != source)
+                    {
+                        if (kept != i)
+                        {
+                            batch.events[kept] = std::move(batch.events[i]);
+                            batch.sources[kept] = batch.sources[i];
+                        }
+                        ++kept;
+                    }
+                }
+                _pending -= batch.events.size() - kept;
+                batch.events.erase(batch.events.begin() + static_cast<std::ptrdiff_t>(kept), batch.events.end());
+                batch.sources.resize(kept);
+            }
+        }
+
+        /**
+         * @brief Atribuye a to los eventos pendientes emitidos por from
+         *
+         * Lo llama el subject al moverse, para que destruir el objeto movido
+         * no descarte sus eventos.
+         */
+        void retarget(const EventSubject *from, const EventSubject *to) noexcept
+        {
+            for (auto &batch : _batches)
+            {
+                std::replace(batch.sources.begin(), batch.sources.end(), from, to);
+            }
+        }
+
+        [[nodiscard]] size_t getPendingCount() const noexcept { return _pending; }
+        [[nodiscard]] unsigned long long getDeliveredCount() const noexcept { return _delivered; }
+
+        /**
+         * @brief Cambia en cada flush(): un subject cuya última emisión diferida
+         * es de una generación anterior ya no tiene eventos pendientes
+         */
+        [[nodiscard]] static std::uint64_t getGeneration() noexcept { return _generation; }
+    };
+}
+
+#endif // __EVENT_QUEUE_H__
@@ -2,11 +2,15 @@
 #define __EVENT_SUBJECT_H__
 
 #include "EventObserver.h"
+#include "EventQueue.h"
 #include "LogManager.h"
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <type_traits>
 
 namespace noname
 {
@@ -16,50 +20,205 @@ namespace noname
      * Permite que objetos se suscriban para recibir notificaciones
      * de eventos. Maneja una lista de observers y los notifica cuando
      * ocurren eventos.
+     *
+     * Al suscribir se guarda la máscara de eventos y la prioridad del
+     * observer. Con ellas se construye, solo cuando cambian las
+     * suscripciones, una tabla de despacho con la lista contigua de
+     * observers interesados en cada EventType; notificar recorre únicamente
+     * esa lista, sin copiar vectores ni bloquear weak_ptr.
      */
     class EventSubject {
     private:
-        std::vector<std::weak_ptr<EventObserver>> observers_;
-        bool notificationInProgress_;
+        struct Subscription {
+            std::weak_ptr<EventObserver> observer;
+            EventObserver* raw;
+            EventMask mask;
+            int priority;
+        };
+        
+        struct DispatchEntry {
+            EventObserver* observer;
+            std::weak_ptr<EventObserver> owner; // Se bloquea al notificar: lo mantiene vivo durante la llamada
+        };
+        
+        struct DispatchTable {
+            std::vector<DispatchEntry> entries;                   // Agrupadas por EventType
+            std::array<std::uint32_t, EVENT_TYPE_COUNT + 1> offsets{};
+            EventMask mask{0};                                    // Tipos con al menos un observer
+            std::uint64_t epoch{0};
+            bool dirty{true};
+        };
+        
+        // Ordenadas por prioridad (estable en caso de empate). Mutables porque
+        // las consultas const también pueden reconstruir la tabla.
+        mutable std::vector<Subscription> subscriptions_;
+        // Solo existe si hay suscripciones: los subjects sin observers (casi
+        // todas las criaturas) no pagan por las tablas.
+        mutable std::unique_ptr<DispatchTable> dispatch_;
+        int notificationDepth_{0};
+        
+        // Modo diferido: los eventos esperan en EventQueue hasta el final del tick
+        bool deferred_{false};
+        std::uint64_t pendingGeneration_{0};
+        
+        void markDirty() {
+            if (subscriptions_.empty()) {
+                if (notificationDepth_ == 0) {
+                    dispatch_.reset();
+                } else if (dispatch_) {
+                    dispatch_->dirty = true;
+                }
+                return;
+            }
+            if (!dispatch_) {
+                dispatch_ = std::make_unique<DispatchTable>();
+            }
+            dispatch_->dirty = true;
+        }
         
         /**
-         * @brief Limpia observers que ya no existen (weak_ptr expirados)
+         * @brief Reconstruye la tabla si cambiaron las suscripciones o algún observer
+         *
+         * No se reconstruye durante una notificación para no invalidar la
+         * lista que se está recorriendo.
          */
-        void cleanupObservers() {
-            if (notificationInProgress_) {
-                return; // No limpiar durante notificación para evitar problemas
+        const DispatchTable* dispatchTable() const {
+            if (!dispatch_) {
+                return nullptr;
+            }
+            auto epoch = EventObserver::getSubscriptionEpoch();
+            if ((dispatch_->dirty || dispatch_->epoch != epoch) && notificationDepth_ == 0) {
+                rebuildDispatchTable(epoch);
+            }
+            return dispatch_.get();
+        }
+        
+        void rebuildDispatchTable(std::uint64_t epoch) const {
+            // Quitar observers expirados y releer máscaras si algún observer cambió
+            const bool refresh = dispatch_->epoch != epoch;
+            subscriptions_.erase(
+                std::remove_if(subscriptions_.begin(), subscriptions_.end(),
+                    [](const Subscription& sub) { return sub.observer.expired(); }),
+                subscriptions_.end());
+            if (refresh) {
+                for (auto& sub : subscriptions_) {
+                    sub.mask = sub.raw->getSubscriptionMask();
+                    sub.priority = sub.raw->getPriority();
+                }
+                sortSubscriptionsByPriority();
             }
             
-            observers_.erase(
-                std::remove_if(observers_.begin(), observers_.end(),
-                    [](const std::weak_ptr<EventObserver>& obs) {
-                        return obs.expired();
-                    }),
-                observers_.end()
-            );
-        }
-        
-        /**
-         * @brief Ordena observers por prioridad
-         */
-        void sortObserversByPriority() {
-            std::sort(observers_.begin(), observers_.end(),
-                [](const std::weak_ptr<EventObserver>& a, const std::weak_ptr<EventObserver>& b) {
-                    auto lockedA = a.lock();
-                    auto lockedB = b.lock();
-                    
-                    if (!lockedA && !lockedB) return false;
-                    if (!lockedA) return false; // B tiene prioridad
-                    if (!lockedB) return true;  // A tiene prioridad
-                    
-                    return lockedA->getPriority() < lockedB->getPriority();
+            auto& table = *dispatch_;
+            table.entries.clear();
+            table.mask = 0;
+            for (size_t type = 0; type < EVENT_TYPE_COUNT; ++type) {
+                table.offsets[type] = static_cast<std::uint32_t>(table.entries.size());
+                const auto bit = eventMaskOf(static_cast<EventType>(type));
+                for (const auto& sub : subscriptions_) {
+                    if (sub.mask & bit) {
+                        table.entries.push_back({sub.raw, sub.observer});
+                        table.mask |= bit;
+                    }
+                }
+            }
+            table.offsets[EVENT_TYPE_COUNT] = static_cast<std::uint32_t>(table.entries.size());
+            table.epoch = epoch;
+            table.dirty = false;
+        }
+        
+        /**
+         * @brief Ordena observers por prioridad (solo al releer todas las prioridades)
+         */
+        void sortSubscriptionsByPriority() const {
+            std::stable_sort(subscriptions_.begin(), subscriptions_.end(),
+                [](const Subscription& a, const Subscription& b) {
+                    return a.priority < b.priority;
+                });
+        }
+        
+        void adoptPendingEvents(EventSubject& other) noexcept {
+            if (other.pendingGeneration_ != 0 && other.pendingGeneration_ == EventQueue::getGeneration()) {
+                EQ.retarget(&other, this);
+                pendingGeneration_ = other.pendingGeneration_;
+            }
+            other.pendingGeneration_ = 0;
+        }
+        
+        std::vector<Subscription>::iterator findSubscription(const EventObserver* observer) {
+            return std::find_if(subscriptions_.begin(), subscriptions_.end(),
+                [observer](const Subscription& sub) {
+                    return sub.raw == observer && !sub.observer.expired();
                 });
         }
         
     public:
-        EventSubject() : notificationInProgress_(false) {}
+        EventSubject() = default;
+        
+        EventSubject(const EventSubject& other) : subscriptions_(other.subscriptions_), deferred_(other.deferred_) {
+            markDirty();
+        }
+        
+        EventSubject& operator=(const EventSubject& other) {
+            if (this != &other) {
+                subscriptions_ = other.subscriptions_;
+                deferred_ = other.deferred_;
+                markDirty();
+            }
+            return *this;
+        }
+        
+        /**
+         * @brief Mueve suscripciones y eventos diferidos pendientes
+         *
+         * Los eventos que el origen tenía en EventQueue pasan a este subject,
+         * así que destruir el objeto movido no los descarta.
+         */
+        EventSubject(EventSubject&& other) noexcept
+            : subscriptions_(std::move(other.subscriptions_)), dispatch_(std::move(other.dispatch_)),
+              deferred_(other.deferred_) {
+            adoptPendingEvents(other);
+        }
+        
+        EventSubject& operator=(EventSubject&& other) noexcept {
+            if (this != &other) {
+                discardPendingEvents();
+                subscriptions_ = std::move(other.subscriptions_);
+                dispatch_ = std::move(other.dispatch_);
+                deferred_ = other.deferred_;
+                adoptPendingEvents(other);
+            }
+            return *this;
+        }
+        
+        virtual ~EventSubject() {
+            discardPendingEvents();
+        }
+        
+        /**
+         * @brief Activa el modo diferido
+         * 
+         * En modo diferido notifyObservers solo encola el evento en EventQueue
+         * para cada observer interesado; se entregan en lote con EQ.flush()
+         * al final del tick. Los eventos pendientes de un subject se descartan
+         * si este se destruye antes del flush.
+         */
+        void setDeferredNotifications(bool deferred) {
+            deferred_ = deferred;
+        }
         
-        virtual ~EventSubject() = default;
+        bool isDeferredNotifications() const {
+            return deferred_;
+        }
+        
+        /**
+         * @brief Quita de EventQueue los eventos que este subject aún no ha entregado
+         */
+        void discardPendingEvents() {
+            if (pendingGeneration_ != 0 && pendingGeneration_ == EventQueue::getGeneration()) {
+                EQ.discard(this);
+            }
+            pendingGeneration_ = 0;
+        }
         
         /**
          * @brief Suscribe un observer para recibir eventos
@@ -67,24 +226,24 @@ namespace noname
          */
         void subscribe(std::shared_ptr<EventObserver> observer) {
             if (!observer) {
-                LM.writeLog(Level::Warning, "Attempted to subscribe null observer");
+                LM.log<Level::Warning>("Attempted to subscribe null observer");
                 return;
             }
             
             // Verificar que no esté ya suscrito
-            for (const auto& existingObs : observers_) {
-                if (auto locked = existingObs.lock()) {
-                    if (locked.get() == observer.get()) {
-                        LM.writeLog(Level::Debug, "Observer " + observer->getObserverId() + " already subscribed");
-                        return;
-                    }
-                }
+            if (findSubscription(observer.get()) != subscriptions_.end()) {
+                LM.log<Level::Debug>("Observer {} already subscribed", [&observer]() { return observer->getObserverId(); });
+                return;
             }
             
-            observers_.push_back(observer);
-            sortObserversByPriority();
+            // Insertar en su posición por prioridad, detrás de los de igual prioridad
+            Subscription sub{observer, observer.get(), observer->getSubscriptionMask(), observer->getPriority()};
+            auto position = std::upper_bound(subscriptions_.begin(), subscriptions_.end(), sub.priority,
+                [](int priority, const Subscription& existing) { return priority < existing.priority; });
+            subscriptions_.insert(position, std::move(sub));
+            markDirty();
             
-            LM.writeLog(Level::Debug, "Observer " + observer->getObserverId() + " subscribed");
+            LM.log<Level::Debug>("Observer {} subscribed", [&observer]() { return observer->getObserverId(); });
         }
         
         /**
@@ -96,85 +255,143 @@ namespace noname
                 return;
             }
             
-            auto removed = std::remove_if(observers_.begin(), observers_.end(),
-                [&observer](const std::weak_ptr<EventObserver>& obs) {
-                    auto locked = obs.lock();
-                    return !locked || locked.get() == observer.get();
+            auto removed = std::remove_if(subscriptions_.begin(), subscriptions_.end(),
+                [&observer](const Subscription& sub) {
+                    return sub.observer.expired() || sub.raw == observer.get();
                 });
             
-            bool wasRemoved = (removed != observers_.end());
-            observers_.erase(removed, observers_.end());
+            bool wasRemoved = (removed != subscriptions_.end());
+            subscriptions_.erase(removed, subscriptions_.end());
             
             if (wasRemoved) {
-                LM.writeLog(Level::Debug, "Observer " + observer->getObserverId() + " unsubscribed");
+                markDirty();
+                LM.log<Level::Debug>("Observer {} unsubscribed", [&observer]() { return observer->getObserverId(); });
             }
         }
         
+        /**
+         * @brief Vuelve a leer la máscara y la prioridad de todos los observers
+         *
+         * Normalmente no hace falta: los observers que cambian llaman a
+         * EventObserver::invalidateSubscriptions().
+         */
+        void refreshSubscriptions() {
+            if (!dispatch_) {
+                return;
+            }
+            dispatch_->epoch = ~std::uint64_t{0};
+            dispatch_->dirty = true;
+        }
+        
         /**
          * @brief Desuscribe todos los observers
          */
         void unsubscribeAll() {
-            size_t count = observers_.size();
-            observers_.clear();
-            LM.writeLog(Level::Debug, "All observers unsubscribed (" + std::to_string(count) + " removed)");
+            size_t count = subscriptions_.size();
+            subscriptions_.clear();
+            markDirty();
+            LM.log<Level::Debug>("All observers unsubscribed ({} removed)", count);
         }
         
         /**
-         * @brief Notifica a todos los observers sobre un evento
+         * @brief Notifica a los observers suscritos al tipo del evento
          * @param event Evento a notificar
          */
         void notifyObservers(const Event& event) {
-            notificationInProgress_ = true;
+            const DispatchTable* table = dispatchTable();
+            if (!table) {
+                return;
+            }
+            const auto type = static_cast<size_t>(event.getType());
+            const std::uint32_t begin = table->offsets[type];
+            const std::uint32_t end = table->offsets[type + 1];
+            if (begin == end) {
+                return;
+            }
             
-            // Crear una copia de la lista para evitar problemas si se modifican observers durante notificación
-            auto observersCopy = observers_;
+            if (deferred_) {
+                for (std::uint32_t i = begin; i < end; ++i) {
+                    const DispatchEntry& entry = table->entries[i];
+                    if (auto obs = entry.owner.lock()) {
+                        EQ.enqueue(this, entry.owner, obs.get(), event);
+                    }
+                }
+                pendingGeneration_ = EventQueue::getGeneration();
+                return;
+            }
+            
+            ++notificationDepth_;
             
             int notifiedCount = 0;
             int errorCount = 0;
             
-            for (auto& weakObs : observersCopy) {
-                if (auto obs = weakObs.lock()) {
-                    // Verificar si el observer está activo y maneja este tipo de evento
-                    if (!obs->isActive() || !obs->handlesEventType(event.getType())) {
-                        continue;
-                    }
-                    
-                    try {
-                        obs->onEvent(event);
-                        notifiedCount++;
-                    } catch (const std::exception& e) {
-                        errorCount++;
-                        LM.writeLog(Level::Error, 
-                            "Observer " + obs->getObserverId() + " error: " + std::string(e.what()));
-                    } catch (...) {
-                        errorCount++;
-                        LM.writeLog(Level::Error, 
-                            "Observer " + obs->getObserverId() + " unknown error");
-                    }
+            // Por índice: si un observer provoca una notificación anidada, la
+            // tabla no se reconstruye hasta que termine esta
+            for (std::uint32_t i = begin; i < end; ++i) {
+                // Una referencia propia: si el callback suelta el último shared_ptr
+                // de este observer (o de otro posterior), sigue vivo hasta volver
+                auto obs = table->entries[i].owner.lock();
+                if (!obs) {
+                    continue;
+                }
+                
+                try {
+                    obs->onEvent(event);
+                    notifiedCount++;
+                } catch (const std::exception& e) {
+                    errorCount++;
+                    LM.log<Level::Error>("Observer {} error: {}", [&obs]() { return obs->getObserverId(); }, e.what());
+                } catch (...) {
+                    errorCount++;
+                    LM.log<Level::Error>("Observer {} unknown error", [&obs]() { return obs->getObserverId(); });
                 }
             }
             
-            notificationInProgress_ = false;
-            
-            // Limpiar observers expirados después de la notificación
-            cleanupObservers();
+            --notificationDepth_;
             
             if (notifiedCount > 0 || errorCount > 0) {
-                LM.writeLog(Level::Debug, 
-                    "Event " + std::string(eventTypeToString(event.getType())) + 
-                    " notified to " + std::to_string(notifiedCount) + " observers" +
-                    (errorCount > 0 ? " (" + std::to_string(errorCount) + " errors)" : ""));
+                if (errorCount > 0) {
+                    LM.log<Level::Debug>("Event {} notified to {} observers ({} errors)",
+                                         eventTypeToString(event.getType()), notifiedCount, errorCount);
+                } else {
+                    LM.log<Level::Debug>("Event {} notified to {} observers",
+                                         eventTypeToString(event.getType()), notifiedCount);
+                }
             }
         }
         
+        /**
+         * @brief Notifica un evento que solo se construye si alguien lo escucha
+         * @param type Tipo del evento que devolverá factory
+         * @param factory Invocable sin argumentos que devuelve el Event
+         */
+        template<typename Factory>
+            requires std::is_invocable_r_v<Event, Factory&>
+        void notifyObservers(EventType type, Factory&& factory) {
+            if (wantsEvent(type)) {
+                notifyObservers(factory());
+            }
+        }
+        
+        /**
+         * @brief Indica si algún observer suscrito maneja este tipo de evento
+         *
+         * Consulta la máscara de la tabla de despacho: sin suscripciones no
+         * hay tabla y la respuesta es una comparación con nullptr.
+         */
+        bool wantsEvent(EventType type) const {
+            const DispatchTable* table = dispatchTable();
+            return table && (table->mask & eventMaskOf(type)) != 0;
+        }
+        
         /**
          * @brief Obtiene el número de observers activos
          * @return Número de observers que no han expirado
          */
         size_t getObserverCount() const {
-            return std::count_if(observers_.begin(), observers_.end(),
-                [](const std::weak_ptr<EventObserver>& obs) {
-                    return !obs.expired();
+            return std::count_if(subscriptions_.begin(), subscriptions_.end(),
+                [](const Subscription& sub) {
+                    return !sub.observer.expired();
                 });
         }
         
@@ -184,11 +401,14 @@ namespace noname
          * @return Número de observers que manejan este tipo de evento
          */
         size_t getObserverCountForEventType(EventType eventType) const {
-            return std::count_if(observers_.begin(), observers_.end(),
-                [eventType](const std::weak_ptr<EventObserver>& obs) {
-                    auto locked = obs.lock();
-                    return locked && locked->isActive() && locked->handlesEventType(eventType);
-                });
+            const DispatchTable* table = dispatchTable();
+            if (!table) {
+                return 0;
+            }
+            const auto type = static_cast<size_t>(eventType);
+            return std::count_if(table->entries.begin() + table->offsets[type],
+                                 table->entries.begin() + table->offsets[type + 1],
+                [](const DispatchEntry& entry) { return !entry.owner.expired(); });
         }
         
         /**
@@ -197,8 +417,8 @@ namespace noname
          */
         std::vector<std::string> getObserverIds() const {
             std::vector<std::string> ids;
-            for (const auto& weakObs : observers_) {
-                if (auto obs = weakObs.lock()) {
+            for (const auto& sub : subscriptions_) {
+                if (auto obs = sub.observer.lock()) {
                     ids.push_back(obs->getObserverId());
                 }
             }
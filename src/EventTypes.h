@@ -1,6 +1,9 @@
 #ifndef __EVENT_TYPES_H__
 #define __EVENT_TYPES_H__
 
+#include <cstddef>
+#include <cstdint>
+
 namespace noname
 {
     /**
@@ -46,6 +49,18 @@ namespace noname
         CONSTITUTION_CHANGED
     };
     
+    inline constexpr size_t EVENT_TYPE_COUNT = static_cast<size_t>(EventType::CONSTITUTION_CHANGED) + 1;
+    
+    /**
+     * @brief Conjunto de EventTypes, un bit por tipo
+     */
+    using EventMask = std::uint32_t;
+    static_assert(EVENT_TYPE_COUNT <= sizeof(EventMask) * 8, "EventMask too small for EventType");
+    
+    constexpr EventMask eventMaskOf(EventType type) {
+        return EventMask{1} << static_cast<unsigned>(type);
+    }
+    
     /**
      * @brief Convierte un EventType a string para logging
      */
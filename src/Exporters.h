@@ -0,0 +1,181 @@
+#ifndef __EXPORTERS_H__
+#define __EXPORTERS_H__
+
+// System includes
+#include <array>
+#include <span>
+#include <string_view>
+#include <ostream>
+
+// Local includes
+#include "TableWriter.h"
+#include "Ranking.h"
+#include "Character.h"
+#include "CharacterStore.h"
+#include "Heritables.h"
+#include "ItemEnumTypes.h"
+#include "PopulationStats.h"
+
+namespace noname
+{
+    // Columnas de cada exportación, en el orden en que se escriben
+
+    inline constexpr std::array<std::string_view, 4> RANKING_COLUMNS{"rank", "player_id", "level", "skill"};
+
+    inline constexpr std::array<std::string_view, 19> CHARACTER_STATS_COLUMNS{
+        "id", "health", "max_health", "mana", "max_mana",
+        "experience", "next_level_experience", "magic_experience", "next_magic_level_experience",
+        "capacity", "max_capacity", "speed_base", "speed",
+        "fist", "sword", "axe", "club", "distance", "shielding"};
+
+    inline constexpr std::array<std::string_view, 10> CHARACTER_PROFILE_COLUMNS{
+        "id", "name", "level", "magic_level",
+        "strength", "dextery", "constitution", "intelligence", "charisma", "good_looking"};
+
+    inline constexpr std::array<std::string_view, 6> INVENTORY_COLUMNS{
+        "character_id", "slot", "item_id", "item_name", "item_type", "weight"};
+
+    inline constexpr std::array<std::string_view, 12> POPULATION_STATS_COLUMNS{
+        "group", "attribute", "count", "mean", "stddev", "min", "p25", "p50", "p75", "p90", "p99", "max"};
+
+    static_assert(CharacterStore::MAX_SKILLS == 6, "CHARACTER_STATS_COLUMNS lists one column per skill");
+    static_assert(static_cast<size_t>(HeritableType::LAST_HERITABLE) == 6, "CHARACTER_PROFILE_COLUMNS lists one column per heritable");
+
+    /**
+     * @brief Filas de una instantánea de ranking
+     * @return Número de filas escritas
+     */
+    inline size_t exportRanking(const RankingSnapshot &snapshot, std::ostream &out, ExportFormat format)
+    {
+        TableWriter writer{out, format, RANKING_COLUMNS};
+        const auto &rows = snapshot.getRanking();
+        for (size_t position = 0; position < rows.size(); ++position)
+        {
+            writer.beginRow().field(position + 1).field(rows[position].playerId).field(rows[position].level).field(rows[position].skill).endRow();
+        }
+        return writer.getRowCount();
+    }
+
+    /**
+     * @brief Estadísticas de todas las filas vivas del almacén
+     *
+     * Recorre las columnas del almacén en orden de slot, sin pasar por los
+     * objetos Character. Se cruza con exportCharacterProfiles por el id.
+     */
+    inline size_t exportCharacterStats(const CharacterStore &store, std::ostream &out, ExportFormat format)
+    {
+        TableWriter writer{out, format, CHARACTER_STATS_COLUMNS};
+        const auto &ids = store.ids();
+        const auto &health = store.healthColumn();
+        const auto &mana = store.manaColumn();
+        const auto &experience = store.experienceColumn();
+        const auto &magicExperience = store.magicExperienceColumn();
+        const auto &capacity = store.capacityColumn();
+        const auto &speed = store.speedColumn();
+        const auto &skills = store.skillsColumn();
+        for (CharacterStore::Slot slot = 0; slot < store.size(); ++slot)
+        {
+            if (!store.isLive(slot))
+            {
+                continue;
+            }
+            writer.beginRow()
+                .field(ids[slot])
+                .field(health[slot].current)
+                .field(health[slot].maximum)
+                .field(mana[slot].current)
+                .field(mana[slot].maximum)
+                .field(experience[slot].current)
+                .field(experience[slot].nextLevel)
+                .field(magicExperience[slot].current)
+                .field(magicExperience[slot].nextLevel)
+                .field(capacity[slot].current)
+                .field(capacity[slot].maximum)
+                .field(speed[slot].base)
+                .field(speed[slot].current);
+            for (short skill : skills[slot])
+            {
+                writer.field(skill);
+            }
+            writer.endRow();
+        }
+        return writer.getRowCount();
+    }
+
+    /**
+     * @brief Nombre, niveles y heritables de los personajes
+     */
+    inline size_t exportCharacterProfiles(std::span<const Character *const> characters, std::ostream &out, ExportFormat format)
+    {
+        TableWriter writer{out, format, CHARACTER_PROFILE_COLUMNS};
+        for (const Character *character : characters)
+        {
+            writer.beginRow().field(character->getId()).field(character->getNameView()).field(character->getLevel()).field(character->getMagicLevel());
+            for (int heritable = 0; heritable < static_cast<int>(HeritableType::LAST_HERITABLE); ++heritable)
+            {
+                writer.field(character->getHeritable(static_cast<HeritableType>(heritable)));
+            }
+            writer.endRow();
+        }
+        return writer.getRowCount();
+    }
+
+    /**
+     * @brief Una fila por cada slot ocupado del inventario de cada personaje
+     */
+    inline size_t exportInventories(std::span<const Character *const> characters, std::ostream &out, ExportFormat format)
+    {
+        TableWriter writer{out, format, INVENTORY_COLUMNS};
+        for (const Character *character : characters)
+        {
+            const auto &slots = character->getInventorySlots();
+            for (size_t slot = 0; slot < slots.size(); ++slot)
+            {
+                const auto &item = slots[slot];
+                if (!item)
+                {
+                    continue;
+                }
+                writer.beginRow()
+                    .field(character->getId())
+                    .field(ItemSlotTypeToString(static_cast<ItemSlotType>(slot)))
+                    .field(item->getId())
+                    .field(item->getName())
+                    .field(ItemTypeToString(item->getItemType()))
+                    .field(item->getWeight())
+                    .endRow();
+            }
+        }
+        return writer.getRowCount();
+    }
+
+    /**
+     * @brief Una fila por heritable y por skill con sus estadísticas de población
+     *
+     * Los cuantiles necesitan el histograma: sin él salen iguales a min.
+     */
+    inline size_t exportPopulationStats(const PopulationReport &report, std::ostream &out, ExportFormat format)
+    {
+        TableWriter writer{out, format, POPULATION_STATS_COLUMNS};
+        auto writeRow = [&writer](std::string_view group, std::string_view attribute, const AttributeStats &stats)
+        {
+            writer.beginRow().field(group).field(attribute).field(stats.count).field(stats.mean()).field(stats.stddev()).field(stats.min);
+            for (double q : {0.25, 0.5, 0.75, 0.9, 0.99})
+            {
+                writer.field(stats.quantile(q));
+            }
+            writer.field(stats.max).endRow();
+        };
+        for (size_t heritable = 0; heritable < report.heritables.size(); ++heritable)
+        {
+            writeRow("heritable", HeritableToString(static_cast<HeritableType>(heritable)), report.heritables[heritable]);
+        }
+        for (size_t skill = 0; skill < report.skills.size(); ++skill)
+        {
+            writeRow("skill", toLogString(static_cast<SkillType>(skill)), report.skills[skill]);
+        }
+        return writer.getRowCount();
+    }
+}
+
+#endif // __EXPORTERS_H__
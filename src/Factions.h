@@ -0,0 +1,361 @@
+#ifndef __FACTIONS_H__
+#define __FACTIONS_H__
+
+// System includes
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <utility>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+// Local includes
+#include "FlatIdMap.h"
+#include "Relationships.h"
+
+namespace noname
+{
+    /**
+     * @brief Facciones, alianzas entre facciones y hostilidades
+     *
+     * Cada entidad (id de personaje) pertenece como mucho a una facción. Las
+     * facciones se agrupan en alianzas con un union-find; tras cada cambio se
+     * aplana en un array facción -> alianza, de modo que consultar no modifica
+     * nada. Las hostilidades son una matriz de bits facción x facción,
+     * simétrica, con una fila de palabras de 64 bits por facción.
+     *
+     * mayAttack() cuesta dos búsquedas en un FlatIdMap, una comparación y la
+     * lectura de un bit. Los aliados nunca son hostiles, aunque su bit esté
+     * puesto: al romper la alianza la hostilidad anterior vuelve a valer.
+     *
+     * Las facciones que no existen (NO_FACTION o ids que addFaction() no ha
+     * dado) se ignoran al modificar; al consultar no tienen alianza ni
+     * relación con nadie.
+     */
+    class Factions
+    {
+    public:
+        using FactionId = std::uint16_t;
+        static constexpr FactionId NO_FACTION = std::numeric_limits<FactionId>::max();
+
+    private:
+        std::vector<std::string> _names;
+        std::vector<FactionId> _parents; // Union-find de alianzas
+        std::vector<FactionId> _alliances; // Raíz de cada facción, aplanada
+        std::vector<std::uint64_t> _hostility;
+        size_t _rowWords{0};
+        FlatIdMap<FactionId> _members;
+
+        [[nodiscard]] bool exists(FactionId faction) const noexcept { return faction < _names.size(); }
+
+        FactionId findRoot(FactionId faction) noexcept
+        {
+            while (_parents[faction] != faction)
+            {
+                _parents[faction] = _parents[_parents[faction]]; // Compresión a la mitad
+                faction = _parents[faction];
+            }
+            return faction;
+        }
+
+        void unite(FactionId a, FactionId b) noexcept
+        {
+            if (!exists(a) || !exists(b))
+            {
+                return;
+            }
+            a = findRoot(a);
+            b = findRoot(b);
+            if (a != b)
+            {
+                // La raíz es siempre la facción de menor id: alianzas estables al reconstruirlas
+                _parents[std::max(a, b)] = std::min(a, b);
+            }
+        }
+
+        void flatten() noexcept
+        {
+            for (FactionId faction = 0; faction < _parents.size(); ++faction)
+            {
+                _alliances[faction] = findRoot(faction);
+            }
+        }
+
+        void growMatrix(size_t factions)
+        {
+            const size_t words = (factions + 63) / 64;
+            if (words <= _rowWords)
+            {
+                return;
+            }
+            std::vector<std::uint64_t> grown(words * 64 * words, 0);
+            for (size_t row = 0; row < _rowWords * 64; ++row)
+            {
+                std::copy_n(_hostility.begin() + static_cast<std::ptrdiff_t>(row * _rowWords), _rowWords,
+                            grown.begin() + static_cast<std::ptrdiff_t>(row * words));
+            }
+            _hostility.swap(grown);
+            _rowWords = words;
+        }
+
+        void setBit(FactionId row, FactionId column, bool value) noexcept
+        {
+            std::uint64_t &word = _hostility[row * _rowWords + column / 64];
+            const std::uint64_t mask = std::uint64_t{1} << (column % 64);
+            word = value ? word | mask : word & ~mask;
+        }
+
+        [[nodiscard]] bool bit(FactionId row, FactionId column) const noexcept
+        {
+            return (_hostility[row * _rowWords + column / 64] >> (column % 64)) & 1;
+        }
+
+    public:
+        /**
+         * @brief Crea una facción, sin aliados ni enemigos
+         * @throws std::length_error si ya no quedan FactionId libres (NO_FACTION
+         * no puede ser una facción)
+         */
+        FactionId addFaction(std::string_view name)
+        {
+            if (_names.size() >= NO_FACTION)
+            {
+                throw std::length_error("Factions: no FactionId left for " + std::string(name));
+            }
+            const auto faction = static_cast<FactionId>(_names.size());
+            _names.emplace_back(name);
+            _parents.push_back(faction);
+            _alliances.push_back(faction);
+            growMatrix(_names.size());
+            return faction;
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return _names.size(); }
+        [[nodiscard]] std::string_view getName(FactionId faction) const noexcept { return _names[faction]; }
+
+        [[nodiscard]] FactionId findFaction(std::string_view name) const noexcept
+        {
+            auto found = std::find(_names.begin(), _names.end(), name);
+            return found == _names.end() ? NO_FACTION : static_cast<FactionId>(found - _names.begin());
+        }
+
+        // Pertenencia de las entidades
+
+        /**
+         * @brief La entidad id pasa a la facción faction
+         * @return false, sin cambiar nada, si la facción no existe
+         */
+        bool join(int id, FactionId faction)
+        {
+            if (!exists(faction))
+            {
+                return false;
+            }
+            _members.tryEmplace(id, faction).first = faction;
+            return true;
+        }
+
+        bool leave(int id) noexcept { return _members.erase(id); }
+
+        /**
+         * @brief La entidad to pasa a la facción de from (por ejemplo, una copia de una criatura)
+         */
+        void copyMembership(int from, int to)
+        {
+            if (const FactionId *faction = _members.find(from))
+            {
+                join(to, *faction);
+            }
+        }
+
+        [[nodiscard]] FactionId getFaction(int id) const noexcept
+        {
+            const FactionId *faction = _members.find(id);
+            return faction ? *faction : NO_FACTION;
+        }
+
+        // Alianzas
+
+        /**
+         * @brief Une las alianzas de cada pareja de facciones
+         */
+        void mergeAlliances(std::span<const std::pair<FactionId, FactionId>> pairs)
+        {
+            for (const auto &[a, b] : pairs)
+            {
+                unite(a, b);
+            }
+            flatten();
+        }
+
+        void ally(FactionId a, FactionId b)
+        {
+            const std::pair<FactionId, FactionId> pair{a, b};
+            mergeAlliances({&pair, 1});
+        }
+
+        /**
+         * @brief Saca a cada facción de su alianza; el resto de cada alianza sigue unido
+         *
+         * El union-find no sabe deshacer uniones: se reconstruye a partir de las
+         * alianzas actuales sin las facciones que salen, en O(facciones).
+         */
+        void splitAlliances(std::span<const FactionId> leaving)
+        {
+            std::vector<std::uint8_t> leaves(_names.size(), 0);
+            for (FactionId faction : leaving)
+            {
+                if (exists(faction))
+                {
+                    leaves[faction] = 1;
+                }
+            }
+            // Primer miembro que se queda en cada alianza antigua
+            std::vector<FactionId> anchor(_names.size(), NO_FACTION);
+            std::iota(_parents.begin(), _parents.end(), FactionId{0});
+            for (FactionId faction = 0; faction < _names.size(); ++faction)
+            {
+                if (leaves[faction])
+                {
+                    continue;
+                }
+                FactionId &first = anchor[_alliances[faction]];
+                if (first == NO_FACTION)
+                {
+                    first = faction;
+                }
+                else
+                {
+                    unite(first, faction);
+                }
+            }
+            flatten();
+        }
+
+        void leaveAlliance(FactionId faction)
+        {
+            splitAlliances({&faction, 1});
+        }
+
+        [[nodiscard]] FactionId getAlliance(FactionId faction) const noexcept
+        {
+            return exists(faction) ? _alliances[faction] : NO_FACTION;
+        }
+
+        [[nodiscard]] bool areAllied(FactionId a, FactionId b) const noexcept
+        {
+            return exists(a) && exists(b) && _alliances[a] == _alliances[b];
+        }
+
+        // Hostilidades
+
+        /**
+         * @brief Marca a y b como hostiles (o no); ignora las facciones que no existen
+         */
+        void setHostile(FactionId a, FactionId b, bool hostile = true) noexcept
+        {
+            if (!exists(a) || !exists(b))
+            {
+                return;
+            }
+            setBit(a, b, hostile);
+            setBit(b, a, hostile);
+        }
+
+        /**
+         * @brief Declara hostiles entre sí a todas las facciones de dos alianzas
+         */
+        void declareWar(FactionId a, FactionId b, bool hostile = true) noexcept
+        {
+            if (!exists(a) || !exists(b))
+            {
+                return;
+            }
+            const FactionId first = _alliances[a], second = _alliances[b];
+            for (FactionId x = 0; x < _names.size(); ++x)
+            {
+                if (_alliances[x] != first)
+                {
+                    continue;
+                }
+                for (FactionId y = 0; y < _names.size(); ++y)
+                {
+                    if (_alliances[y] == second)
+                    {
+                        setHostile(x, y, hostile);
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] bool areHostile(FactionId a, FactionId b) const noexcept
+        {
+            return exists(a) && exists(b) && _alliances[a] != _alliances[b] && bit(a, b);
+        }
+
+        [[nodiscard]] Relationship getRelationship(FactionId a, FactionId b) const noexcept
+        {
+            if (!exists(a) || !exists(b))
+            {
+                return Relationship::NEUTRAL;
+            }
+            if (_alliances[a] == _alliances[b])
+            {
+                return Relationship::FRIEND;
+            }
+            return bit(a, b) ? Relationship::ENEMY : Relationship::NEUTRAL;
+        }
+
+        /**
+         * @brief Si la entidad attacker puede atacar a target
+         *
+         * Solo entre facciones hostiles; las entidades sin facción no atacan
+         * ni son atacadas.
+         */
+        [[nodiscard]] bool mayAttack(int attacker, int target) const noexcept
+        {
+            const FactionId a = getFaction(attacker);
+            const FactionId b = getFaction(target);
+            return a != NO_FACTION && b != NO_FACTION && areHostile(a, b);
+        }
+
+        /**
+         * @brief Deja en out los candidatos que attacker puede atacar
+         */
+        void filterTargets(int attacker, std::span<const int> candidates, std::vector<int> &out) const
+        {
+            out.clear();
+            const FactionId a = getFaction(attacker);
+            if (a == NO_FACTION)
+            {
+                return;
+            }
+            const std::uint64_t *row = _hostility.data() + a * _rowWords;
+            for (int candidate : candidates)
+            {
+                const FactionId b = getFaction(candidate);
+                if (b != NO_FACTION && _alliances[a] != _alliances[b] && ((row[b / 64] >> (b % 64)) & 1))
+                {
+                    out.push_back(candidate);
+                }
+            }
+        }
+
+        void clear()
+        {
+            _names.clear();
+            _parents.clear();
+            _alliances.clear();
+            _hostility.clear();
+            _rowWords = 0;
+            _members.clear();
+        }
+    };
+}
+
+#endif // __FACTIONS_H__
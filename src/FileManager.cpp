@@ -68,4 +68,9 @@ namespace noname
             outputFile.flush();
         }
     }
+
+    std::ostream &FileManager::getOutputStream()
+    {
+        return outputFile;
+    }
 }
@@ -28,5 +28,11 @@ namespace noname
         void shutDown() noexcept override;
 
         void write(const std::string &text);
+
+        /**
+         * @brief Stream del fichero de salida, para escribir por bloques sin
+         * pasar por write() (que vacía en cada llamada)
+         */
+        std::ostream &getOutputStream();
     };
 }
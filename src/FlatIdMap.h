@@ -0,0 +1,181 @@
+#ifndef __FLAT_ID_MAP_H__
+#define __FLAT_ID_MAP_H__
+
+// System includes
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+namespace noname
+{
+    /**
+     * @brief Mapa id -> valor con direccionamiento abierto (sondeo lineal)
+     *
+     * Pensado para claves enteras no negativas (ids de personaje): las
+     * celdas están en un único vector contiguo y buscar un id no reserva
+     * memoria ni calcula hashes de cadenas. Los valores deberían ser
+     * pequeños (típicamente un índice a un vector denso).
+     */
+    template <typename Value>
+    class FlatIdMap
+    {
+    private:
+        static constexpr int EMPTY = -1;
+        static constexpr int ERASED = -2;
+
+        struct Slot
+        {
+            int key{EMPTY};
+            Value value{};
+        };
+
+        std::vector<Slot> _slots;
+        size_t _size{0};
+        size_t _used{0}; // Ocupadas + borradas
+
+        static size_t hash(int key) noexcept
+        {
+            // Mezcla de Fibonacci: ids consecutivos quedan repartidos
+            return static_cast<size_t>(static_cast<std::uint64_t>(static_cast<std::uint32_t>(key)) * 0x9E3779B97F4A7C15ULL >> 16);
+        }
+
+        void rehash(size_t capacity)
+        {
+            std::vector<Slot> old(capacity);
+            old.swap(_slots);
+            _size = 0;
+            _used = 0;
+            for (auto &slot : old)
+            {
+                if (slot.key >= 0)
+                {
+                    insertNew(slot.key, std::move(slot.value));
+                }
+            }
+        }
+
+        Value &insertNew(int key, Value value)
+        {
+            const size_t mask = _slots.size() - 1;
+            size_t i = hash(key) & mask;
+            while (_slots[i].key >= 0)
+            {
+                i = (i + 1) & mask;
+            }
+            if (_slots[i].key == EMPTY)
+            {
+                ++_used;
+            }
+            _slots[i].key = key;
+            _slots[i].value = std::move(value);
+            ++_size;
+            return _slots[i].value;
+        }
+
+        const Slot *findSlot(int key) const noexcept
+        {
+            if (_slots.empty() || key < 0)
+            {
+                return nullptr;
+            }
+            const size_t mask = _slots.size() - 1;
+            for (size_t i = hash(key) & mask;; i = (i + 1) & mask)
+            {
+                if (_slots[i].key == key)
+                {
+                    return &_slots[i];
+                }
+                if (_slots[i].key == EMPTY)
+                {
+                    return nullptr;
+                }
+            }
+        }
+
+    public:
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+        void clear()
+        {
+            _slots.clear();
+            _size = 0;
+            _used = 0;
+        }
+
+        void reserve(size_t count)
+        {
+            size_t capacity = 16;
+            while (capacity * 3 < count * 4)
+            {
+                capacity <<= 1;
+            }
+            if (capacity > _slots.size())
+            {
+                rehash(capacity);
+            }
+        }
+
+        [[nodiscard]] const Value *find(int key) const noexcept
+        {
+            const Slot *slot = findSlot(key);
+            return slot ? &slot->value : nullptr;
+        }
+
+        [[nodiscard]] Value *find(int key) noexcept
+        {
+            return const_cast<Value *>(std::as_const(*this).find(key));
+        }
+
+        [[nodiscard]] bool contains(int key) const noexcept { return findSlot(key) != nullptr; }
+
+        /**
+         * @brief Inserta key -> value si no existe
+         * @return Par (valor guardado, true si se ha insertado)
+         */
+        std::pair<Value &, bool> tryEmplace(int key, Value value)
+        {
+            if (Value *existing = find(key))
+            {
+                return {*existing, false};
+            }
+            // Carga máxima del 75% contando las celdas borradas
+            if ((_used + 1) * 4 > _slots.size() * 3)
+            {
+                rehash(_slots.empty() ? 16 : (_size + 1) * 4 > _slots.size() * 2 ? _slots.size() * 2 : _slots.size());
+            }
+            return {insertNew(key, std::move(value)), true};
+        }
+
+        bool erase(int key) noexcept
+        {
+            auto *slot = const_cast<Slot *>(findSlot(key));
+            if (!slot)
+            {
+                return false;
+            }
+            slot->key = ERASED;
+            slot->value = Value{};
+            --_size;
+            return true;
+        }
+
+        /**
+         * @brief Recorre los pares (id, valor) en orden de celda
+         */
+        template <typename F>
+        void forEach(F &&visit) const
+        {
+            for (const auto &slot : _slots)
+            {
+                if (slot.key >= 0)
+                {
+                    visit(slot.key, slot.value);
+                }
+            }
+        }
+    };
+}
+
+#endif // __FLAT_ID_MAP_H__
@@ -11,6 +11,8 @@
 #include "CreaturesManager.h"
 #include "SkillsManager.h"
 #include "WorldManager.h"
+#include "CharacterReportSink.h"
+#include "EventQueue.h"
 #include "Utils.h"
 
 namespace noname
@@ -18,7 +20,7 @@ namespace noname
     int GameManager::initialization(int argc, char *argv[])
     {
         // Define the usage string printed to console.
-        const std::string usage{"Usage: Noname_run"};
+        const std::string usage{"Usage: Noname_run [--binary-log]"};
 
         if (argc < 1)
         {
@@ -26,6 +28,19 @@ namespace noname
             return EXIT_FAILURE;
         }
 
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::string_view{argv[i]} == "--binary-log")
+            {
+                LM.setOutput(LogOutput::Binary);
+            }
+            else
+            {
+                LM.writeLog(Level::Error, "Invalid arguments. " + usage);
+                return EXIT_FAILURE;
+            }
+        }
+
         LM.writeLog(Level::Info, "Initialization successful.");
         return EXIT_SUCCESS;
     }
@@ -39,8 +54,10 @@ namespace noname
         CM.startUp();
         RM.startUp();
         SM.startUp();
+        RS.startUp();
+        EQ.startUp();
         World.startUp();
-        _started = LM.isStarted() and CM.isStarted() and WM.isStarted() and RM.isStarted() and SM.isStarted() and World.isStarted();
+        _started = LM.isStarted() and CM.isStarted() and WM.isStarted() and RM.isStarted() and SM.isStarted() and RS.isStarted() and EQ.isStarted() and World.isStarted();
     }
 
     void GameManager::shutDown() noexcept
@@ -50,6 +67,9 @@ namespace noname
         CM.shutDown();
         RM.shutDown();
         SM.shutDown();
+        RS.shutDown();
+        EQ.flush();
+        EQ.shutDown();
         LM.shutDown();
         World.shutDown();
     }
@@ -0,0 +1,465 @@
+#ifndef __GENEALOGY_H__
+#define __GENEALOGY_H__
+
+// System includes
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <functional>
+#include <utility>
+
+// Local includes
+#include "FlatIdMap.h"
+
+namespace noname
+{
+    /**
+     * @brief Árbol genealógico de una población, para consultas de ascendencia
+     *
+     * Es un grafo dirigido acíclico: cada miembro tiene como mucho un padre y
+     * una madre, que tienen que estar ya registrados al añadirlo. Por eso el
+     * orden de inserción es un orden topológico (los ascendientes siempre
+     * tienen índice menor) y las consultas recorren el grafo solo hacia atrás.
+     *
+     * Los datos de cada miembro están en columnas densas indexadas por orden
+     * de inserción; un FlatIdMap traduce ids de personaje a índices. Cada
+     * miembro guarda además una firma de 64 bits con él mismo y sus
+     * ascendientes de las últimas SIGNATURE_GENERATIONS generaciones: si dos
+     * firmas no comparten ningún bit, seguro que no tienen un ascendiente
+     * común tan reciente.
+     *
+     * El parentesco (coeficiente de coancestría) se memoriza por parejas y la
+     * consanguinidad por miembro: el árbol solo crece, así que un valor
+     * calculado no cambia. Con
+     * setKinshipHorizon() los miembros de generaciones anteriores se tratan
+     * como fundadores, para acotar el coste en árboles muy profundos.
+     *
+     * Las consultas reutilizan memoria interna: no se pueden hacer desde
+     * varios hilos a la vez.
+     */
+    class Genealogy
+    {
+    public:
+        using Index = std::uint32_t;
+        static constexpr Index NONE = std::numeric_limits<Index>::max();
+        static constexpr int SIGNATURE_GENERATIONS = 3;
+        static constexpr size_t MAX_CACHED_KINSHIPS = size_t{1} << 22;
+
+    private:
+        std::vector<int> _ids;
+        std::vector<Index> _fathers;
+        std::vector<Index> _mothers;
+        std::vector<std::uint16_t> _generations;
+        std::vector<std::uint64_t> _signatures;
+        FlatIdMap<Index> _index;
+
+        std::uint16_t _kinshipHorizon{0};
+        std::unordered_map<std::uint64_t, double> _kinships;
+        static constexpr double UNKNOWN_INBREEDING = -1.0;
+        std::vector<double> _inbreeding; // Memorizada por miembro; UNKNOWN_INBREEDING si falta
+        mutable std::vector<Index> _visitA, _visitB; // Reutilizados entre consultas
+        // Marca de la última consulta que visitó cada miembro, para no repetirlos
+        mutable std::vector<std::uint32_t> _visited;
+        mutable std::uint32_t _visitStamp{0};
+
+        static std::uint64_t signatureBit(Index member) noexcept
+        {
+            return std::uint64_t{1} << ((static_cast<std::uint64_t>(member) * 0x9E3779B97F4A7C15ULL) >> 58);
+        }
+
+        // Firma del miembro: él mismo más sus ascendientes hasta depth generaciones
+        std::uint64_t ancestrySignature(Index member, int depth) const noexcept
+        {
+            if (member == NONE)
+            {
+                return 0;
+            }
+            std::uint64_t signature = signatureBit(member);
+            if (depth > 0)
+            {
+                signature |= ancestrySignature(_fathers[member], depth - 1);
+                signature |= ancestrySignature(_mothers[member], depth - 1);
+            }
+            return signature;
+        }
+
+        /**
+         * @brief Miembro y sus ascendientes hasta generations generaciones,
+         * sin repetidos, en out
+         *
+         * Con shared, añade también ahí los que ya visitó la recogida anterior.
+         */
+        void collectAncestors(Index member, int generations, std::vector<Index> &out, int horizon = 0,
+                              std::vector<Index> *shared = nullptr) const
+        {
+            _visited.resize(_ids.size(), 0);
+            if (++_visitStamp == 0)
+            {
+                std::fill(_visited.begin(), _visited.end(), 0);
+                _visitStamp = 1;
+            }
+            const std::uint32_t previous = _visitStamp - 1;
+            auto visit = [&](Index ancestor) {
+                if (shared && previous != 0 && _visited[ancestor] == previous)
+                {
+                    shared->push_back(ancestor);
+                }
+                _visited[ancestor] = _visitStamp;
+                out.push_back(ancestor);
+            };
+            out.clear();
+            visit(member);
+            size_t levelBegin = 0;
+            for (int generation = 0; generation < generations && levelBegin < out.size(); ++generation)
+            {
+                const size_t levelEnd = out.size();
+                for (size_t i = levelBegin; i < levelEnd; ++i)
+                {
+                    if (_generations[out[i]] < horizon)
+                    {
+                        continue;
+                    }
+                    for (Index parent : {_fathers[out[i]], _mothers[out[i]]})
+                    {
+                        // Con pedigrí colapsado un mismo ascendiente llega por varias ramas
+                        if (parent != NONE && _visited[parent] != _visitStamp)
+                        {
+                            visit(parent);
+                        }
+                    }
+                }
+                levelBegin = levelEnd;
+            }
+        }
+
+        /**
+         * @brief Contribución genética de cada ascendiente al miembro
+         *
+         * Suma de (1/2)^longitud por cada camino hasta el ascendiente, sin
+         * pasar de los miembros anteriores al horizonte. Sale ordenado por
+         * índice descendente (el propio miembro primero, con peso 1).
+         */
+        void ancestralWeights(Index member, std::vector<std::pair<Index, double>> &weights) const
+        {
+            collectAncestors(member, std::numeric_limits<int>::max(), _visitA, _kinshipHorizon);
+            std::sort(_visitA.begin(), _visitA.end(), std::greater<>{});
+            weights.resize(_visitA.size());
+            for (size_t i = 0; i < _visitA.size(); ++i)
+            {
+                weights[i] = {_visitA[i], i == 0 ? 1.0 : 0.0};
+            }
+            // En orden topológico inverso cada miembro ya tiene su peso completo al repartirlo
+            for (size_t i = 0; i < weights.size(); ++i)
+            {
+                const Index current = weights[i].first;
+                if (_generations[current] < _kinshipHorizon)
+                {
+                    continue;
+                }
+                for (Index parent : {_fathers[current], _mothers[current]})
+                {
+                    if (parent != NONE)
+                    {
+                        auto found = std::lower_bound(weights.begin() + static_cast<std::ptrdiff_t>(i) + 1, weights.end(), parent,
+                                                      [](const auto &weight, Index value) { return weight.first > value; });
+                        found->second += 0.5 * weights[i].second;
+                    }
+                }
+            }
+        }
+
+        double inbreedingOf(Index member)
+        {
+            if (member == NONE || _generations[member] < _kinshipHorizon || _fathers[member] == NONE || _mothers[member] == NONE)
+            {
+                return 0.0;
+            }
+            if (_inbreeding.size() <= member)
+            {
+                _inbreeding.resize(_ids.size(), UNKNOWN_INBREEDING);
+            }
+            if (_inbreeding[member] == UNKNOWN_INBREEDING)
+            {
+                _inbreeding[member] = kinshipOf(_fathers[member], _mothers[member]);
+            }
+            return _inbreeding[member];
+        }
+
+        // Varianza de muestreo mendeliano del miembro (la D de A = L D L^T)
+        double mendelianVariance(Index member)
+        {
+            if (_generations[member] < _kinshipHorizon)
+            {
+                return 1.0;
+            }
+            double variance = 1.0;
+            for (Index parent : {_fathers[member], _mothers[member]})
+            {
+                if (parent != NONE)
+                {
+                    variance -= 0.25 * (1.0 + inbreedingOf(parent));
+                }
+            }
+            return variance;
+        }
+
+        /**
+         * @brief Parentesco por la descomposición de Henderson de la matriz de
+         * parentesco aditivo: 2 * kinship(a, b) es la suma, sobre los
+         * ascendientes comunes k, de L(a, k) * L(b, k) * D(k)
+         *
+         * Cuesta lo que recorrer los ascendientes de los dos, en vez del
+         * producto de ambos que necesita la recursión por parejas. La
+         * consanguinidad de los ascendientes comunes se memoriza por miembro.
+         */
+        double kinshipOf(Index a, Index b)
+        {
+            if (a == NONE || b == NONE)
+            {
+                return 0.0;
+            }
+            if (a < b)
+            {
+                std::swap(a, b);
+            }
+            const std::uint64_t key = (static_cast<std::uint64_t>(a) << 32) | b;
+            if (auto cached = _kinships.find(key); cached != _kinships.end())
+            {
+                return cached->second;
+            }
+
+            // Vectores locales: inbreedingOf() vuelve a entrar aquí para los ascendientes comunes
+            std::vector<std::pair<Index, double>> first, second, common;
+            ancestralWeights(a, first);
+            ancestralWeights(b, second);
+            for (auto i = first.begin(), j = second.begin(); i != first.end() && j != second.end();)
+            {
+                if (i->first == j->first)
+                {
+                    common.emplace_back(i->first, i->second * j->second);
+                    ++i;
+                    ++j;
+                }
+                else if (i->first > j->first)
+                {
+                    ++i;
+                }
+                else
+                {
+                    ++j;
+                }
+            }
+            double additive = 0.0;
+            for (const auto &[ancestor, weight] : common)
+            {
+                additive += weight * mendelianVariance(ancestor);
+            }
+            const double value = 0.5 * additive;
+
+            if (_kinships.size() >= MAX_CACHED_KINSHIPS)
+            {
+                _kinships.clear();
+            }
+            _kinships.emplace(key, value);
+            return value;
+        }
+
+    public:
+        void reserve(size_t members)
+        {
+            _ids.reserve(members);
+            _fathers.reserve(members);
+            _mothers.reserve(members);
+            _generations.reserve(members);
+            _signatures.reserve(members);
+            _index.reserve(members);
+        }
+
+        /**
+         * @brief Registra un miembro
+         * @param fatherId,motherId Ids de los padres, o -1 si no se conocen
+         * @return Índice del miembro, o NONE si el id ya estaba o algún padre no está registrado
+         */
+        Index addMember(int id, int fatherId = -1, int motherId = -1)
+        {
+            const Index father = fatherId < 0 ? NONE : indexOf(fatherId);
+            const Index mother = motherId < 0 ? NONE : indexOf(motherId);
+            if ((fatherId >= 0 && father == NONE) || (motherId >= 0 && mother == NONE))
+            {
+                return NONE;
+            }
+            const Index member = static_cast<Index>(_ids.size());
+            if (!_index.tryEmplace(id, member).second)
+            {
+                return NONE;
+            }
+            std::uint16_t generation = 0;
+            for (Index parent : {father, mother})
+            {
+                if (parent != NONE)
+                {
+                    generation = std::max<std::uint16_t>(generation, static_cast<std::uint16_t>(_generations[parent] + 1));
+                }
+            }
+            _ids.push_back(id);
+            _fathers.push_back(father);
+            _mothers.push_back(mother);
+            _generations.push_back(generation);
+            _signatures.push_back(signatureBit(member) |
+                                  ancestrySignature(father, SIGNATURE_GENERATIONS - 1) |
+                                  ancestrySignature(mother, SIGNATURE_GENERATIONS - 1));
+            return member;
+        }
+
+        /**
+         * @brief Registra un nacimiento a partir de los personajes (necesitan getId())
+         */
+        template <typename T>
+        Index addChild(const T &child, const T &father, const T &mother)
+        {
+            return addMember(child.getId(), father.getId(), mother.getId());
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return _ids.size(); }
+        [[nodiscard]] bool contains(int id) const noexcept { return _index.contains(id); }
+
+        [[nodiscard]] Index indexOf(int id) const noexcept
+        {
+            const Index *member = _index.find(id);
+            return member ? *member : NONE;
+        }
+
+        /**
+         * @brief Miembros en orden topológico: los ascendientes antes que sus descendientes
+         */
+        [[nodiscard]] const std::vector<int> &getTopologicalOrder() const noexcept { return _ids; }
+
+        // Generación del miembro: 0 para fundadores, o una más que el padre más reciente
+        [[nodiscard]] int getGeneration(int id) const noexcept
+        {
+            const Index member = indexOf(id);
+            return member == NONE ? -1 : _generations[member];
+        }
+
+        [[nodiscard]] std::uint64_t getSignature(int id) const noexcept
+        {
+            const Index member = indexOf(id);
+            return member == NONE ? 0 : _signatures[member];
+        }
+
+        /**
+         * @brief Descarte rápido: false si seguro que no comparten ningún
+         * ascendiente (ni son uno ascendiente del otro) en las últimas
+         * SIGNATURE_GENERATIONS generaciones
+         */
+        [[nodiscard]] bool mayShareRecentAncestor(int a, int b) const noexcept
+        {
+            return (getSignature(a) & getSignature(b)) != 0;
+        }
+
+        /**
+         * @brief Ascendientes hasta generations generaciones atrás, de los
+         * padres hacia atrás y sin repetidos
+         */
+        [[nodiscard]] std::vector<int> getAncestors(int id, int generations) const
+        {
+            std::vector<int> result;
+            const Index member = indexOf(id);
+            if (member == NONE)
+            {
+                return result;
+            }
+            std::vector<Index> ancestors;
+            collectAncestors(member, generations, ancestors);
+            result.reserve(ancestors.size() - 1);
+            for (size_t i = 1; i < ancestors.size(); ++i)
+            {
+                result.push_back(_ids[ancestors[i]]);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Ascendiente común más reciente (el de generación más alta)
+         * buscando hasta generations generaciones atrás
+         *
+         * Si uno es ascendiente del otro, el resultado es él mismo.
+         */
+        [[nodiscard]] std::optional<int> getMostRecentCommonAncestor(int a, int b, int generations = 16)
+        {
+            const Index first = indexOf(a), second = indexOf(b);
+            if (first == NONE || second == NONE)
+            {
+                return std::nullopt;
+            }
+            if (generations <= SIGNATURE_GENERATIONS && (_signatures[first] & _signatures[second]) == 0)
+            {
+                return std::nullopt;
+            }
+            if (_visitStamp >= std::numeric_limits<std::uint32_t>::max() - 1)
+            {
+                _visitStamp = 0; // Que las dos recogidas no queden a ambos lados de un reinicio
+                std::fill(_visited.begin(), _visited.end(), 0);
+            }
+            std::vector<Index> &common = _visitA;
+            collectAncestors(first, generations, _visitB);
+            common.clear();
+            collectAncestors(second, generations, _visitB, 0, &common);
+            Index best = NONE;
+            for (Index candidate : common)
+            {
+                if (best == NONE || _generations[candidate] > _generations[best])
+                {
+                    best = candidate;
+                }
+            }
+            return best == NONE ? std::nullopt : std::optional<int>{_ids[best]};
+        }
+
+        /**
+         * @brief Coeficiente de parentesco: probabilidad de que un alelo
+         * tomado al azar de cada uno sea idéntico por descendencia
+         *
+         * 0.5 consigo mismo (sin consanguinidad), 0.25 entre padre e hijo o
+         * entre hermanos, 0 sin ascendientes comunes.
+         */
+        [[nodiscard]] double getKinship(int a, int b)
+        {
+            const Index first = indexOf(a), second = indexOf(b);
+            return first == NONE || second == NONE ? 0.0 : kinshipOf(first, second);
+        }
+
+        /**
+         * @brief Coeficiente de consanguinidad: el parentesco entre sus padres
+         */
+        [[nodiscard]] double getInbreeding(int id)
+        {
+            const Index member = indexOf(id);
+            return member == NONE ? 0.0 : inbreedingOf(member);
+        }
+
+        /**
+         * @brief Los miembros de generaciones anteriores a generation cuentan
+         * como fundadores al calcular el parentesco
+         */
+        void setKinshipHorizon(int generation)
+        {
+            const auto horizon = static_cast<std::uint16_t>(std::clamp(generation, 0, int{std::numeric_limits<std::uint16_t>::max()}));
+            if (horizon != _kinshipHorizon)
+            {
+                _kinshipHorizon = horizon;
+                _kinships.clear();
+                _inbreeding.clear();
+            }
+        }
+
+        [[nodiscard]] int getKinshipHorizon() const noexcept { return _kinshipHorizon; }
+        [[nodiscard]] size_t getCachedKinshipCount() const noexcept { return _kinships.size(); }
+    };
+}
+
+#endif // __GENEALOGY_H__
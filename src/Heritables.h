@@ -2,13 +2,15 @@
 #define __HERITABLES_H__
 
 // System includes
-#include <vector>
+#include <array>
 #include <string>
-#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
 
 // Local includes
-#include "Property.h"
 #include "LogManager.h"
+#include "Rng.h"
 
 namespace noname
 {
@@ -44,82 +46,106 @@ namespace noname
         }
     };
 
+    /**
+     * @brief Valores heredables de un personaje, de 0 a 100
+     *
+     * Son un array fijo de bytes. Los de los personajes viven en la columna
+     * _heritables de su CharacterStore, y se llega a ellos por la fila con
+     * Character::heritables(). Los valores aleatorios salen del Rng que pase quien llama (o del del hilo,
+     * Rng::threadLocal()): con la misma semilla, los mismos heritables.
+     */
     class Heritables
     {
+    public:
+        static constexpr size_t COUNT = static_cast<size_t>(HeritableType::LAST_HERITABLE);
+        static constexpr int MAX_VALUE = 100;
+        using Values = std::array<std::uint8_t, COUNT>;
+
     protected:
-        std::vector<Property<short>> _heritables;
+        Values _values{};
 
     public:
-        Heritables()
+        Heritables() : Heritables(Rng::threadLocal()) {}
+
+        explicit Heritables(Rng &rng) noexcept
         {
             // Random initialization for testing - TO BE DONE PROPERLY
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_int_distribution<> attributesDist(0, 100);
-
-            for (int i = 0; i < static_cast<int>(HeritableType::LAST_HERITABLE); ++i)
+            for (auto &value : _values)
             {
-                _heritables.push_back(attributesDist(gen));
+                value = static_cast<std::uint8_t>(rng.uniformInt(0, MAX_VALUE));
             }
-        };
+        }
 
-        short at(HeritableType type) const
+        explicit Heritables(const Values &values) noexcept : _values{values} {}
+
+        short at(HeritableType type) const noexcept
         {
-            return _heritables.at(static_cast<int>(type));
+            return _values[static_cast<size_t>(type)];
         }
 
+        const Values &values() const noexcept { return _values; }
+
         void determineHeritablesValues(const Heritables &father, const Heritables &mother)
         {
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_int_distribution<> dist(1, 2);
-            std::uniform_real_distribution<> mutationChance(0.0, 1.0);
-            double mutationRate = 0.1; // 10% chance of mutation
+            determineHeritablesValues(father, mother, Rng::threadLocal());
+        }
+
+        void determineHeritablesValues(const Heritables &father, const Heritables &mother, Rng &rng) noexcept
+        {
+            constexpr double mutationRate = 0.1; // 10% chance of mutation
 
             // Function to apply complex mutation
-            auto applyComplexMutation = [&](int attribute)
+            auto applyComplexMutation = [&rng](int attribute)
             {
-                std::uniform_int_distribution<> mutationTypeDist(1, 3);
-                int mutationType = mutationTypeDist(gen);
+                int mutationType = rng.uniformInt(1, 3);
 
                 // LM.writeLog(Level::Debug, "Character " + std::string{_name} + " has complex mutation of type " + std::to_string(mutationType));
 
                 switch (mutationType)
                 {
-                case 1:
-                { // Random increase/decrease within a range
-                    std::uniform_int_distribution<> changeDist(-3, 3);
-                    attribute += changeDist(gen);
+                case 1: // Random increase/decrease within a range
+                    attribute += rng.uniformInt(-3, 3);
                     break;
-                }
-                case 2:
-                {                                                            // Percentage change
-                    std::uniform_real_distribution<> percentDist(-0.1, 0.1); // -10% to +10%
-                    attribute = static_cast<int>(attribute * (1.0 + percentDist(gen)));
+                case 2: // Percentage change, -10% to +10%
+                    attribute = static_cast<int>(attribute * (1.0 + rng.uniformReal(-0.1, 0.1)));
                     break;
-                }
-                case 3:
-                { // Random set within a new range
-                    std::uniform_int_distribution<> newValueDist(1, 100);
-                    attribute = newValueDist(gen);
+                case 3: // Random set within a new range
+                    attribute = rng.uniformInt(1, MAX_VALUE);
                     break;
                 }
-                }
 
                 // Ensure attribute stays within reasonable bounds
-                attribute = std::max(1, attribute);
-                attribute = std::min(100, attribute);
-                return attribute;
+                return std::clamp(attribute, 1, MAX_VALUE);
             };
 
-            for (int i = 0; i < static_cast<int>(HeritableType::LAST_HERITABLE); ++i)
+            // Dos números al azar bastan para todos los genes: un bit por gen
+            // para elegir progenitor y 16 bits por gen para decidir la mutación
+            static_assert(COUNT <= 6, "two 64-bit draws cover at most 6 genes");
+            const std::uint64_t low = rng(), high = rng();
+
+            // Mezcla sin saltos: 0xFF en los bytes de los genes que vienen del padre
+            // (byte a byte y no con memcpy de 6 bytes, que pasa por la pila)
+            std::uint64_t fromFather = 0, fromMother = 0, mask = 0;
+            for (size_t i = 0; i < COUNT; ++i)
+            {
+                fromFather |= std::uint64_t{father._values[i]} << (8 * i);
+                fromMother |= std::uint64_t{mother._values[i]} << (8 * i);
+                mask |= ((high >> (32 + i)) & 1) * (std::uint64_t{0xFF} << (8 * i));
+            }
+            const std::uint64_t genes = (fromFather & mask) | (fromMother & ~mask);
+            for (size_t i = 0; i < COUNT; ++i)
+            {
+                _values[i] = static_cast<std::uint8_t>(genes >> (8 * i));
+            }
+
+            constexpr auto mutationThreshold = static_cast<std::uint64_t>(mutationRate * 65536.0 + 0.5);
+            for (size_t i = 0; i < COUNT; ++i)
             {
-                short gene = (dist(gen) == 1) ? father._heritables.at(i) : mother._heritables.at(i);
-                if (mutationChance(gen) < mutationRate)
+                const std::uint64_t mutationBits = (i < 4 ? low >> (16 * i) : high >> (16 * (i - 4))) & 0xFFFF;
+                if (mutationBits < mutationThreshold)
                 {
-                    gene = applyComplexMutation(gene);
+                    _values[i] = static_cast<std::uint8_t>(applyComplexMutation(_values[i]));
                 }
-                _heritables.at(i) = gene;
             }
         }
     };
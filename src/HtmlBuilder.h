@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include <sstream>
+#include <utility>
 
 namespace noname
 {
@@ -16,9 +17,9 @@ namespace noname
         const size_t indent_size = 2;
 
         HtmlElement() {}
-        HtmlElement(const std::string &name, const std::string &text)
-            : _name(name),
-              _text(text)
+        HtmlElement(std::string name, std::string text)
+            : _name(std::move(name)),
+              _text(std::move(text))
         {
         }
 
@@ -43,25 +44,24 @@ namespace noname
     public:
         HtmlBuilder(std::string root_name)
         {
-            root._name = root_name;
+            root._name = std::move(root_name);
         }
 
         HtmlBuilder(std::string name, std::string text)
         {
-            root._name = name;
-            root._text = text;
+            root._name = std::move(name);
+            root._text = std::move(text);
         }
 
         HtmlBuilder &add_child(std::string child_name, std::string child_text)
         {
-            HtmlElement e{child_name, child_text};
-            root._elements.emplace_back(e);
+            root._elements.emplace_back(std::move(child_name), std::move(child_text));
             return *this;
         }
 
         HtmlBuilder &add_child(HtmlBuilder child)
         {
-            root._elements.emplace_back(child);
+            root._elements.emplace_back(std::move(child.root));
             return *this;
         }
 
@@ -0,0 +1,232 @@
+#ifndef __HTML_WRITER_H__
+#define __HTML_WRITER_H__
+
+// System includes
+#include <array>
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <charconv>
+#include <type_traits>
+#include <cstddef>
+
+// Local includes
+#include "LogManager.h"
+
+namespace noname
+{
+    /**
+     * @brief Escritor de HTML en streaming, sin árbol intermedio
+     *
+     * Escribe cada etiqueta en el momento en que se abre o se cierra, con el
+     * mismo formato indentado que HtmlBuilder. El texto se escapa. Escribe en
+     * un std::string del llamador o, a través de un búfer interno que se
+     * vacía por bloques, en un std::ostream (por ejemplo el de FileManager).
+     *
+     * Los nombres de etiqueta se guardan como string_view hasta cerrarlas:
+     * deben seguir vivos mientras estén abiertos (normalmente son literales).
+     * No se anidan más de MAX_DEPTH elementos: los que pasan de ahí no se
+     * escriben, ni su contenido, y sus close() se ignoran.
+     */
+    class HtmlWriter
+    {
+    public:
+        static constexpr size_t MAX_DEPTH = 32;
+        static constexpr size_t INDENT_SIZE = 2;
+        static constexpr size_t DEFAULT_FLUSH_THRESHOLD = 64 * 1024;
+
+    private:
+        std::string _ownBuffer;
+        std::string &_out;
+        std::ostream *_stream{nullptr};
+        size_t _flushThreshold{0};
+        std::array<std::string_view, MAX_DEPTH> _open{};
+        size_t _depth{0};
+        // Elementos abiertos por encima de MAX_DEPTH, que no se escriben
+        size_t _skipped{0};
+
+        void indent(size_t level)
+        {
+            _out.append(level * INDENT_SIZE, ' ');
+        }
+
+        void append(std::string_view value)
+        {
+            escape(_out, value);
+        }
+
+        template <typename T>
+            requires std::is_arithmetic_v<T>
+        void append(T value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                _out.append(value ? "1" : "0");
+            }
+            else
+            {
+                std::array<char, 32> digits;
+                auto [end, error] = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+                _out.append(digits.data(), end);
+            }
+        }
+
+        void maybeFlush()
+        {
+            if (_stream && _out.size() >= _flushThreshold)
+            {
+                flush();
+            }
+        }
+
+    public:
+        /**
+         * @brief Escribe al final de out
+         */
+        explicit HtmlWriter(std::string &out) : _out(out) {}
+
+        /**
+         * @brief Escribe en stream por bloques de unos flushThreshold bytes
+         */
+        explicit HtmlWriter(std::ostream &stream, size_t flushThreshold = DEFAULT_FLUSH_THRESHOLD)
+            : _out(_ownBuffer), _stream(&stream), _flushThreshold(flushThreshold)
+        {
+            _ownBuffer.reserve(flushThreshold + 1024);
+        }
+
+        ~HtmlWriter()
+        {
+            flush();
+        }
+
+        HtmlWriter(const HtmlWriter &) = delete;
+        HtmlWriter &operator=(const HtmlWriter &) = delete;
+
+        /**
+         * @brief Añade text a out sustituyendo & < > " ' por sus entidades
+         */
+        static void escape(std::string &out, std::string_view text)
+        {
+            size_t start = 0;
+            for (size_t i = text.find_first_of("&<>\"'"); i != std::string_view::npos; i = text.find_first_of("&<>\"'", start))
+            {
+                out.append(text, start, i - start);
+                switch (text[i])
+                {
+                case '&':
+                    out.append("&amp;");
+                    break;
+                case '<':
+                    out.append("&lt;");
+                    break;
+                case '>':
+                    out.append("&gt;");
+                    break;
+                case '"':
+                    out.append("&quot;");
+                    break;
+                default:
+                    out.append("&#39;");
+                    break;
+                }
+                start = i + 1;
+            }
+            out.append(text, start, std::string_view::npos);
+        }
+
+        HtmlWriter &open(std::string_view name)
+        {
+            if (_depth == MAX_DEPTH || _skipped > 0)
+            {
+                if (_skipped++ == 0)
+                {
+                    LM.log<Level::Error>("HtmlWriter: <{}> exceeds the maximum depth of {}, skipping it", name, MAX_DEPTH);
+                }
+                return *this;
+            }
+            _open[_depth] = name;
+            indent(_depth++);
+            _out.push_back('<');
+            _out.append(name);
+            _out.append(">\n");
+            return *this;
+        }
+
+        HtmlWriter &close()
+        {
+            if (_skipped > 0)
+            {
+                --_skipped;
+                return *this;
+            }
+            if (_depth == 0)
+            {
+                return *this;
+            }
+            --_depth;
+            indent(_depth);
+            _out.append("</");
+            _out.append(_open[_depth]);
+            _out.append(">\n");
+            maybeFlush();
+            return *this;
+        }
+
+        /**
+         * @brief Una línea de texto dentro del elemento abierto
+         *
+         * Las cadenas se escapan y los números se escriben con to_chars, sin
+         * pasar por std::string.
+         */
+        template <typename... Parts>
+        HtmlWriter &text(const Parts &...parts)
+        {
+            if (_skipped > 0)
+            {
+                return *this;
+            }
+            indent(_depth);
+            (append(parts), ...);
+            _out.push_back('\n');
+            return *this;
+        }
+
+        /**
+         * @brief <name>value</name> en una llamada
+         */
+        template <typename T>
+        HtmlWriter &element(std::string_view name, const T &value)
+        {
+            return open(name).text(value).close();
+        }
+
+        /**
+         * @brief Cierra todos los elementos abiertos
+         */
+        HtmlWriter &closeAll()
+        {
+            _skipped = 0;
+            while (_depth > 0)
+            {
+                close();
+            }
+            return *this;
+        }
+
+        [[nodiscard]] size_t getDepth() const noexcept { return _depth; }
+
+        /**
+         * @brief Vuelca el búfer interno al stream (no hace nada al escribir en un string)
+         */
+        void flush()
+        {
+            if (_stream && !_out.empty())
+            {
+                _stream->write(_out.data(), static_cast<std::streamsize>(_out.size()));
+                _out.clear();
+            }
+        }
+    };
+}
+
+#endif // __HTML_WRITER_H__
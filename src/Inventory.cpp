@@ -103,14 +103,13 @@ namespace noname
     {
         if (!item)
         {
-            LM.writeLog(Level::Warning, "Attempted to store null item");
+            LM.log<Level::Warning>("Attempted to store null item");
             return;
         }
 
         if (!isValidItemForSlot(item, slot))
         {
-            LM.writeLog(Level::Warning, "Item type " + std::to_string(static_cast<int>(item->getItemType())) + 
-                       " is not valid for slot " + std::to_string(static_cast<int>(slot)));
+            LM.log<Level::Warning>("Item type {} is not valid for slot {}", item->getItemType(), slot);
             return;
         }
 
@@ -140,14 +139,14 @@ namespace noname
                     if (container)
                     {
                         // Try to put shield in container (simplified - real implementation would check container capacity)
-                        LM.writeLog(Level::Info, "Moving shield to container due to two-handed weapon");
+                        LM.log<Level::Info>("Moving shield to container due to two-handed weapon");
                         atSlot(ItemSlotType::SHIELD) = nullptr;
                         // TODO: Actually add to container inventory
                     }
                     else
                     {
                         // Drop shield to ground
-                        LM.writeLog(Level::Info, "Dropping shield to ground due to two-handed weapon and no container");
+                        LM.log<Level::Info>("Dropping shield to ground due to two-handed weapon and no container");
                         atSlot(ItemSlotType::SHIELD) = nullptr;
                         // TODO: Add shield to world/ground
                     }
@@ -165,14 +164,14 @@ namespace noname
                 if (container)
                 {
                     // Try to put weapon in container
-                    LM.writeLog(Level::Info, "Moving two-handed weapon to container due to shield");
+                    LM.log<Level::Info>("Moving two-handed weapon to container due to shield");
                     atSlot(ItemSlotType::WEAPON) = nullptr;
                     // TODO: Actually add to container inventory
                 }
                 else
                 {
                     // Drop weapon to ground
-                    LM.writeLog(Level::Info, "Dropping two-handed weapon to ground due to shield and no container");
+                    LM.log<Level::Info>("Dropping two-handed weapon to ground due to shield and no container");
                     atSlot(ItemSlotType::WEAPON) = nullptr;
                     // TODO: Add weapon to world/ground
                 }
@@ -89,6 +89,37 @@ namespace noname
         }
     }
 
+    inline std::string ItemSlotTypeToString(ItemSlotType slot)
+    {
+        switch (slot)
+        {
+        case ItemSlotType::AMULET:
+            return "AMULET";
+        case ItemSlotType::HELMET:
+            return "HELMET";
+        case ItemSlotType::CONTAINER:
+            return "CONTAINER";
+        case ItemSlotType::WEAPON:
+            return "WEAPON";
+        case ItemSlotType::RING_LEFT:
+            return "RING_LEFT";
+        case ItemSlotType::ARMOR:
+            return "ARMOR";
+        case ItemSlotType::SHIELD:
+            return "SHIELD";
+        case ItemSlotType::RING_RIGHT:
+            return "RING_RIGHT";
+        case ItemSlotType::LEGS_ARMOR:
+            return "LEGS_ARMOR";
+        case ItemSlotType::BOOTS:
+            return "BOOTS";
+        case ItemSlotType::AMMUNITION:
+            return "AMMUNITION";
+        default:
+            return "UNKNOWN";
+        }
+    }
+
     static ItemType slotTypeToItemType(ItemSlotType slot)
     {
         switch (slot)
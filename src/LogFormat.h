@@ -0,0 +1,122 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <concepts>
+#include <type_traits>
+
+namespace noname::logformat
+{
+    /**
+     * @brief Añade un argumento al buffer de salida
+     *
+     * - Las cadenas y string_view se copian tal cual.
+     * - Los enteros y los números en coma flotante pasan por std::to_chars.
+     * - Los enums usan una sobrecarga toLogString(value) encontrada por ADL si
+     *   existe, y si no su valor entero.
+     * - Los invocables se llaman antes, así que los argumentos caros (getters
+     *   virtuales que devuelven std::string...) solo se evalúan si la línea
+     *   se va a escribir.
+     */
+    inline void appendArg(std::string &out, std::string_view value) { out.append(value); }
+    inline void appendArg(std::string &out, const char *value) { out.append(value ? value : "(null)"); }
+    inline void appendArg(std::string &out, const std::string &value) { out.append(value); }
+    inline void appendArg(std::string &out, char value) { out.push_back(value); }
+    inline void appendArg(std::string &out, bool value) { out.append(value ? "true" : "false"); }
+
+    template <typename T>
+        requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+    void appendArg(std::string &out, T value)
+    {
+        char buffer[64];
+        auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        if (ec == std::errc{})
+        {
+            out.append(buffer, end);
+        }
+    }
+
+    template <typename T>
+        requires std::is_enum_v<T>
+    void appendArg(std::string &out, T value)
+    {
+        if constexpr (requires { toLogString(value); })
+        {
+            appendArg(out, toLogString(value));
+        }
+        else
+        {
+            appendArg(out, static_cast<std::underlying_type_t<T>>(value));
+        }
+    }
+
+    template <typename F>
+        requires(std::invocable<const F &> && !std::is_convertible_v<F, std::string_view>)
+    void appendArg(std::string &out, const F &producer)
+    {
+        appendArg(out, producer());
+    }
+
+    /**
+     * @brief Copia fmt en out hasta el siguiente hueco "{}" ("{{" y "}}" son escapes)
+     * @return El resto de fmt tras el hueco, o una vista vacía con found = false
+     * si no quedan huecos
+     */
+    inline std::string_view appendUntilPlaceholder(std::string &out, std::string_view fmt, bool &found)
+    {
+        found = false;
+        size_t i = 0;
+        while (i < fmt.size())
+        {
+            char c = fmt[i];
+            if ((c == '{' || c == '}') && i + 1 < fmt.size() && fmt[i + 1] == c)
+            {
+                out.push_back(c);
+                i += 2;
+                continue;
+            }
+            if (c == '{' && i + 1 < fmt.size() && fmt[i + 1] == '}')
+            {
+                found = true;
+                return fmt.substr(i + 2);
+            }
+            out.push_back(c);
+            ++i;
+        }
+        return {};
+    }
+
+    /**
+     * @brief Copia el resto de fmt cuando ya no quedan argumentos
+     */
+    inline void formatTo(std::string &out, std::string_view fmt)
+    {
+        bool found = true;
+        while (found)
+        {
+            auto rest = appendUntilPlaceholder(out, fmt, found);
+            if (found)
+            {
+                out.append("{}"); // Más huecos que argumentos
+            }
+            fmt = rest;
+        }
+    }
+
+    /**
+     * @brief Rellena los huecos "{}" de fmt con los argumentos, en orden
+     */
+    template <typename First, typename... Rest>
+    void formatTo(std::string &out, std::string_view fmt, const First &first, const Rest &...rest)
+    {
+        bool found = false;
+        auto remaining = appendUntilPlaceholder(out, fmt, found);
+        if (!found)
+        {
+            return; // Más argumentos que huecos
+        }
+        appendArg(out, first);
+        formatTo(out, remaining, rest...);
+    }
+}
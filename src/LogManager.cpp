@@ -1,18 +1,50 @@
 #include "LogManager.h"
 
 #include <chrono>
+#include <csignal>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
 #include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace noname
 {
+    namespace
+    {
+        // SIGTERM is a normal shutdown request, not a crash: it is left alone.
+        constexpr int FATAL_SIGNALS[] = {SIGSEGV, SIGABRT, SIGFPE, SIGILL};
+        using SignalHandler = void (*)(int);
+        SignalHandler previousHandlers[std::size(FATAL_SIGNALS)] = {};
+
+        // Async-signal-safe: only write(2)
+        void writeAll(int fd, const char *data, size_t size) noexcept
+        {
+            while (size > 0)
+            {
+                auto written = ::write(fd, data, size);
+                if (written <= 0)
+                {
+                    return;
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+        }
+    }
+
     LogManager::~LogManager()
     {
+        stopWriter();
         if (_logFile.is_open())
         {
             _logFile.close();
         }
+        if (_signalFd >= 0)
+        {
+            ::close(_signalFd);
+        }
     }
 
     void LogManager::startUp() noexcept
@@ -20,12 +52,36 @@ namespace noname
         try
         {
             setType("LogManager");
-            _logFile.open(LOGFILE_NAME.string(), std::ios::out | std::ios::app);
+            _activeOutput.store(_output, std::memory_order_relaxed);
+            const bool binary = _output == LogOutput::Binary;
+            const auto &path = binary ? BINARY_LOGFILE_NAME : LOGFILE_NAME;
+            _logFile.open(path.string(), std::ios::out | std::ios::app | (binary ? std::ios::binary : std::ios::openmode{}));
             if (!_logFile.is_open())
             {
-                throw std::ios_base::failure("Failed to open log file: " + LOGFILE_NAME.string());
+                throw std::ios_base::failure("Failed to open log file: " + path.string());
+            }
+            if (_signalFd >= 0)
+            {
+                ::close(_signalFd);
+            }
+            _signalFd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+            if (binary)
+            {
+                // Format ids are only meaningful inside the session that defined them
+                {
+                    std::lock_guard<std::mutex> lock(_formatMutex);
+                    _formatIds.clear();
+                    _session.fetch_add(1, std::memory_order_acq_rel);
+                }
+                std::string header;
+                binarylog::encodeSession<std::chrono::system_clock>(header);
+                _logFile << header;
             }
             Manager::startUp();
+            if (_async)
+            {
+                startWriter();
+            }
             writeLog(Level::Info, "-- Starting the game --");
             writeLog(Level::Debug, "LogManager::startUp");
         }
@@ -39,31 +95,144 @@ namespace noname
     {
         writeLog(Level::Debug, "LogManager::shutDown");
         writeLog(Level::Info, "-- Closing the game --");
+        stopWriter();
+        std::lock_guard<std::mutex> lock(_fileMutex);
         if (_logFile.is_open())
         {
             _logFile.close();
         }
+        if (_signalFd >= 0)
+        {
+            ::close(_signalFd);
+            _signalFd = -1;
+        }
     }
 
     void LogManager::writeLog(Level level, std::string_view message)
     {
-        if (level < _logLevel)
+        if (!isEnabled(level))
         {
             return;
         }
 
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        std::ostringstream stream;
-        stream << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
+        submit(makeRecord(level, message));
+    }
 
+    LogRecord LogManager::makeRecord(Level level, std::string_view message) const
+    {
+        if (_activeOutput.load(std::memory_order_relaxed) == LogOutput::Binary)
+        {
+            std::string encoded;
+            binarylog::encodeRecord(encoded, nowTicks(), static_cast<std::uint8_t>(level),
+                                    binarylog::PLAIN_MESSAGE_FORMAT, message);
+            return {level, {}, std::move(encoded)};
+        }
+        return {level, std::chrono::system_clock::now(), std::string(message)};
+    }
+
+    std::uint32_t LogManager::formatId(std::string_view fmt)
+    {
+        // Lock-free for formats this thread has already seen in the current session
+        thread_local std::unordered_map<const char *, std::uint32_t> known;
+        thread_local std::uint32_t knownSession = 0;
+        auto session = _session.load(std::memory_order_acquire);
+        if (knownSession != session)
+        {
+            known.clear();
+            knownSession = session;
+        }
+        if (auto it = known.find(fmt.data()); it != known.end())
+        {
+            return it->second;
+        }
+
+        std::uint32_t id;
+        bool defined;
+        {
+            std::lock_guard<std::mutex> lock(_formatMutex);
+            auto [it, inserted] = _formatIds.try_emplace(fmt.data(), static_cast<std::uint32_t>(_formatIds.size() + 1));
+            id = it->second;
+            defined = inserted;
+        }
+        if (defined)
+        {
+            // The decoder reads every definition of a session before rendering
+            // it, so this may land after records that already use the id.
+            std::string definition;
+            binarylog::encodeFormat(definition, id, fmt);
+            submit({Level::Info, {}, std::move(definition)});
+        }
+        known.emplace(fmt.data(), id);
+        return id;
+    }
+
+    void LogManager::submit(LogRecord &&record)
+    {
+        // Registering before checking _writerRunning lets stopWriter() wait for
+        // every producer that may still be touching the ring.
+        _ringProducers.fetch_add(1);
+        if (_writerRunning.load())
+        {
+            while (!_ring->tryPush(std::move(record)))
+            {
+                switch (_overflowPolicy.load(std::memory_order_relaxed))
+                {
+                case OverflowPolicy::Block:
+                    // Help the writer instead of just spinning
+                    if (!drainRing(false))
+                    {
+                        std::this_thread::yield();
+                    }
+                    continue;
+                case OverflowPolicy::DropAndCount:
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                case OverflowPolicy::Drop:
+                    break;
+                }
+                break;
+            }
+            _ringProducers.fetch_sub(1, std::memory_order_release);
+            return;
+        }
+        _ringProducers.fetch_sub(1, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(_fileMutex);
         if (_logFile.is_open())
         {
-            _logFile << stream.str() << " : " << message << '\n';
+            std::string line;
+            appendRecord(line, record);
+            _logFile << line;
             _logFile.flush();
         }
     }
 
+    void LogManager::appendRecord(std::string &buffer, const LogRecord &record) const
+    {
+        if (_activeOutput.load(std::memory_order_relaxed) == LogOutput::Binary)
+        {
+            buffer.append(record.message); // Already encoded by the producer
+            return;
+        }
+
+        // The date prefix only changes once per second
+        thread_local std::time_t cachedTime = -1;
+        thread_local char cachedStamp[32];
+        thread_local size_t cachedLength = 0;
+        auto time = std::chrono::system_clock::to_time_t(record.time);
+        if (time != cachedTime)
+        {
+            std::tm local{};
+            localtime_r(&time, &local);
+            cachedLength = std::strftime(cachedStamp, sizeof(cachedStamp), "%Y-%m-%d %H:%M:%S", &local);
+            cachedTime = time;
+        }
+        buffer.append(cachedStamp, cachedLength);
+        buffer.append(" : ");
+        buffer.append(record.message);
+        buffer.push_back('\n');
+    }
+
     Level LogManager::getLevel() const noexcept
     {
         return _logLevel;
@@ -73,4 +242,187 @@ namespace noname
     {
         _logLevel = value;
     }
+
+    void LogManager::setAsync(bool enabled, size_t ringCapacity)
+    {
+        stopWriter();
+        _async = enabled;
+        _ringCapacity = ringCapacity;
+        if (_async && isStarted())
+        {
+            startWriter();
+        }
+    }
+
+    void LogManager::startWriter()
+    {
+        if (_writer.joinable())
+        {
+            return;
+        }
+        // No producer can be inside the ring here: stopWriter() waited for them
+        if (!_ring || _ring->capacity() != LogRingBuffer::roundUpToPowerOfTwo(_ringCapacity))
+        {
+            _ring = std::make_unique<LogRingBuffer>(_ringCapacity);
+        }
+        _stopWriter = false;
+        _writerRunning.store(true);
+        installSignalHandlers();
+        _writer = std::thread([this]()
+        {
+            while (!_stopWriter.load(std::memory_order_acquire))
+            {
+                if (!drainRing())
+                {
+                    std::this_thread::sleep_for(WRITER_IDLE_SLEEP);
+                }
+            }
+            while (drainRing())
+            {
+            }
+        });
+    }
+
+    void LogManager::stopWriter()
+    {
+        if (!_writer.joinable())
+        {
+            return;
+        }
+        _writerRunning.store(false);
+        _stopWriter.store(true, std::memory_order_release);
+        _writer.join();
+        // Producers that saw the writer running may still be pushing
+        while (_ringProducers.load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+        // Records pushed while the writer was stopping
+        while (drainRing())
+        {
+        }
+        restoreSignalHandlers();
+    }
+
+    bool LogManager::drainRing(bool waitForConsumer)
+    {
+        if (!_ring)
+        {
+            return false;
+        }
+
+        // Only one consumer at a time: writer thread, flush() or a signal handler.
+        while (_consumerBusy.test_and_set(std::memory_order_acquire))
+        {
+            if (!waitForConsumer)
+            {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+
+        _batchBuffer.clear();
+        size_t count = 0;
+        LogRecord record;
+        while (count < MAX_BATCH_SIZE && _ring->tryPop(record))
+        {
+            appendRecord(_batchBuffer, record);
+            ++count;
+        }
+
+        auto dropped = _dropped.load(std::memory_order_relaxed);
+        if (dropped != _reportedDrops)
+        {
+            appendRecord(_batchBuffer, makeRecord(Level::Warning,
+                                                  std::to_string(dropped - _reportedDrops) + " log records dropped"));
+            _reportedDrops = dropped;
+        }
+
+        if (!_batchBuffer.empty())
+        {
+            std::lock_guard<std::mutex> lock(_fileMutex);
+            if (_logFile.is_open())
+            {
+                _logFile << _batchBuffer;
+                _logFile.flush();
+            }
+        }
+
+        _consumerBusy.clear(std::memory_order_release);
+        return count > 0;
+    }
+
+    void LogManager::flush()
+    {
+        while (drainRing())
+        {
+        }
+        std::lock_guard<std::mutex> lock(_fileMutex);
+        if (_logFile.is_open())
+        {
+            _logFile.flush();
+        }
+    }
+
+    void LogManager::installSignalHandlers() noexcept
+    {
+        for (size_t i = 0; i < std::size(FATAL_SIGNALS); ++i)
+        {
+            previousHandlers[i] = std::signal(FATAL_SIGNALS[i], &LogManager::handleFatalSignal);
+        }
+    }
+
+    void LogManager::restoreSignalHandlers() noexcept
+    {
+        for (size_t i = 0; i < std::size(FATAL_SIGNALS); ++i)
+        {
+            if (previousHandlers[i] != SIG_ERR)
+            {
+                std::signal(FATAL_SIGNALS[i], previousHandlers[i]);
+            }
+        }
+    }
+
+    void LogManager::handleFatalSignal(int signal)
+    {
+        // Only async-signal-safe work here: no allocation, locks or streams.
+        // Queued records are written as they are (text records without their
+        // date prefix). If the consumer flag is taken, the writer may be the
+        // thread that crashed, so the queue is left alone.
+        auto &logManager = LM;
+        if (logManager._signalFd >= 0 && logManager._ring &&
+            !logManager._consumerBusy.test_and_set(std::memory_order_acquire))
+        {
+            const int fd = logManager._signalFd;
+            const bool binary = logManager._activeOutput.load(std::memory_order_relaxed) == LogOutput::Binary;
+            logManager._ring->drainInPlace([fd, binary](const LogRecord &record)
+            {
+                writeAll(fd, record.message.data(), record.message.size());
+                if (!binary)
+                {
+                    writeAll(fd, "\n", 1);
+                }
+            });
+            logManager._consumerBusy.clear(std::memory_order_release);
+        }
+
+        // Hand the signal over to whoever was installed before us
+        SignalHandler previous = SIG_DFL;
+        for (size_t i = 0; i < std::size(FATAL_SIGNALS); ++i)
+        {
+            if (FATAL_SIGNALS[i] == signal && previousHandlers[i] != SIG_ERR)
+            {
+                previous = previousHandlers[i];
+            }
+        }
+        std::signal(signal, previous);
+        if (previous != SIG_DFL && previous != SIG_IGN)
+        {
+            previous(signal);
+        }
+        else
+        {
+            std::raise(signal);
+        }
+    }
 }
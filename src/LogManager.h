@@ -4,15 +4,26 @@
 #include <fstream>
 #include <string_view>
 #include <filesystem>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
 
 #include "Singleton.h"
 #include "Manager.h"
+#include "LogRingBuffer.h"
+#include "LogFormat.h"
+#include "BinaryLog.h"
 
 #define LM noname::LogManager::getInstance()
 
 namespace noname
 {
     const std::filesystem::path LOGFILE_NAME = "noname.log";
+    const std::filesystem::path BINARY_LOGFILE_NAME = "noname.binlog";
 
     enum class Level
     {
@@ -22,11 +33,85 @@ namespace noname
         Error
     };
 
+    /**
+     * @brief Nivel mínimo compilado
+     *
+     * Las llamadas a log<Level>() de niveles por debajo de NONAME_LOG_MIN_LEVEL
+     * (la opción de CMake del mismo nombre) desaparecen al compilar.
+     */
+#ifndef NONAME_LOG_MIN_LEVEL
+#define NONAME_LOG_MIN_LEVEL 0
+#endif
+    inline constexpr Level COMPILED_LOG_LEVEL = static_cast<Level>(NONAME_LOG_MIN_LEVEL);
+
+    /**
+     * @brief Qué hace un productor asíncrono cuando la cola circular está llena
+     */
+    enum class OverflowPolicy
+    {
+        Block,       // Espera a que el hilo escritor libere una celda
+        Drop,        // Descarta el registro sin avisar
+        DropAndCount // Descarta el registro y apunta en el log cuántos se han perdido
+    };
+
+    /**
+     * @brief Formato del fichero de log
+     */
+    enum class LogOutput
+    {
+        Text,  // Líneas legibles en LOGFILE_NAME
+        Binary // Registros empaquetados en BINARY_LOGFILE_NAME; noname_logdump los pasa a texto
+    };
+
     class LogManager : public Manager, public Singleton<LogManager>
     {
     private:
+        static constexpr size_t DEFAULT_RING_CAPACITY = 8192;
+        static constexpr size_t MAX_BATCH_SIZE = 512;
+        static constexpr std::chrono::milliseconds WRITER_IDLE_SLEEP{1};
+
         std::ofstream _logFile;
-        Level _logLevel{Level::Debug};
+        // El mismo fichero abierto con open(2), para el manejador de señales fatales
+        int _signalFd{-1};
+        std::atomic<Level> _logLevel{Level::Debug};
+        std::mutex _fileMutex;
+
+        // Escritura asíncrona
+        bool _async{false};
+        size_t _ringCapacity{DEFAULT_RING_CAPACITY};
+        std::atomic<OverflowPolicy> _overflowPolicy{OverflowPolicy::Block};
+        std::unique_ptr<LogRingBuffer> _ring;
+        std::thread _writer;
+        std::atomic<bool> _writerRunning{false};
+        std::atomic<unsigned> _ringProducers{0};
+        std::atomic<bool> _stopWriter{false};
+        std::atomic_flag _consumerBusy = ATOMIC_FLAG_INIT;
+        std::atomic<unsigned long long> _dropped{0};
+        unsigned long long _reportedDrops{0};
+        std::string _batchBuffer;
+
+        // Salida binaria
+        LogOutput _output{LogOutput::Text};
+        // Salida de la sesión en curso; startUp() la copia de _output
+        std::atomic<LogOutput> _activeOutput{LogOutput::Text};
+        std::mutex _formatMutex;
+        std::unordered_map<const char *, std::uint32_t> _formatIds;
+        std::atomic<std::uint32_t> _session{0};
+
+        void submit(LogRecord &&record);
+        LogRecord makeRecord(Level level, std::string_view message) const;
+        std::uint32_t formatId(std::string_view fmt);
+        static std::int64_t nowTicks() noexcept
+        {
+            return std::chrono::system_clock::now().time_since_epoch().count();
+        }
+        void startWriter();
+        void stopWriter();
+        bool drainRing(bool waitForConsumer = true);
+        void appendRecord(std::string &buffer, const LogRecord &record) const;
+        void installSignalHandlers() noexcept;
+        void restoreSignalHandlers() noexcept;
+        static void handleFatalSignal(int signal);
 
     public:
         ~LogManager() override;
@@ -36,7 +121,72 @@ namespace noname
 
         void writeLog(Level level, std::string_view message);
 
+        /**
+         * @brief Log con formato diferido
+         *
+         * Primero se comprueba el nivel y solo se rellenan los huecos "{}" de
+         * fmt si la línea se va a escribir. Los niveles por debajo de
+         * COMPILED_LOG_LEVEL no generan código. En salida binaria los
+         * argumentos se empaquetan tal cual y fmt se escribe una sola vez por
+         * sesión, así que fmt debe ser un literal de cadena.
+         */
+        template <Level L, typename... Args>
+        void log(std::string_view fmt, const Args &...args)
+        {
+            if constexpr (L < COMPILED_LOG_LEVEL)
+            {
+                return;
+            }
+            else
+            {
+                if (!isEnabled(L))
+                {
+                    return;
+                }
+                thread_local std::string line;
+                line.clear();
+                if (_activeOutput.load(std::memory_order_relaxed) == LogOutput::Binary)
+                {
+                    binarylog::encodeRecord(line, nowTicks(), static_cast<std::uint8_t>(L), formatId(fmt), args...);
+                    submit({L, {}, line});
+                    return;
+                }
+                logformat::formatTo(line, fmt, args...);
+                writeLog(L, line);
+            }
+        }
+
+        [[nodiscard]] bool isEnabled(Level level) const noexcept
+        {
+            return level >= COMPILED_LOG_LEVEL && level >= _logLevel.load(std::memory_order_relaxed);
+        }
+
         [[nodiscard]] Level getLevel() const noexcept;
         void setLevel(Level value) noexcept;
+
+        /**
+         * @brief Modo asíncrono
+         *
+         * Quien escribe mete el registro en una cola circular sin bloqueos y un
+         * hilo en segundo plano lo escribe por lotes. Se aplica en el acto si
+         * el gestor está arrancado y, si no, en startUp().
+         */
+        void setAsync(bool enabled, size_t ringCapacity = DEFAULT_RING_CAPACITY);
+        [[nodiscard]] bool isAsync() const noexcept { return _async; }
+
+        void setOverflowPolicy(OverflowPolicy policy) noexcept { _overflowPolicy = policy; }
+        [[nodiscard]] OverflowPolicy getOverflowPolicy() const noexcept { return _overflowPolicy; }
+        [[nodiscard]] unsigned long long getDroppedCount() const noexcept { return _dropped; }
+
+        /**
+         * @brief Formato del fichero; se aplica en el siguiente startUp()
+         */
+        void setOutput(LogOutput output) noexcept { _output = output; }
+        [[nodiscard]] LogOutput getOutput() const noexcept { return _output; }
+
+        /**
+         * @brief Escribe todos los registros encolados antes de volver
+         */
+        void flush();
     };
 }
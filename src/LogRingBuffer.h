@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace noname
+{
+    enum class Level;
+
+    /**
+     * @brief Registro pendiente de escribir en el log
+     */
+    struct LogRecord
+    {
+        Level level;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+    };
+
+    /**
+     * @brief Cola circular acotada sin bloqueos para varios productores y un consumidor
+     *
+     * Cada celda lleva un número de secuencia que indica si está libre para el
+     * productor de esa vuelta o lista para el consumidor. Los productores se
+     * reparten las posiciones con un compare-exchange; el único consumidor
+     * avanza sin operaciones atómicas de lectura-modificación-escritura.
+     */
+    class LogRingBuffer
+    {
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence{0};
+            LogRecord record{};
+        };
+
+        static constexpr size_t CACHE_LINE = 64;
+
+        std::unique_ptr<Cell[]> _cells;
+        size_t _mask;
+        alignas(CACHE_LINE) std::atomic<size_t> _enqueuePos{0};
+        alignas(CACHE_LINE) std::atomic<size_t> _dequeuePos{0};
+
+    public:
+        static size_t roundUpToPowerOfTwo(size_t value) noexcept
+        {
+            size_t result = 2;
+            while (result < value)
+            {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        explicit LogRingBuffer(size_t capacity)
+            : _cells{std::make_unique<Cell[]>(roundUpToPowerOfTwo(capacity))},
+              _mask{roundUpToPowerOfTwo(capacity) - 1}
+        {
+            for (size_t i = 0; i <= _mask; ++i)
+            {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        LogRingBuffer(const LogRingBuffer &) = delete;
+        LogRingBuffer &operator=(const LogRingBuffer &) = delete;
+
+        [[nodiscard]] size_t capacity() const noexcept { return _mask + 1; }
+
+        /**
+         * @brief Inserta un registro (seguro desde varios hilos)
+         * @return false si la cola está llena
+         */
+        bool tryPush(LogRecord &&record)
+        {
+            size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+            Cell *cell;
+            for (;;)
+            {
+                cell = &_cells[pos & _mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+                if (difference == 0)
+                {
+                    if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+            cell->record = std::move(record);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Extrae un registro (solo desde el consumidor)
+         * @return false si la cola está vacía
+         */
+        bool tryPop(LogRecord &record)
+        {
+            size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            Cell &cell = _cells[pos & _mask];
+            if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+            {
+                return false;
+            }
+            record = std::move(cell.record);
+            cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+            _dequeuePos.store(pos + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * @brief Entrega a visit cada registro listo y libera su celda, sin moverlo
+         *
+         * No reserva ni libera memoria (el texto se libera al reutilizar la
+         * celda), así que sirve desde un manejador de señales. Solo desde el
+         * consumidor.
+         */
+        template <typename F>
+        void drainInPlace(F &&visit) noexcept
+        {
+            size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = _cells[pos & _mask];
+                if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+                {
+                    break;
+                }
+                visit(static_cast<const LogRecord &>(cell.record));
+                cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+                _dequeuePos.store(++pos, std::memory_order_relaxed);
+            }
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return _dequeuePos.load(std::memory_order_acquire) == _enqueuePos.load(std::memory_order_acquire);
+        }
+    };
+}
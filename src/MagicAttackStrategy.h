@@ -23,9 +23,8 @@ namespace noname
                            const std::shared_ptr<Weapon>& weapon) const override {
             // Verificar si hay suficiente mana
             if (attacker.getCurrentMana() < manaCost_) {
-                LM.writeLog(Level::Debug, "Not enough mana for magic attack. Required: " + 
-                           std::to_string(manaCost_) + ", Available: " + 
-                           std::to_string(attacker.getCurrentMana()));
+                LM.log<Level::Debug>("Not enough mana for magic attack. Required: {}, Available: {}",
+                                     manaCost_, attacker.getCurrentMana());
                 return 0;
             }
             
@@ -52,11 +51,8 @@ namespace noname
             
             int totalDamage = baseDamage + intelligenceBonus + weaponBonus;
             
-            LM.writeLog(Level::Debug, "Magic damage calculation: base(" + std::to_string(baseDamage) + 
-                       ") + intelligence(" + std::to_string(intelligenceBonus) + 
-                       ") + weapon_bonus(" + std::to_string(weaponBonus) + 
-                       ") = " + std::to_string(totalDamage) + 
-                       " [Mana cost: " + std::to_string(manaCost_) + "]");
+            LM.log<Level::Debug>("Magic damage calculation: base({}) + intelligence({}) + weapon_bonus({}) = {} [Mana cost: {}]",
+                                 baseDamage, intelligenceBonus, weaponBonus, totalDamage, manaCost_);
             
             return totalDamage;
         }
@@ -117,8 +113,7 @@ namespace noname
                 if (roll <= criticalChance) {
                     lastWasCritical = true;
                     baseDamage *= 2;
-                    LM.writeLog(Level::Debug, "Critical magic attack! Damage doubled (roll: " + 
-                               std::to_string(roll) + " vs " + std::to_string(criticalChance) + "%)");
+                    LM.log<Level::Debug>("Critical magic attack! Damage doubled (roll: {} vs {}%)", roll, criticalChance);
                 } else {
                     lastWasCritical = false;
                 }
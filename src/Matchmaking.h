@@ -0,0 +1,410 @@
+#ifndef __MATCHMAKING_H__
+#define __MATCHMAKING_H__
+
+// System includes
+#include <array>
+#include <vector>
+#include <span>
+#include <utility>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+// Local includes
+#include "Heritables.h"
+#include "FlatIdMap.h"
+#include "WorkerPool.h"
+
+namespace noname
+{
+    /**
+     * @brief Pareja candidata y su distancia (ponderada, al cuadrado) en heritables
+     */
+    struct MatchCandidate
+    {
+        int id;
+        float distance;
+    };
+
+    /**
+     * @brief Árbol k-d sobre los heritables de los candidatos
+     *
+     * Se construye de una vez sobre un array de puntos que se reordena en su
+     * sitio: el nodo de cada rango [begin, end) es la mediana, partida por el
+     * eje de mayor dispersión, y los rangos pequeños se recorren linealmente.
+     * Las consultas no modifican el árbol, así que pueden hacerse desde
+     * varios hilos a la vez.
+     */
+    class HeritablesKdTree
+    {
+    public:
+        static constexpr size_t DIMENSIONS = static_cast<size_t>(HeritableType::LAST_HERITABLE);
+        using Point = std::array<float, DIMENSIONS>;
+        static constexpr size_t LEAF_SIZE = 8;
+
+    private:
+        std::vector<Point> _points;
+        std::vector<int> _ids;
+        std::vector<std::uint8_t> _axes; // Eje de corte del nodo en la mediana de cada rango
+
+        static float squaredDistance(const Point &a, const Point &b) noexcept
+        {
+            float sum = 0.0f;
+            for (size_t axis = 0; axis < DIMENSIONS; ++axis)
+            {
+                const float diff = a[axis] - b[axis];
+                sum += diff * diff;
+            }
+            return sum;
+        }
+
+        void build(size_t begin, size_t end, std::vector<size_t> &order, const std::vector<Point> &points)
+        {
+            if (end - begin <= LEAF_SIZE)
+            {
+                return;
+            }
+            Point low, high;
+            low.fill(std::numeric_limits<float>::max());
+            high.fill(std::numeric_limits<float>::lowest());
+            for (size_t i = begin; i < end; ++i)
+            {
+                for (size_t axis = 0; axis < DIMENSIONS; ++axis)
+                {
+                    low[axis] = std::min(low[axis], points[order[i]][axis]);
+                    high[axis] = std::max(high[axis], points[order[i]][axis]);
+                }
+            }
+            size_t axis = 0;
+            for (size_t candidate = 1; candidate < DIMENSIONS; ++candidate)
+            {
+                if (high[candidate] - low[candidate] > high[axis] - low[axis])
+                {
+                    axis = candidate;
+                }
+            }
+            const size_t middle = begin + (end - begin) / 2;
+            std::nth_element(order.begin() + static_cast<std::ptrdiff_t>(begin), order.begin() + static_cast<std::ptrdiff_t>(middle),
+                             order.begin() + static_cast<std::ptrdiff_t>(end),
+                             [&points, axis](size_t a, size_t b) { return points[a][axis] < points[b][axis]; });
+            _axes[middle] = static_cast<std::uint8_t>(axis);
+            build(begin, middle, order, points);
+            build(middle + 1, end, order, points);
+        }
+
+        template <typename Skip>
+        void search(size_t begin, size_t end, const Point &query, size_t k, const Skip &skip, std::vector<MatchCandidate> &heap) const
+        {
+            auto consider = [&](size_t i) {
+                if (skip(_ids[i]))
+                {
+                    return;
+                }
+                const float distance = squaredDistance(_points[i], query);
+                if (heap.size() < k)
+                {
+                    heap.push_back({_ids[i], distance});
+                    std::push_heap(heap.begin(), heap.end(), farther);
+                }
+                else if (distance < heap.front().distance)
+                {
+                    std::pop_heap(heap.begin(), heap.end(), farther);
+                    heap.back() = {_ids[i], distance};
+                    std::push_heap(heap.begin(), heap.end(), farther);
+                }
+            };
+            if (end - begin <= LEAF_SIZE)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    consider(i);
+                }
+                return;
+            }
+            const size_t middle = begin + (end - begin) / 2;
+            const size_t axis = _axes[middle];
+            const float split = query[axis] - _points[middle][axis];
+            consider(middle);
+            // Primero el lado de la consulta; el otro solo si la esfera actual lo corta
+            if (split < 0.0f)
+            {
+                search(begin, middle, query, k, skip, heap);
+                if (heap.size() < k || split * split < heap.front().distance)
+                {
+                    search(middle + 1, end, query, k, skip, heap);
+                }
+            }
+            else
+            {
+                search(middle + 1, end, query, k, skip, heap);
+                if (heap.size() < k || split * split < heap.front().distance)
+                {
+                    search(begin, middle, query, k, skip, heap);
+                }
+            }
+        }
+
+        static bool farther(const MatchCandidate &a, const MatchCandidate &b) noexcept
+        {
+            return a.distance < b.distance;
+        }
+
+    public:
+        /**
+         * @brief Construye el árbol; points[i] es el punto del candidato ids[i]
+         */
+        void build(std::vector<Point> points, std::vector<int> ids)
+        {
+            std::vector<size_t> order(points.size());
+            std::iota(order.begin(), order.end(), size_t{0});
+            _axes.assign(points.size(), 0);
+            build(0, points.size(), order, points);
+            _points.resize(points.size());
+            _ids.resize(ids.size());
+            for (size_t i = 0; i < order.size(); ++i)
+            {
+                _points[i] = points[order[i]];
+                _ids[i] = ids[order[i]];
+            }
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return _ids.size(); }
+
+        /**
+         * @brief Los k puntos más cercanos a query, del más cercano al más lejano
+         * @param skip skip(id) descarta candidatos (el propio personaje, los ya emparejados...)
+         */
+        template <typename Skip>
+        void findNearest(const Point &query, size_t k, const Skip &skip, std::vector<MatchCandidate> &out) const
+        {
+            out.clear();
+            if (k == 0 || _ids.empty())
+            {
+                return;
+            }
+            out.reserve(k);
+            search(0, _ids.size(), query, k, skip, out);
+            std::sort_heap(out.begin(), out.end(), farther);
+        }
+    };
+
+    /**
+     * @brief Servicio de búsqueda de pareja por heritables
+     *
+     * Indexa a los candidatos por su vector de heritables ponderado: la
+     * compatibilidad es la distancia euclídea con esos pesos, así que los
+     * mejores k candidatos para alguien son sus k vecinos más cercanos en el
+     * árbol k-d. Por defecto CHARISMA y GOOD_LOOKING pesan el doble.
+     *
+     * pairGeneration() empareja a toda una generación: las búsquedas de cada
+     * ronda se hacen en paralelo en un WorkerPool y luego se resuelven en
+     * orden de atractivo (CHARISMA + GOOD_LOOKING), de modo que los más
+     * atractivos eligen antes, como dice TODOS.md.
+     */
+    class Matchmaker
+    {
+    public:
+        using Point = HeritablesKdTree::Point;
+        using Weights = std::array<float, HeritablesKdTree::DIMENSIONS>;
+        static constexpr Weights DEFAULT_WEIGHTS{1.0f, 1.0f, 1.0f, 1.0f, 2.0f, 2.0f};
+
+    private:
+        Weights _weights;
+        Point _scale; // Raíz de cada peso: la distancia euclídea escalada es la ponderada
+        std::vector<int> _ids;
+        std::vector<Point> _points;
+        std::vector<int> _appeal;
+        FlatIdMap<std::uint32_t> _index;
+        HeritablesKdTree _tree;
+
+        void buildTree(const std::vector<std::uint32_t> &members)
+        {
+            std::vector<Point> points;
+            std::vector<int> ids;
+            points.reserve(members.size());
+            ids.reserve(members.size());
+            for (std::uint32_t member : members)
+            {
+                points.push_back(_points[member]);
+                ids.push_back(_ids[member]);
+            }
+            _tree.build(std::move(points), std::move(ids));
+        }
+
+    public:
+        explicit Matchmaker(const Weights &weights = DEFAULT_WEIGHTS) : _weights(weights)
+        {
+            for (size_t axis = 0; axis < _scale.size(); ++axis)
+            {
+                _scale[axis] = std::sqrt(std::max(0.0f, weights[axis]));
+            }
+        }
+
+        [[nodiscard]] const Weights &getWeights() const noexcept { return _weights; }
+
+        /**
+         * @brief Añade un candidato; no entra en las búsquedas hasta build()
+         */
+        void add(int id, const std::array<short, HeritablesKdTree::DIMENSIONS> &heritables)
+        {
+            if (!_index.tryEmplace(id, static_cast<std::uint32_t>(_ids.size())).second)
+            {
+                return;
+            }
+            Point point;
+            for (size_t axis = 0; axis < point.size(); ++axis)
+            {
+                point[axis] = static_cast<float>(heritables[axis]) * _scale[axis];
+            }
+            _ids.push_back(id);
+            _points.push_back(point);
+            _appeal.push_back(heritables[static_cast<size_t>(HeritableType::CHARISMA)] + heritables[static_cast<size_t>(HeritableType::GOOD_LOOKING)]);
+        }
+
+        /**
+         * @brief Añade un personaje (necesita getId() y getHeritable())
+         */
+        template <typename T>
+        void add(const T &character)
+        {
+            std::array<short, HeritablesKdTree::DIMENSIONS> heritables;
+            for (size_t axis = 0; axis < heritables.size(); ++axis)
+            {
+                heritables[axis] = character.getHeritable(static_cast<HeritableType>(axis));
+            }
+            add(character.getId(), heritables);
+        }
+
+        template <typename T>
+        void addAll(std::span<const T *const> characters)
+        {
+            reserve(_ids.size() + characters.size());
+            for (const T *character : characters)
+            {
+                add(*character);
+            }
+        }
+
+        void reserve(size_t count)
+        {
+            _ids.reserve(count);
+            _points.reserve(count);
+            _appeal.reserve(count);
+            _index.reserve(count);
+        }
+
+        /**
+         * @brief Indexa a todos los candidatos añadidos
+         */
+        void build()
+        {
+            std::vector<std::uint32_t> all(_ids.size());
+            std::iota(all.begin(), all.end(), std::uint32_t{0});
+            buildTree(all);
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return _ids.size(); }
+
+        /**
+         * @brief Los k candidatos más compatibles con id, del mejor al peor
+         * @param accept accept(id, candidate) descarta parejas (parentesco, facciones...)
+         */
+        template <typename Accept>
+        void findPartners(int id, size_t k, const Accept &accept, std::vector<MatchCandidate> &out) const
+        {
+            const std::uint32_t *member = _index.find(id);
+            if (!member)
+            {
+                out.clear();
+                return;
+            }
+            _tree.findNearest(_points[*member], k, [id, &accept](int candidate) { return candidate == id || !accept(id, candidate); }, out);
+        }
+
+        [[nodiscard]] std::vector<MatchCandidate> findPartners(int id, size_t k) const
+        {
+            std::vector<MatchCandidate> out;
+            findPartners(id, k, [](int, int) { return true; }, out);
+            return out;
+        }
+
+        /**
+         * @brief Empareja a los candidatos de dos en dos
+         *
+         * En cada ronda cada candidato libre busca sus k mejores parejas en
+         * paralelo; después, en orden de atractivo, cada uno se queda con la
+         * primera de su lista que siga libre. Los que se quedan sin opciones
+         * vuelven a buscar en la siguiente ronda sobre un árbol con solo los
+         * libres. El resultado es determinista aunque cambie el número de hilos.
+         * accept se llama desde varios hilos a la vez.
+         *
+         * @return Parejas (id, id)
+         */
+        template <typename Accept>
+        std::vector<std::pair<int, int>> pairGeneration(WorkerPool &pool, const Accept &accept, size_t k = 8, int maxRounds = 4)
+        {
+            std::vector<std::pair<int, int>> pairs;
+            std::vector<std::uint8_t> taken(_ids.size(), 0);
+            std::vector<std::uint32_t> pending(_ids.size());
+            std::iota(pending.begin(), pending.end(), std::uint32_t{0});
+            // Los más atractivos eligen primero; a igual atractivo, por orden de alta
+            std::stable_sort(pending.begin(), pending.end(), [this](std::uint32_t a, std::uint32_t b) { return _appeal[a] > _appeal[b]; });
+
+            std::vector<std::vector<MatchCandidate>> proposals;
+            for (int round = 0; round < maxRounds && pending.size() > 1; ++round)
+            {
+                buildTree(pending);
+                proposals.resize(pending.size());
+                pool.parallelFor(pending.size(), 256, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        findPartners(_ids[pending[i]], k, accept, proposals[i]);
+                    }
+                });
+
+                std::vector<std::uint32_t> unmatched;
+                for (size_t i = 0; i < pending.size(); ++i)
+                {
+                    const std::uint32_t member = pending[i];
+                    if (taken[member])
+                    {
+                        continue;
+                    }
+                    bool matched = false;
+                    for (const auto &candidate : proposals[i])
+                    {
+                        const std::uint32_t partner = *_index.find(candidate.id);
+                        if (!taken[partner])
+                        {
+                            taken[member] = taken[partner] = 1;
+                            pairs.emplace_back(_ids[member], candidate.id);
+                            matched = true;
+                            break;
+                        }
+                    }
+                    if (!matched && !proposals[i].empty())
+                    {
+                        unmatched.push_back(member);
+                    }
+                }
+                // Quien no tuvo ninguna propuesta aceptable no la tendrá con menos candidatos
+                std::erase_if(unmatched, [&taken](std::uint32_t member) { return taken[member] != 0; });
+                pending.swap(unmatched);
+            }
+            // El árbol vuelve a tener a todos los candidatos
+            build();
+            return pairs;
+        }
+
+        std::vector<std::pair<int, int>> pairGeneration(WorkerPool &pool, size_t k = 8, int maxRounds = 4)
+        {
+            return pairGeneration(pool, [](int, int) { return true; }, k, maxRounds);
+        }
+    };
+}
+
+#endif // __MATCHMAKING_H__
@@ -28,7 +28,7 @@ namespace noname
             lastHitRoll = hitRoll;
             
             if (hitRoll <= 1) {
-                LM.writeLog(Level::Debug, "Attack missed with roll: " + std::to_string(hitRoll));
+                LM.log<Level::Debug>("Attack missed with roll: {}", hitRoll);
                 return 0; // Miss
             }
             
@@ -38,7 +38,7 @@ namespace noname
             // Aplicar críticos
             if (hitRoll >= 20) {
                 baseDamage *= getCriticalMultiplier();
-                LM.writeLog(Level::Debug, "Critical hit! Damage doubled");
+                LM.log<Level::Debug>("Critical hit! Damage doubled");
             }
             
             // Agregar bonus de skill
@@ -50,10 +50,8 @@ namespace noname
             
             int totalDamage = baseDamage + skillBonus + strengthBonus;
             
-            LM.writeLog(Level::Debug, "Melee damage calculation: base(" + std::to_string(baseDamage) + 
-                       ") + skill(" + std::to_string(skillBonus) + 
-                       ") + strength(" + std::to_string(strengthBonus) + 
-                       ") = " + std::to_string(totalDamage));
+            LM.log<Level::Debug>("Melee damage calculation: base({}) + skill({}) + strength({}) = {}",
+                                 baseDamage, skillBonus, strengthBonus, totalDamage);
             
             return totalDamage;
         }
@@ -84,7 +82,7 @@ namespace noname
             lastHitRoll = roll;
             
             if (roll <= 1) {
-                LM.writeLog(Level::Debug, "Unarmed attack missed with roll: " + std::to_string(roll));
+                LM.log<Level::Debug>("Unarmed attack missed with roll: {}", roll);
                 return 0;
             }
             
@@ -94,7 +92,7 @@ namespace noname
             // Aplicar críticos
             if (roll >= 20) {
                 baseDamage *= getCriticalMultiplier();
-                LM.writeLog(Level::Debug, "Critical unarmed hit!");
+                LM.log<Level::Debug>("Critical unarmed hit!");
             }
             
             int skillBonus = attacker.getSkill(SkillType::FIST);
@@ -102,10 +100,8 @@ namespace noname
             
             int totalDamage = baseDamage + skillBonus + strengthBonus;
             
-            LM.writeLog(Level::Debug, "Unarmed damage: base(" + std::to_string(baseDamage) + 
-                       ") + fist_skill(" + std::to_string(skillBonus) + 
-                       ") + strength(" + std::to_string(strengthBonus) + 
-                       ") = " + std::to_string(totalDamage));
+            LM.log<Level::Debug>("Unarmed damage: base({}) + fist_skill({}) + strength({}) = {}",
+                                 baseDamage, skillBonus, strengthBonus, totalDamage);
             
             return totalDamage;
         }
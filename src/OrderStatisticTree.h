@@ -0,0 +1,376 @@
+#ifndef __ORDER_STATISTIC_TREE_H__
+#define __ORDER_STATISTIC_TREE_H__
+
+// System includes
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <algorithm>
+#include <optional>
+
+namespace noname
+{
+    /**
+     * @brief Conjunto ordenado con consultas de posición (treap aumentado)
+     *
+     * Cada nodo guarda el tamaño de su subárbol, así que además de insertar y
+     * borrar en O(log n) esperado se puede obtener la posición de una clave
+     * (rank) y la clave en una posición (select) en O(log n). Los nodos viven
+     * en un vector y se enlazan por índice; los huecos de los borrados se
+     * reutilizan.
+     */
+    template <typename Key, typename Compare = std::less<Key>>
+    class OrderStatisticTree
+    {
+    private:
+        using Index = std::uint32_t;
+        static constexpr Index NIL = 0; // El nodo 0 es el centinela vacío
+
+        struct Node
+        {
+            Key key{};
+            Index left{NIL};
+            Index right{NIL};
+            Index size{0};
+            std::uint32_t priority{0};
+        };
+
+        std::vector<Node> _nodes{Node{}};
+        std::vector<Index> _free;
+        Index _root{NIL};
+        Compare _less{};
+        std::uint32_t _seed{0x9E3779B9u};
+
+        std::uint32_t nextPriority() noexcept
+        {
+            // xorshift32: suficiente para equilibrar el treap
+            _seed ^= _seed << 13;
+            _seed ^= _seed >> 17;
+            _seed ^= _seed << 5;
+            return _seed;
+        }
+
+        void update(Index node) noexcept
+        {
+            _nodes[node].size = 1 + _nodes[_nodes[node].left].size + _nodes[_nodes[node].right].size;
+        }
+
+        Index newNode(const Key &key)
+        {
+            Index node;
+            if (!_free.empty())
+            {
+                node = _free.back();
+                _free.pop_back();
+            }
+            else
+            {
+                node = static_cast<Index>(_nodes.size());
+                _nodes.emplace_back();
+            }
+            _nodes[node] = Node{key, NIL, NIL, 1, nextPriority()};
+            return node;
+        }
+
+        // Separa en (< key) y (>= key)
+        void split(Index node, const Key &key, Index &left, Index &right)
+        {
+            if (node == NIL)
+            {
+                left = right = NIL;
+                return;
+            }
+            if (_less(_nodes[node].key, key))
+            {
+                split(_nodes[node].right, key, _nodes[node].right, right);
+                left = node;
+            }
+            else
+            {
+                split(_nodes[node].left, key, left, _nodes[node].left);
+                right = node;
+            }
+            update(node);
+        }
+
+        Index merge(Index left, Index right)
+        {
+            if (left == NIL || right == NIL)
+            {
+                return left == NIL ? right : left;
+            }
+            if (_nodes[left].priority > _nodes[right].priority)
+            {
+                _nodes[left].right = merge(_nodes[left].right, right);
+                update(left);
+                return left;
+            }
+            _nodes[right].left = merge(left, _nodes[right].left);
+            update(right);
+            return right;
+        }
+
+        bool equal(const Key &a, const Key &b) const
+        {
+            return !_less(a, b) && !_less(b, a);
+        }
+
+        bool eraseFrom(Index &node, const Key &key)
+        {
+            if (node == NIL)
+            {
+                return false;
+            }
+            Node &n = _nodes[node];
+            bool removed;
+            if (_less(key, n.key))
+            {
+                removed = eraseFrom(n.left, key);
+            }
+            else if (_less(n.key, key))
+            {
+                removed = eraseFrom(n.right, key);
+            }
+            else
+            {
+                _free.push_back(node);
+                node = merge(n.left, n.right);
+                return true;
+            }
+            if (removed)
+            {
+                update(node);
+            }
+            return removed;
+        }
+
+        template <typename F>
+        void visitRange(Index node, size_t from, size_t to, size_t offset, F &visit) const
+        {
+            // Visita en orden las posiciones [from, to) del subárbol que empieza en offset
+            while (node != NIL)
+            {
+                const Node &n = _nodes[node];
+                const size_t position = offset + _nodes[n.left].size;
+                if (from < position)
+                {
+                    visitRange(n.left, from, to, offset, visit);
+                }
+                if (position >= to)
+                {
+                    return;
+                }
+                if (position >= from)
+                {
+                    visit(position, n.key);
+                }
+                offset = position + 1;
+                node = n.right;
+            }
+        }
+
+    public:
+        OrderStatisticTree() = default;
+        explicit OrderStatisticTree(Compare less) : _less(std::move(less)) {}
+
+        [[nodiscard]] size_t size() const noexcept { return _nodes[_root].size; }
+        [[nodiscard]] bool empty() const noexcept { return _root == NIL; }
+
+        void clear()
+        {
+            _nodes.assign(1, Node{});
+            _free.clear();
+            _root = NIL;
+        }
+
+        void reserve(size_t count) { _nodes.reserve(count + 1); }
+
+        /**
+         * @brief Inserta una clave
+         * @return false si ya existía
+         */
+        bool insert(const Key &key)
+        {
+            Index less, rest;
+            split(_root, key, less, rest);
+            if (rest != NIL)
+            {
+                // El menor de rest es el candidato a igual
+                Index node = rest;
+                while (_nodes[node].left != NIL)
+                {
+                    node = _nodes[node].left;
+                }
+                if (equal(_nodes[node].key, key))
+                {
+                    _root = merge(less, rest);
+                    return false;
+                }
+            }
+            Index node = newNode(key);
+            _root = merge(merge(less, node), rest);
+            return true;
+        }
+
+        /**
+         * @brief Borra una clave
+         * @return false si no existía
+         */
+        bool erase(const Key &key)
+        {
+            return eraseFrom(_root, key);
+        }
+
+        [[nodiscard]] bool contains(const Key &key) const
+        {
+            Index node = _root;
+            while (node != NIL)
+            {
+                if (_less(key, _nodes[node].key))
+                {
+                    node = _nodes[node].left;
+                }
+                else if (_less(_nodes[node].key, key))
+                {
+                    node = _nodes[node].right;
+                }
+                else
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Posición (desde 0) de una clave en el orden, o nullopt si no existe
+         */
+        [[nodiscard]] std::optional<size_t> rank(const Key &key) const
+        {
+            size_t position = 0;
+            Index node = _root;
+            while (node != NIL)
+            {
+                const Node &n = _nodes[node];
+                if (_less(key, n.key))
+                {
+                    node = n.left;
+                }
+                else if (_less(n.key, key))
+                {
+                    position += _nodes[n.left].size + 1;
+                    node = n.right;
+                }
+                else
+                {
+                    return position + _nodes[n.left].size;
+                }
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Clave en la posición indicada (0 <= position < size())
+         */
+        [[nodiscard]] const Key &select(size_t position) const
+        {
+            Index node = _root;
+            for (;;)
+            {
+                const Node &n = _nodes[node];
+                const size_t leftSize = _nodes[n.left].size;
+                if (position < leftSize)
+                {
+                    node = n.left;
+                }
+                else if (position == leftSize)
+                {
+                    return n.key;
+                }
+                else
+                {
+                    position -= leftSize + 1;
+                    node = n.right;
+                }
+            }
+        }
+
+        /**
+         * @brief Llama a visit(posición, clave) para las posiciones [from, from + count)
+         *
+         * Cuesta O(log n + count): no recorre las claves anteriores a from.
+         */
+        template <typename F>
+        void forEachInRange(size_t from, size_t count, F &&visit) const
+        {
+            const size_t to = std::min(size(), from + std::min(count, size()));
+            if (from < to)
+            {
+                visitRange(_root, from, to, 0, visit);
+            }
+        }
+
+        template <typename F>
+        void forEach(F &&visit) const
+        {
+            forEachInRange(0, size(), visit);
+        }
+
+        /**
+         * @brief Sustituye el contenido por claves ya ordenadas y sin repetir, en O(n)
+         *
+         * Construye el árbol cartesiano de las prioridades con una pila, en
+         * lugar de n inserciones de O(log n).
+         */
+        void assignSorted(const std::vector<Key> &keys)
+        {
+            clear();
+            _nodes.reserve(keys.size() + 1);
+            std::vector<Index> stack;
+            for (const auto &key : keys)
+            {
+                Index node = newNode(key);
+                Index last = NIL;
+                while (!stack.empty() && _nodes[stack.back()].priority < _nodes[node].priority)
+                {
+                    last = stack.back();
+                    stack.pop_back();
+                }
+                _nodes[node].left = last;
+                if (!stack.empty())
+                {
+                    _nodes[stack.back()].right = node;
+                }
+                stack.push_back(node);
+            }
+            _root = stack.empty() ? NIL : stack.front();
+            // Tamaños de abajo arriba: en orden posterior
+            if (_root != NIL)
+            {
+                std::vector<std::pair<Index, bool>> pending{{_root, false}};
+                while (!pending.empty())
+                {
+                    auto [node, childrenDone] = pending.back();
+                    pending.pop_back();
+                    if (childrenDone)
+                    {
+                        update(node);
+                        continue;
+                    }
+                    pending.push_back({node, true});
+                    if (_nodes[node].left != NIL)
+                    {
+                        pending.push_back({_nodes[node].left, false});
+                    }
+                    if (_nodes[node].right != NIL)
+                    {
+                        pending.push_back({_nodes[node].right, false});
+                    }
+                }
+            }
+        }
+    };
+}
+
+#endif // __ORDER_STATISTIC_TREE_H__
@@ -19,7 +19,7 @@ namespace noname
 
         void getInfoForRanking(HtmlBuilder &builder, const SkillType &skill)
         {
-            builder.add_child(HtmlBuilder{"tr"}.add_child("td", _id.toString()).add_child("td", _level.toString()).add_child("td", std::to_string(skills.at(Utils::toInt(skill)))));
+            builder.add_child(HtmlBuilder{"tr"}.add_child("td", _id.toString()).add_child("td", _level.toString()).add_child("td", std::to_string(skills().at(Utils::toInt(skill)))));
         }
     };
 }
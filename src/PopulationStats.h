@@ -0,0 +1,538 @@
+#ifndef __POPULATION_STATS_H__
+#define __POPULATION_STATS_H__
+
+// System includes
+#include <array>
+#include <vector>
+#include <span>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__SSE2__) && !defined(NONAME_NO_SIMD)
+#define NONAME_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Local includes
+#include "Heritables.h"
+#include "CharacterStore.h"
+#include "WorkerPool.h"
+
+namespace noname
+{
+    /**
+     * @brief Estadísticas de un atributo entero de una población
+     *
+     * El histograma es exacto, un contador por valor entre min y max, así que
+     * los cuantiles también lo son.
+     */
+    struct AttributeStats
+    {
+        size_t count{0};
+        std::int64_t sum{0};
+        std::uint64_t sumSquares{0};
+        int min{0};
+        int max{0};
+        // histogram[v - min]: cuántas veces aparece el valor v (vacío si no se pidió)
+        std::vector<std::uint32_t> histogram;
+
+        [[nodiscard]] double mean() const noexcept
+        {
+            return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+        }
+
+        // Varianza de la población (dividida entre count)
+        [[nodiscard]] double variance() const noexcept
+        {
+            if (!count)
+            {
+                return 0.0;
+            }
+            const double n = static_cast<double>(count);
+            const double mean = static_cast<double>(sum) / n;
+            return std::max(0.0, static_cast<double>(sumSquares) / n - mean * mean);
+        }
+
+        [[nodiscard]] double stddev() const noexcept { return std::sqrt(variance()); }
+
+        /**
+         * @brief Menor valor v tal que al menos q * count valores son <= v
+         *
+         * Necesita el histograma; sin él devuelve min.
+         */
+        [[nodiscard]] int quantile(double q) const noexcept
+        {
+            if (histogram.empty())
+            {
+                return min;
+            }
+            const auto rank = static_cast<std::uint64_t>(std::max(1.0, std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count))));
+            std::uint64_t seen = 0;
+            for (size_t bin = 0; bin < histogram.size(); ++bin)
+            {
+                seen += histogram[bin];
+                if (seen >= rank)
+                {
+                    return min + static_cast<int>(bin);
+                }
+            }
+            return max;
+        }
+    };
+
+    namespace populationstats
+    {
+        /**
+         * @brief Sumas, sumas de cuadrados y extremos de N atributos intercalados
+         */
+        template <typename T, size_t N>
+        struct Moments
+        {
+            size_t count{0};
+            std::array<std::int64_t, N> sum{};
+            std::array<std::uint64_t, N> sumSquares{};
+            std::array<int, N> min;
+            std::array<int, N> max;
+
+            Moments()
+            {
+                min.fill(std::numeric_limits<T>::max());
+                max.fill(std::numeric_limits<T>::min());
+            }
+
+            void merge(const Moments &other) noexcept
+            {
+                count += other.count;
+                for (size_t i = 0; i < N; ++i)
+                {
+                    sum[i] += other.sum[i];
+                    sumSquares[i] += other.sumSquares[i];
+                    min[i] = std::min(min[i], other.min[i]);
+                    max[i] = std::max(max[i], other.max[i]);
+                }
+            }
+        };
+
+        /**
+         * @brief Acumula records registros de N valores seguidos (values[record * N + atributo])
+         */
+        template <typename T, size_t N>
+        void accumulateScalar(const T *values, size_t records, Moments<T, N> &moments) noexcept
+        {
+            for (size_t record = 0; record < records; ++record)
+            {
+                for (size_t i = 0; i < N; ++i)
+                {
+                    const int value = values[record * N + i];
+                    moments.sum[i] += value;
+                    moments.sumSquares[i] += static_cast<std::uint64_t>(static_cast<std::int64_t>(value) * value);
+                    moments.min[i] = std::min(moments.min[i], value);
+                    moments.max[i] = std::max(moments.max[i], value);
+                }
+            }
+            moments.count += records;
+        }
+
+        /**
+         * @brief Acumulador escalar: misma interfaz que Sse2Accumulator
+         */
+        template <typename T, size_t N>
+        struct ScalarAccumulator
+        {
+            void add(const T *values, size_t records, Moments<T, N> &moments) noexcept { accumulateScalar(values, records, moments); }
+            void finish(Moments<T, N> &) noexcept {}
+        };
+
+#ifdef NONAME_SIMD_SSE2
+        /**
+         * @brief Versión SSE2 de accumulateScalar() para bytes sin signo y enteros de 16 bits
+         *
+         * Trata los registros como un flujo de valores y acumula por carril.
+         * Cada bloque tiene mcm(N, carriles) valores, es decir, P vectores
+         * enteros de registros completos, y el carril j del vector k siempre
+         * es del atributo (k * carriles + j) % N. Así los P vectores de
+         * acumuladores se reparten entre atributos solo en finish(), y add()
+         * puede llamarse por cada tramo de filas vivas sin repetir ese coste.
+         *
+         * Las sumas de 32 bits se vuelcan a 64 bits cada FLUSH_BLOCKS bloques,
+         * antes de que puedan desbordarse. Los registros de cada add() que no
+         * llenan un bloque van por accumulateScalar().
+         */
+        template <typename T, size_t N>
+        class Sse2Accumulator
+        {
+            static_assert(std::is_same_v<T, std::uint8_t> || std::is_same_v<T, std::int16_t>, "SSE2 kernels cover uint8 and int16");
+            static constexpr bool BYTES = std::is_same_v<T, std::uint8_t>;
+            static constexpr size_t LANES = 16 / sizeof(T);
+            static constexpr size_t P = N / std::gcd(N, LANES); // Vectores por bloque
+            static constexpr size_t BLOCK_RECORDS = P * LANES / N;
+            static constexpr size_t FLUSH_BLOCKS = BYTES ? 65536 : 32768;
+            static constexpr size_t SUM_VECTORS = BYTES ? 4 : 2; // Sumas de 32 bits de cuatro carriles
+
+            // Por vector del bloque y carril (arrays de C: std::array<__m128i> pierde
+            // los atributos del tipo). Cuadrados de 16 bits: 64 bits desde el
+            // principio, porque un cuadrado ocupa hasta 2^30
+            __m128i _minimum[P], _maximum[P];
+            __m128i _sums32[P][SUM_VECTORS], _squares32[P][SUM_VECTORS];
+            __m128i _wideSquares[P][4];
+            std::array<std::array<std::int64_t, LANES>, P> _sums64{};
+            std::array<std::array<std::uint64_t, LANES>, P> _squares64{};
+            size_t _pendingBlocks{0}; // Bloques sumados desde el último volcado
+            size_t _records{0};       // Registros acumulados en los vectores
+
+            void resetPartials() noexcept
+            {
+                for (size_t k = 0; k < P; ++k)
+                {
+                    std::fill_n(_sums32[k], SUM_VECTORS, _mm_setzero_si128());
+                    std::fill_n(_squares32[k], SUM_VECTORS, _mm_setzero_si128());
+                }
+                _pendingBlocks = 0;
+            }
+
+            void flush() noexcept
+            {
+                for (size_t k = 0; k < P; ++k)
+                {
+                    for (size_t quarter = 0; quarter < SUM_VECTORS; ++quarter)
+                    {
+                        alignas(16) std::array<std::int32_t, 4> sum;
+                        alignas(16) std::array<std::uint32_t, 4> squares;
+                        _mm_store_si128(reinterpret_cast<__m128i *>(sum.data()), _sums32[k][quarter]);
+                        _mm_store_si128(reinterpret_cast<__m128i *>(squares.data()), _squares32[k][quarter]);
+                        for (size_t lane = 0; lane < 4; ++lane)
+                        {
+                            _sums64[k][quarter * 4 + lane] += sum[lane];
+                            _squares64[k][quarter * 4 + lane] += squares[lane];
+                        }
+                    }
+                }
+                resetPartials();
+            }
+
+        public:
+            Sse2Accumulator() noexcept
+            {
+                const __m128i zero = _mm_setzero_si128();
+                std::fill_n(_minimum, P, BYTES ? _mm_set1_epi8(static_cast<char>(0xFF)) : _mm_set1_epi16(std::numeric_limits<std::int16_t>::max()));
+                std::fill_n(_maximum, P, BYTES ? zero : _mm_set1_epi16(std::numeric_limits<std::int16_t>::min()));
+                for (auto &vectors : _wideSquares)
+                {
+                    std::fill_n(vectors, 4, zero);
+                }
+                resetPartials();
+            }
+
+            void add(const T *values, size_t records, Moments<T, N> &moments) noexcept
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i evenMask = _mm_set1_epi32(0x0000FFFF);
+                const __m128i oddMask = _mm_set1_epi32(static_cast<int>(0xFFFF0000u));
+                const size_t blocks = records / BLOCK_RECORDS;
+                const auto *vectors = reinterpret_cast<const __m128i *>(values);
+                for (size_t block = 0; block < blocks; ++block)
+                {
+                    for (size_t k = 0; k < P; ++k)
+                    {
+                        const __m128i v = _mm_loadu_si128(vectors + block * P + k);
+                        if constexpr (BYTES)
+                        {
+                            _minimum[k] = _mm_min_epu8(_minimum[k], v);
+                            _maximum[k] = _mm_max_epu8(_maximum[k], v);
+                            const __m128i low = _mm_unpacklo_epi8(v, zero);  // Carriles 0-7 en 16 bits
+                            const __m128i high = _mm_unpackhi_epi8(v, zero); // Carriles 8-15
+                            const __m128i lowSquares = _mm_mullo_epi16(low, low); // <= 65025, cabe sin signo
+                            const __m128i highSquares = _mm_mullo_epi16(high, high);
+                            _sums32[k][0] = _mm_add_epi32(_sums32[k][0], _mm_unpacklo_epi16(low, zero));
+                            _sums32[k][1] = _mm_add_epi32(_sums32[k][1], _mm_unpackhi_epi16(low, zero));
+                            _sums32[k][2] = _mm_add_epi32(_sums32[k][2], _mm_unpacklo_epi16(high, zero));
+                            _sums32[k][3] = _mm_add_epi32(_sums32[k][3], _mm_unpackhi_epi16(high, zero));
+                            _squares32[k][0] = _mm_add_epi32(_squares32[k][0], _mm_unpacklo_epi16(lowSquares, zero));
+                            _squares32[k][1] = _mm_add_epi32(_squares32[k][1], _mm_unpackhi_epi16(lowSquares, zero));
+                            _squares32[k][2] = _mm_add_epi32(_squares32[k][2], _mm_unpacklo_epi16(highSquares, zero));
+                            _squares32[k][3] = _mm_add_epi32(_squares32[k][3], _mm_unpackhi_epi16(highSquares, zero));
+                        }
+                        else
+                        {
+                            _minimum[k] = _mm_min_epi16(_minimum[k], v);
+                            _maximum[k] = _mm_max_epi16(_maximum[k], v);
+                            // Extensión de signo a 32 bits: carriles 0-3 y 4-7
+                            _sums32[k][0] = _mm_add_epi32(_sums32[k][0], _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+                            _sums32[k][1] = _mm_add_epi32(_sums32[k][1], _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+                            // madd con la otra mitad a cero: un cuadrado por carril de 32 bits
+                            const __m128i even = _mm_madd_epi16(v, _mm_and_si128(v, evenMask)); // Carriles 0, 2, 4, 6
+                            const __m128i odd = _mm_madd_epi16(v, _mm_and_si128(v, oddMask));   // Carriles 1, 3, 5, 7
+                            _wideSquares[k][0] = _mm_add_epi64(_wideSquares[k][0], _mm_unpacklo_epi32(even, zero)); // 0, 2
+                            _wideSquares[k][1] = _mm_add_epi64(_wideSquares[k][1], _mm_unpackhi_epi32(even, zero)); // 4, 6
+                            _wideSquares[k][2] = _mm_add_epi64(_wideSquares[k][2], _mm_unpacklo_epi32(odd, zero));  // 1, 3
+                            _wideSquares[k][3] = _mm_add_epi64(_wideSquares[k][3], _mm_unpackhi_epi32(odd, zero));  // 5, 7
+                        }
+                    }
+                    if (++_pendingBlocks == FLUSH_BLOCKS)
+                    {
+                        flush();
+                    }
+                }
+                _records += blocks * BLOCK_RECORDS;
+                accumulateScalar(values + blocks * BLOCK_RECORDS * N, records - blocks * BLOCK_RECORDS, moments);
+            }
+
+            /**
+             * @brief Reparte los carriles entre atributos y los suma a moments
+             */
+            void finish(Moments<T, N> &moments) noexcept
+            {
+                flush();
+                for (size_t k = 0; k < P; ++k)
+                {
+                    alignas(16) std::array<T, LANES> lowest, highest;
+                    _mm_store_si128(reinterpret_cast<__m128i *>(lowest.data()), _minimum[k]);
+                    _mm_store_si128(reinterpret_cast<__m128i *>(highest.data()), _maximum[k]);
+                    std::array<std::uint64_t, LANES> squares = _squares64[k];
+                    if constexpr (!BYTES)
+                    {
+                        constexpr std::array<size_t, 8> WIDE_LANES{0, 2, 4, 6, 1, 3, 5, 7};
+                        for (size_t pair = 0; pair < 4; ++pair)
+                        {
+                            alignas(16) std::array<std::uint64_t, 2> wide;
+                            _mm_store_si128(reinterpret_cast<__m128i *>(wide.data()), _wideSquares[k][pair]);
+                            squares[WIDE_LANES[pair * 2]] = wide[0];
+                            squares[WIDE_LANES[pair * 2 + 1]] = wide[1];
+                        }
+                    }
+                    for (size_t lane = 0; lane < LANES; ++lane)
+                    {
+                        const size_t attribute = (k * LANES + lane) % N;
+                        if (_records)
+                        {
+                            moments.min[attribute] = std::min<int>(moments.min[attribute], lowest[lane]);
+                            moments.max[attribute] = std::max<int>(moments.max[attribute], highest[lane]);
+                        }
+                        moments.sum[attribute] += _sums64[k][lane];
+                        moments.sumSquares[attribute] += squares[lane];
+                    }
+                }
+                moments.count += _records;
+                *this = Sse2Accumulator{};
+            }
+        };
+
+        template <typename T, size_t N>
+        void accumulateSse2(const T *values, size_t records, Moments<T, N> &moments) noexcept
+        {
+            Sse2Accumulator<T, N> accumulator;
+            accumulator.add(values, records, moments);
+            accumulator.finish(moments);
+        }
+
+        // Acumulador que usa compute(): SSE2 si está disponible
+        template <typename T, size_t N>
+        using Accumulator = Sse2Accumulator<T, N>;
+#else
+        template <typename T, size_t N>
+        using Accumulator = ScalarAccumulator<T, N>;
+#endif
+
+        /**
+         * @brief Suma al histograma de cada atributo los valores de records registros
+         *
+         * SSE2 no tiene scatter: se cuenta valor a valor. histograms[i] cubre
+         * [min[i], max[i]] y los valores ya están dentro de ese rango.
+         */
+        template <typename T, size_t N>
+        void countValues(const T *values, size_t records, const std::array<int, N> &min,
+                         std::array<std::vector<std::uint32_t>, N> &histograms) noexcept
+        {
+            std::array<std::uint32_t *, N> bins;
+            for (size_t i = 0; i < N; ++i)
+            {
+                bins[i] = histograms[i].data();
+            }
+            for (size_t record = 0; record < records; ++record)
+            {
+                for (size_t i = 0; i < N; ++i)
+                {
+                    ++bins[i][values[record * N + i] - min[i]];
+                }
+            }
+        }
+
+        /**
+         * @brief Llama a body(first, count) por cada tramo de registros vivos de [begin, end)
+         *
+         * Sin columna de vivos, todo el rango es un tramo.
+         */
+        template <typename F>
+        void forEachLiveRun(std::span<const std::uint8_t> live, size_t begin, size_t end, F &&body)
+        {
+            if (live.empty())
+            {
+                body(begin, end - begin);
+                return;
+            }
+            size_t record = begin;
+            while (record < end)
+            {
+                while (record < end && !live[record])
+                {
+                    ++record;
+                }
+                const size_t first = record;
+                while (record < end && live[record])
+                {
+                    ++record;
+                }
+                if (record > first)
+                {
+                    body(first, record - first);
+                }
+            }
+        }
+
+        /**
+         * @brief Estadísticas de N atributos intercalados, en dos pasadas
+         *
+         * La primera (SIMD) calcula sumas y extremos y la segunda cuenta el
+         * histograma dentro de los extremos. Con pool, cada pasada se reparte
+         * en trozos; todas las sumas son enteras, así que el resultado no
+         * depende del reparto.
+         * @param live Vacío, o un byte por registro: solo cuentan los distintos de 0
+         */
+        template <typename T, size_t N>
+        std::array<AttributeStats, N> compute(const T *values, size_t records, std::span<const std::uint8_t> live,
+                                              bool histograms, WorkerPool *pool)
+        {
+            constexpr size_t MIN_CHUNK = 65536;
+            const size_t chunks = pool ? std::clamp<size_t>(records / MIN_CHUNK, 1, pool->getThreadCount() + 1) : 1;
+            auto chunkBegin = [&](size_t chunk) { return records * chunk / chunks; };
+            auto forEachChunk = [&](auto &&body)
+            {
+                if (chunks == 1)
+                {
+                    body(size_t{0});
+                    return;
+                }
+                pool->parallelFor(chunks, 1, [&](size_t first, size_t last)
+                                  {
+                                      for (size_t chunk = first; chunk < last; ++chunk)
+                                      {
+                                          body(chunk);
+                                      } });
+            };
+
+            std::vector<Moments<T, N>> partial(chunks);
+            forEachChunk([&](size_t chunk)
+                         {
+                             Accumulator<T, N> accumulator;
+                             forEachLiveRun(live, chunkBegin(chunk), chunkBegin(chunk + 1), [&](size_t first, size_t count)
+                                            { accumulator.add(values + first * N, count, partial[chunk]); });
+                             accumulator.finish(partial[chunk]); });
+            Moments<T, N> moments;
+            for (const auto &chunkMoments : partial)
+            {
+                moments.merge(chunkMoments);
+            }
+
+            std::array<AttributeStats, N> stats;
+            for (size_t i = 0; i < N; ++i)
+            {
+                stats[i].count = moments.count;
+                stats[i].sum = moments.sum[i];
+                stats[i].sumSquares = moments.sumSquares[i];
+                stats[i].min = moments.count ? moments.min[i] : 0;
+                stats[i].max = moments.count ? moments.max[i] : 0;
+            }
+            if (!histograms || !moments.count)
+            {
+                return stats;
+            }
+
+            std::vector<std::array<std::vector<std::uint32_t>, N>> counts(chunks);
+            forEachChunk([&](size_t chunk)
+                         {
+                             for (size_t i = 0; i < N; ++i)
+                             {
+                                 counts[chunk][i].assign(static_cast<size_t>(moments.max[i] - moments.min[i] + 1), 0);
+                             }
+                             forEachLiveRun(live, chunkBegin(chunk), chunkBegin(chunk + 1), [&](size_t first, size_t count)
+                                            { countValues(values + first * N, count, moments.min, counts[chunk]); }); });
+            for (size_t i = 0; i < N; ++i)
+            {
+                stats[i].histogram = std::move(counts[0][i]);
+                for (size_t chunk = 1; chunk < chunks; ++chunk)
+                {
+                    std::transform(stats[i].histogram.begin(), stats[i].histogram.end(), counts[chunk][i].begin(),
+                                   stats[i].histogram.begin(), std::plus<>{});
+                }
+            }
+            return stats;
+        }
+    }
+
+    using HeritableStats = std::array<AttributeStats, Heritables::COUNT>;
+    using SkillStats = std::array<AttributeStats, CharacterStore::MAX_SKILLS>;
+
+    // Las columnas se leen como valores intercalados sin copiarlas
+    static_assert(sizeof(Heritables) == Heritables::COUNT && std::is_trivially_copyable_v<Heritables>);
+    static_assert(sizeof(CharacterStore::SkillArray) == CharacterStore::MAX_SKILLS * sizeof(std::int16_t) &&
+                  std::is_same_v<CharacterStore::SkillArray::value_type, std::int16_t>);
+
+    /**
+     * @brief Opciones de las estadísticas de población
+     */
+    struct PopulationStatsOptions
+    {
+        bool histograms{true}; // Sin histograma no hay cuantiles, pero es una sola pasada
+        WorkerPool *pool{nullptr};
+    };
+
+    /**
+     * @brief Heritables de una población del simulador de cría (o cualquier lista de Heritables)
+     */
+    inline HeritableStats computeHeritableStats(std::span<const Heritables> population, const PopulationStatsOptions &options = {})
+    {
+        return populationstats::compute<std::uint8_t, Heritables::COUNT>(reinterpret_cast<const std::uint8_t *>(population.data()),
+                                                                          population.size(), {}, options.histograms, options.pool);
+    }
+
+    /**
+     * @brief Heritables de las filas vivas del almacén
+     */
+    inline HeritableStats computeHeritableStats(const CharacterStore &store, const PopulationStatsOptions &options = {})
+    {
+        const auto &column = store.heritablesColumn();
+        return populationstats::compute<std::uint8_t, Heritables::COUNT>(reinterpret_cast<const std::uint8_t *>(column.data()),
+                                                                          column.size(), store.liveColumn(), options.histograms, options.pool);
+    }
+
+    /**
+     * @brief Skills de las filas vivas del almacén
+     */
+    inline SkillStats computeSkillStats(const CharacterStore &store, const PopulationStatsOptions &options = {})
+    {
+        const auto &column = store.skillsColumn();
+        return populationstats::compute<std::int16_t, CharacterStore::MAX_SKILLS>(reinterpret_cast<const std::int16_t *>(column.data()),
+                                                                                   column.size(), store.liveColumn(), options.histograms, options.pool);
+    }
+
+    /**
+     * @brief Informe de población completo: heritables y skills de todo el mundo
+     */
+    struct PopulationReport
+    {
+        HeritableStats heritables;
+        SkillStats skills;
+    };
+
+    inline PopulationReport computePopulationReport(const CharacterStore &store, const PopulationStatsOptions &options = {})
+    {
+        return PopulationReport{computeHeritableStats(store, options), computeSkillStats(store, options)};
+    }
+}
+
+#endif // __POPULATION_STATS_H__
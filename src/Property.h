@@ -3,6 +3,7 @@
 
 // Local includes
 #include "HtmlBuilder.h"
+#include "HtmlWriter.h"
 
 // System includes
 #include <string>
@@ -34,6 +35,11 @@ namespace noname
             return value;
         }
 
+        const T &getRef() const noexcept
+        {
+            return value;
+        }
+
         Property<T> &operator=(T newValue)
         {
             value = newValue;
@@ -131,6 +137,23 @@ namespace noname
                 return HtmlBuilder{"tr"}.add_child("td", title).add_child("td", std::to_string(value));
             }
         }
+
+        /**
+         * @brief Escribe la misma fila que toHtmlBuilder directamente en el writer
+         */
+        void writeHtml(HtmlWriter &writer, std::string_view title) const
+        {
+            writer.open("tr").element("td", title);
+            if constexpr (std::is_convertible_v<T, std::string_view>)
+            {
+                writer.element("td", std::string_view{value});
+            }
+            else
+            {
+                writer.element("td", value);
+            }
+            writer.close();
+        }
     };
 }
 
@@ -20,7 +20,7 @@ namespace noname
         int calculateDamage(const Character& attacker, 
                            const std::shared_ptr<Weapon>& weapon) const override {
             if (!weapon) {
-                LM.writeLog(Level::Debug, "Cannot perform ranged attack without weapon");
+                LM.log<Level::Debug>("Cannot perform ranged attack without weapon");
                 return 0; // No se puede atacar a distancia sin arma
             }
             
@@ -29,7 +29,7 @@ namespace noname
             lastHitRoll = hitRoll;
             
             if (hitRoll <= 2) {
-                LM.writeLog(Level::Debug, "Ranged attack missed with roll: " + std::to_string(hitRoll));
+                LM.log<Level::Debug>("Ranged attack missed with roll: {}", hitRoll);
                 return 0; // Miss más probable que en combate cuerpo a cuerpo
             }
             
@@ -39,7 +39,7 @@ namespace noname
             // Aplicar críticos (más fácil para armas a distancia)
             if (hitRoll >= 19) {
                 baseDamage *= getCriticalMultiplier();
-                LM.writeLog(Level::Debug, "Critical ranged hit! Damage doubled");
+                LM.log<Level::Debug>("Critical ranged hit! Damage doubled");
             }
             
             // Agregar bonus de skill
@@ -50,10 +50,8 @@ namespace noname
             
             int totalDamage = baseDamage + skillBonus + dexterityBonus;
             
-            LM.writeLog(Level::Debug, "Ranged damage calculation: base(" + std::to_string(baseDamage) + 
-                       ") + distance_skill(" + std::to_string(skillBonus) + 
-                       ") + dexterity(" + std::to_string(dexterityBonus) + 
-                       ") = " + std::to_string(totalDamage));
+            LM.log<Level::Debug>("Ranged damage calculation: base({}) + distance_skill({}) + dexterity({}) = {}",
+                                 baseDamage, skillBonus, dexterityBonus, totalDamage);
             
             return totalDamage;
         }
@@ -8,11 +8,21 @@
 #include "Player.h"
 #include "LogManager.h"
 #include "FileManager.h"
-#include "HtmlBuilder.h"
+#include "HtmlWriter.h"
+#include "FlatIdMap.h"
+#include "OrderStatisticTree.h"
+#include "WorkerPool.h"
 
 // System includes
 #include <vector>
+#include <string>
 #include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <span>
+#include <atomic>
+#include <memory>
+#include <cstdint>
 
 // Acronyms for easier access to rankings
 #define RANKING_FIST noname::Ranking<SkillType::FIST>::getInstance()
@@ -24,14 +34,207 @@
 
 namespace noname
 {
+    /**
+     * @brief Fila de un ranking: solo el id del jugador y sus valores
+     */
+    struct RankingEntry
+    {
+        int playerId{0};
+        short skill{0};
+        short level{0};
+
+        bool operator==(const RankingEntry &) const = default;
+    };
+
+    /**
+     * @brief Orden del ranking: mayor skill primero y, a igualdad, menor id
+     */
+    struct RankingOrder
+    {
+        bool operator()(const RankingEntry &a, const RankingEntry &b) const noexcept
+        {
+            if (a.skill != b.skill)
+            {
+                return a.skill > b.skill;
+            }
+            return a.playerId < b.playerId;
+        }
+    };
+
+    /**
+     * @brief Copia inmutable de un ranking, publicada por Ranking::publish()
+     *
+     * Nada de lo que contiene cambia después de publicarse, así que otros
+     * hilos pueden consultarla y exportarla mientras el hilo de la
+     * simulación sigue modificando el ranking.
+     */
+    class RankingSnapshot
+    {
+    private:
+        SkillType _skill{SkillType::LAST_SKILL};
+        std::uint64_t _version{0};
+        std::vector<RankingEntry> _rows;
+        FlatIdMap<std::uint32_t> _positions; // id -> posición en _rows
+
+        // Escribe una página fila a fila, sin construir la tabla en memoria
+        bool writePage(const std::filesystem::path &path, size_t page, size_t pageCount, size_t pageSize) const
+        {
+            std::ofstream out(path, std::ios::out | std::ios::trunc);
+            if (!out.is_open())
+            {
+                LM.log<Level::Error>("Failed to open ranking page: {}", path.string());
+                return false;
+            }
+            {
+                HtmlWriter writer{out};
+                writer.open("table");
+                writer.open("caption").text("Ranking of: ", SkillToString(_skill), " (page ", page, " of ", pageCount, ")").close();
+                writer.open("tr").element("th", "Rank").element("th", "Player ID").element("th", "Level").element("th", "Skill").close();
+                const size_t from = std::min((page - 1) * pageSize, _rows.size());
+                const size_t to = std::min(from + pageSize, _rows.size());
+                for (size_t position = from; position < to; ++position)
+                {
+                    const RankingEntry &entry = _rows[position];
+                    writer.open("tr").element("td", position + 1).element("td", entry.playerId).element("td", entry.level).element("td", entry.skill).close();
+                }
+                writer.close();
+            }
+            return out.good();
+        }
+
+    public:
+        explicit RankingSnapshot(SkillType skill = SkillType::LAST_SKILL) : _skill(skill) {}
+
+        /**
+         * @param rows Filas ya en orden de ranking
+         */
+        RankingSnapshot(SkillType skill, std::uint64_t version, std::vector<RankingEntry> rows)
+            : _skill(skill), _version(version), _rows(std::move(rows))
+        {
+            _positions.reserve(_rows.size());
+            for (size_t position = 0; position < _rows.size(); ++position)
+            {
+                _positions.tryEmplace(_rows[position].playerId, static_cast<std::uint32_t>(position));
+            }
+        }
+
+        [[nodiscard]] SkillType getSkillType() const noexcept { return _skill; }
+        [[nodiscard]] std::uint64_t getVersion() const noexcept { return _version; }
+        [[nodiscard]] size_t size() const noexcept { return _rows.size(); }
+        [[nodiscard]] const std::vector<RankingEntry> &getRanking() const noexcept { return _rows; }
+
+        [[nodiscard]] int getPlayerRanking(int playerId) const noexcept
+        {
+            const std::uint32_t *position = _positions.find(playerId);
+            return position ? static_cast<int>(*position) : -1;
+        }
+
+        [[nodiscard]] std::vector<RankingEntry> range(size_t fromRank, size_t count) const
+        {
+            const size_t from = std::min(fromRank, _rows.size());
+            const size_t to = from + std::min(count, _rows.size() - from);
+            return {_rows.begin() + static_cast<std::ptrdiff_t>(from), _rows.begin() + static_cast<std::ptrdiff_t>(to)};
+        }
+
+        [[nodiscard]] std::vector<RankingEntry> topK(size_t k) const { return range(0, k); }
+
+        [[nodiscard]] std::vector<RankingEntry> around(int playerId, size_t radius) const
+        {
+            const int position = getPlayerRanking(playerId);
+            if (position < 0)
+            {
+                return {};
+            }
+            const size_t from = static_cast<size_t>(position) - std::min(radius, static_cast<size_t>(position));
+            return range(from, static_cast<size_t>(position) - from + radius + 1);
+        }
+
+        [[nodiscard]] size_t getPageCount(size_t pageSize) const noexcept
+        {
+            return pageSize == 0 ? 0 : (_rows.size() + pageSize - 1) / pageSize;
+        }
+
+        [[nodiscard]] std::filesystem::path getPagePath(size_t page, const std::filesystem::path &directory = {}) const
+        {
+            return directory / ("Ranking-" + SkillToString(_skill) + "-page-" + std::to_string(page) + ".html");
+        }
+
+        /**
+         * @brief Escribe la página indicada (desde 1) en Ranking-<SKILL>-page-N.html
+         *
+         * Solo recorre las filas de esa página: el coste depende de pageSize
+         * y no del número total de jugadores.
+         */
+        bool exportPage(size_t page, size_t pageSize, const std::filesystem::path &directory = {}) const
+        {
+            const size_t pageCount = std::max<size_t>(getPageCount(pageSize), 1);
+            if (pageSize == 0 || page == 0 || page > pageCount)
+            {
+                return false;
+            }
+            return writePage(getPagePath(page, directory), page, pageCount, pageSize);
+        }
+
+        /**
+         * @brief Escribe todas las páginas; cada una se genera y se cierra antes
+         * de pasar a la siguiente
+         * @return Número de páginas escritas
+         */
+        size_t exportPages(size_t pageSize, const std::filesystem::path &directory = {}) const
+        {
+            if (pageSize == 0)
+            {
+                return 0;
+            }
+            const size_t pageCount = std::max<size_t>(getPageCount(pageSize), 1);
+            size_t written = 0;
+            for (size_t page = 1; page <= pageCount; ++page)
+            {
+                written += writePage(getPagePath(page, directory), page, pageCount, pageSize) ? 1 : 0;
+            }
+            LM.log<Level::Debug>("Ranking-{} exported {} pages", SkillToString(_skill), written);
+            return written;
+        }
+    };
+
     template <SkillType _skill>
     class Ranking : public Manager, public Singleton<Ranking<_skill>>
     {
 
     private:
-        std::vector<Player> _players_list;
+        // Árbol de estadísticos de orden con las filas en orden de ranking
+        // (el nivel no forma parte del orden) e índice id -> fila
+        OrderStatisticTree<RankingEntry, RankingOrder> _ranking;
+        FlatIdMap<RankingEntry> _players;
         FileManager rankingFile;
 
+        // Versión de los datos (cambia con cada modificación) y última instantánea publicada
+        std::uint64_t _version{0};
+        std::atomic<std::shared_ptr<const RankingSnapshot>> _snapshot{std::make_shared<const RankingSnapshot>(_skill)};
+
+        [[nodiscard]] RankingEntry keyOf(const RankingEntry &entry) const noexcept
+        {
+            return {entry.playerId, entry.skill, 0};
+        }
+
+        /**
+         * @brief Filas actuales en orden de ranking; solo para publish()
+         */
+        [[nodiscard]] std::vector<RankingEntry> liveRows() const
+        {
+            std::vector<RankingEntry> ranking;
+            ranking.reserve(_ranking.size());
+            _ranking.forEach([this, &ranking](size_t, const RankingEntry &key)
+                             { ranking.push_back(*_players.find(key.playerId)); });
+            return ranking;
+        }
+
+        // Marca un cambio: los lectores lo verán en la próxima publish()
+        void touch() noexcept
+        {
+            ++_version;
+        }
+
     public:
         void startUp() noexcept
         {
@@ -44,56 +247,301 @@ namespace noname
 
         void shutDown() noexcept
         {
-            _players_list.clear();
+            _ranking.clear();
+            _players.clear();
+            touch();
+            publish();
             rankingFile.shutDown();
             Manager::shutDown();
             LM.writeLog(Level::Debug, std::string(Manager::getType()) + "::shutDown");
         }
 
-        void updateRanking()
+        /**
+         * @brief Añade un jugador o actualiza sus valores, en O(log n)
+         */
+        void addPlayer(const Player &player)
         {
-            std::sort(_players_list.begin(), _players_list.end(), [](const Player &a, const Player &b)
-                      { return a.getSkill(_skill) > b.getSkill(_skill); });
+            updatePlayer(player.getId(), player.getSkill(_skill), player.getLevel());
         }
 
-        void addPlayer(const Player &player)
+        /**
+         * @brief Nuevo valor de skill de un jugador que ya está en el ranking
+         * @return false si el jugador no está en el ranking
+         */
+        bool updateSkill(int playerId, short skill)
         {
-            _players_list.emplace_back(player);
-            updateRanking();
+            RankingEntry *stored = _players.find(playerId);
+            if (!stored)
+            {
+                return false;
+            }
+            if (stored->skill != skill)
+            {
+                _ranking.erase(keyOf(*stored));
+                stored->skill = skill;
+                _ranking.insert(keyOf(*stored));
+                touch();
+            }
+            return true;
+        }
+
+        /**
+         * @brief El nivel no forma parte del orden: solo se actualiza la fila, en O(1)
+         */
+        bool updateLevel(int playerId, short level)
+        {
+            RankingEntry *stored = _players.find(playerId);
+            if (!stored)
+            {
+                return false;
+            }
+            if (stored->level != level)
+            {
+                stored->level = level;
+                touch();
+            }
+            return true;
+        }
+
+        void updatePlayer(int playerId, short skill, short level)
+        {
+            RankingEntry entry{playerId, skill, level};
+            auto [stored, inserted] = _players.tryEmplace(playerId, entry);
+            if (!inserted)
+            {
+                if (stored == entry)
+                {
+                    return;
+                }
+                if (stored.skill != skill)
+                {
+                    _ranking.erase(keyOf(stored));
+                    _ranking.insert(keyOf(entry));
+                }
+                stored = entry;
+                touch();
+                return;
+            }
+            _ranking.insert(keyOf(entry));
+            touch();
+        }
+
+        bool removePlayer(int playerId)
+        {
+            const RankingEntry *stored = _players.find(playerId);
+            if (!stored)
+            {
+                return false;
+            }
+            _ranking.erase(keyOf(*stored));
+            _players.erase(playerId);
+            touch();
+            return true;
         }
 
-        std::vector<Player> getRanking() const
+        /**
+         * @brief Sustituye todo el ranking: ordena una vez y construye el árbol en O(n)
+         */
+        void assignPlayers(const std::vector<RankingEntry> &entries)
         {
-            return _players_list;
+            WorkerPool callerOnly{0};
+            assignPlayers(entries, callerOnly);
         }
 
-        short getPlayerRanking(int playerId)
+        /**
+         * @brief Igual que assignPlayers, ordenando en paralelo en el pool
+         */
+        void assignPlayers(const std::vector<RankingEntry> &entries, WorkerPool &pool)
         {
-            for (int i = 0; i < _players_list.size(); i++)
+            _players.clear();
+            _players.reserve(entries.size());
+            std::vector<RankingEntry> keys;
+            keys.reserve(entries.size());
+            for (const auto &entry : entries)
             {
-                if (_players_list[i].getId() == playerId)
+                // Si un id se repite se queda la primera fila
+                if (_players.tryEmplace(entry.playerId, entry).second)
                 {
-                    return i;
+                    keys.push_back(keyOf(entry));
                 }
             }
-            return -1;
+            parallelSort(pool, keys.begin(), keys.end(), RankingOrder{});
+            _ranking.assignSorted(keys);
+            touch();
+        }
+
+        /**
+         * @brief Reconstruye el ranking desde cero con los valores actuales de los jugadores
+         */
+        void refresh(std::span<const Player *const> players, WorkerPool &pool)
+        {
+            std::vector<RankingEntry> entries;
+            entries.reserve(players.size());
+            for (const Player *player : players)
+            {
+                entries.push_back({player->getId(), player->getSkill(_skill), player->getLevel()});
+            }
+            assignPlayers(entries, pool);
         }
 
+        [[nodiscard]] static constexpr SkillType getSkillType() noexcept { return _skill; }
+
+        /**
+         * @brief Filas actuales, publicadas o no; solo desde el hilo que modifica el ranking
+         */
+        [[nodiscard]] size_t size() const noexcept { return _ranking.size(); }
+
+        /*
+         * Consultas: todas leen la última instantánea publicada, así que se
+         * pueden hacer desde cualquier hilo y no ven los cambios hasta el
+         * siguiente publish() (RM.onTick() o RM.publishSnapshots()).
+         */
+
+        /**
+         * @brief Filas en orden de ranking
+         */
+        [[nodiscard]] std::vector<RankingEntry> getRanking() const
+        {
+            return getSnapshot()->getRanking();
+        }
+
+        /**
+         * @brief Posición del jugador (0 es el primero) o -1
+         */
+        [[nodiscard]] int getPlayerRanking(int playerId) const
+        {
+            return getSnapshot()->getPlayerRanking(playerId);
+        }
+
+        /**
+         * @brief Filas de las posiciones [fromRank, fromRank + count)
+         */
+        [[nodiscard]] std::vector<RankingEntry> range(size_t fromRank, size_t count) const
+        {
+            return getSnapshot()->range(fromRank, count);
+        }
+
+        /**
+         * @brief Los k primeros del ranking
+         */
+        [[nodiscard]] std::vector<RankingEntry> topK(size_t k) const
+        {
+            return getSnapshot()->topK(k);
+        }
+
+        /**
+         * @brief El jugador y hasta radius filas por encima y por debajo;
+         * vacío si el jugador no está en el ranking
+         */
+        [[nodiscard]] std::vector<RankingEntry> around(int playerId, size_t radius) const
+        {
+            return getSnapshot()->around(playerId, radius);
+        }
+
+        [[nodiscard]] size_t getPageCount(size_t pageSize) const
+        {
+            return getSnapshot()->getPageCount(pageSize);
+        }
+
+        [[nodiscard]] std::filesystem::path getPagePath(size_t page, const std::filesystem::path &directory = {}) const
+        {
+            return getSnapshot()->getPagePath(page, directory);
+        }
+
+        /**
+         * @brief Exporta esa página de la última instantánea; el coste depende de pageSize
+         */
+        bool exportPage(size_t page, size_t pageSize, const std::filesystem::path &directory = {}) const
+        {
+            return getSnapshot()->exportPage(page, pageSize, directory);
+        }
+
+        size_t exportPages(size_t pageSize, const std::filesystem::path &directory = {}) const
+        {
+            return getSnapshot()->exportPages(pageSize, directory);
+        }
+
+        /**
+         * @brief Publica una instantánea con el estado actual, si ha cambiado
+         * desde la última, y la devuelve
+         *
+         * Solo desde el hilo que modifica el ranking. Cuesta O(n): copia las
+         * filas en orden. Los lectores que ya tenían la anterior la siguen
+         * usando hasta que la sueltan.
+         */
+        std::shared_ptr<const RankingSnapshot> publish()
+        {
+            auto current = _snapshot.load(std::memory_order_acquire);
+            if (current->getVersion() == _version)
+            {
+                return current;
+            }
+            auto published = std::make_shared<const RankingSnapshot>(_skill, _version, liveRows());
+            _snapshot.store(published, std::memory_order_release);
+            return published;
+        }
+
+        [[nodiscard]] bool hasUnpublishedChanges() const noexcept
+        {
+            return _snapshot.load(std::memory_order_acquire)->getVersion() != _version;
+        }
+
+        /**
+         * @brief Última instantánea publicada; se puede llamar desde cualquier hilo
+         */
+        [[nodiscard]] std::shared_ptr<const RankingSnapshot> getSnapshot() const noexcept
+        {
+            return _snapshot.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Escribe el ranking actual en Ranking-<SKILL>.html; solo desde
+         * el hilo que modifica el ranking
+         */
         void printRanking()
         {
             auto title{"Ranking of: " + SkillToString(_skill)};
             LM.writeLog(Level::Debug, title);
 
-            HtmlBuilder rankingTable{"table"};
-            rankingTable.add_child("caption", title);
-
-            rankingTable.add_child(HtmlBuilder{"tr"}.add_child("th", "Player ID").add_child("th", "Level").add_child("th", "Skill"));
-            for (auto &player : _players_list)
             {
-                player.getInfoForRanking(rankingTable, _skill);
+                HtmlWriter writer{rankingFile.getOutputStream()};
+                writer.open("table");
+                writer.element("caption", title);
+                writer.open("tr").element("th", "Player ID").element("th", "Level").element("th", "Skill").close();
+                _ranking.forEach([this, &writer](size_t, const RankingEntry &key)
+                {
+                    const RankingEntry &entry = *_players.find(key.playerId);
+                    writer.open("tr").element("td", entry.playerId).element("td", entry.level).element("td", entry.skill).close();
+                });
+                writer.close();
             }
-            rankingFile.write(rankingTable.str());
+            rankingFile.getOutputStream().flush();
         }
     };
+
+    /**
+     * @brief Llama a query con el ranking de la skill, o devuelve fallback
+     */
+    template <typename R, typename F>
+    R withSkillRanking(SkillType skill, R fallback, F &&query)
+    {
+        switch (skill)
+        {
+        case SkillType::FIST:
+            return query(RANKING_FIST);
+        case SkillType::SWORD:
+            return query(RANKING_SWORD);
+        case SkillType::AXE:
+            return query(RANKING_AXE);
+        case SkillType::CLUB:
+            return query(RANKING_CLUB);
+        case SkillType::DISTANCE:
+            return query(RANKING_DISTANCE);
+        case SkillType::SHIELDING:
+            return query(RANKING_SHIELDING);
+        default:
+            return fallback;
+        }
+    }
 }
 #endif // __RANKING_H__
@@ -4,14 +4,59 @@
 // Local includes
 #include "Ranking.h"
 #include "Player.h" // Ensure Player is included
+#include "WorkerPool.h"
+#include "RankingObserver.h"
+#include "Exporters.h"
+
+// System includes
+#include <chrono>
+#include <span>
+#include <vector>
+#include <future>
+#include <memory>
 
 // Two-letter acronym for easier access to manager
 #define RM noname::RankingManager::getInstance()
 
 namespace noname
 {
+    /**
+     * @brief Tiempos de un refreshAll(), por skill y de principio a fin
+     */
+    struct RankingRefreshReport
+    {
+        struct SkillTiming
+        {
+            SkillType skill{SkillType::LAST_SKILL};
+            std::chrono::microseconds rebuild{0};
+            std::chrono::microseconds exportTime{0};
+            size_t players{0};
+            size_t pages{0};
+        };
+
+        std::vector<SkillTiming> skills;
+        std::chrono::microseconds total{0};
+        size_t threads{0};
+    };
+
     class RankingManager : public Manager, public Singleton<RankingManager>
     {
+    private:
+        std::shared_ptr<RankingObserver> _observer{std::make_shared<RankingObserver>()};
+        size_t _snapshotCadence{1};
+        size_t _ticksSincePublish{0};
+
+        template <typename F>
+        void forEachRanking(F &&visit)
+        {
+            visit(RANKING_FIST);
+            visit(RANKING_SWORD);
+            visit(RANKING_AXE);
+            visit(RANKING_CLUB);
+            visit(RANKING_DISTANCE);
+            visit(RANKING_SHIELDING);
+        }
+
     public:
         void startUp() noexcept
         {
@@ -26,6 +71,8 @@ namespace noname
             Manager::startUp();
         }
 
+        [[nodiscard]] std::shared_ptr<RankingObserver> getObserver() const noexcept { return _observer; }
+
         void shutDown() noexcept
         {
             RANKING_FIST.shutDown();
@@ -38,17 +85,13 @@ namespace noname
             Manager::shutDown();
         }
 
-        void updateAllRankings()
-        {
-            RANKING_FIST.updateRanking();
-            RANKING_SWORD.updateRanking();
-            RANKING_AXE.updateRanking();
-            RANKING_CLUB.updateRanking();
-            RANKING_DISTANCE.updateRanking();
-            RANKING_SHIELDING.updateRanking();
-        }
-
-        void addPlayer(const Player &player)
+        /**
+         * @brief Añade el jugador a todos los rankings y los mantiene al día
+         *
+         * El observer de rankings se suscribe al jugador: cada SKILL_IMPROVED
+         * y LEVEL_UP posterior actualiza su fila en O(log n).
+         */
+        void addPlayer(Player &player)
         {
             RANKING_FIST.addPlayer(player);
             RANKING_SWORD.addPlayer(player);
@@ -56,40 +99,197 @@ namespace noname
             RANKING_CLUB.addPlayer(player);
             RANKING_DISTANCE.addPlayer(player);
             RANKING_SHIELDING.addPlayer(player);
+            player.subscribe(_observer);
         }
 
-        short getPlayerRanking(int playerId, SkillType skill)
+        void removePlayer(Player &player)
+        {
+            player.unsubscribe(_observer);
+            removePlayer(player.getId());
+        }
+
+        void removePlayer(int playerId)
+        {
+            RANKING_FIST.removePlayer(playerId);
+            RANKING_SWORD.removePlayer(playerId);
+            RANKING_AXE.removePlayer(playerId);
+            RANKING_CLUB.removePlayer(playerId);
+            RANKING_DISTANCE.removePlayer(playerId);
+            RANKING_SHIELDING.removePlayer(playerId);
+        }
+
+        /*
+         * Consultas sobre la última instantánea publicada de cada ranking: se
+         * pueden hacer desde cualquier hilo.
+         */
+        int getPlayerRanking(int playerId, SkillType skill)
+        {
+            return withSkillRanking(skill, -1, [playerId](const auto &ranking)
+                               { return ranking.getSnapshot()->getPlayerRanking(playerId); });
+        }
+
+        std::vector<RankingEntry> topK(SkillType skill, size_t k)
+        {
+            return withSkillRanking(skill, std::vector<RankingEntry>{}, [k](const auto &ranking)
+                               { return ranking.getSnapshot()->topK(k); });
+        }
+
+        std::vector<RankingEntry> range(SkillType skill, size_t fromRank, size_t count)
+        {
+            return withSkillRanking(skill, std::vector<RankingEntry>{}, [fromRank, count](const auto &ranking)
+                               { return ranking.getSnapshot()->range(fromRank, count); });
+        }
+
+        std::vector<RankingEntry> around(SkillType skill, int playerId, size_t radius)
+        {
+            return withSkillRanking(skill, std::vector<RankingEntry>{}, [playerId, radius](const auto &ranking)
+                               { return ranking.getSnapshot()->around(playerId, radius); });
+        }
+
+        bool exportPage(SkillType skill, size_t page, size_t pageSize, const std::filesystem::path &directory = {})
+        {
+            return withSkillRanking(skill, false, [&](const auto &ranking)
+                               { return ranking.getSnapshot()->exportPage(page, pageSize, directory); });
+        }
+
+        /**
+         * @brief Escribe las páginas de la última instantánea de todos los rankings
+         * @return Número total de páginas escritas
+         */
+        size_t exportAllPages(size_t pageSize, const std::filesystem::path &directory = {})
+        {
+            LM.writeLog(Level::Debug, "RankingManager::exportAllPages");
+            return RANKING_FIST.exportPages(pageSize, directory) +
+                   RANKING_SWORD.exportPages(pageSize, directory) +
+                   RANKING_AXE.exportPages(pageSize, directory) +
+                   RANKING_CLUB.exportPages(pageSize, directory) +
+                   RANKING_DISTANCE.exportPages(pageSize, directory) +
+                   RANKING_SHIELDING.exportPages(pageSize, directory);
+        }
+
+        /**
+         * @brief Reconstruye y exporta todos los rankings a la vez en el pool
+         * @param pageSize Filas por página exportada; 0 no exporta
+         *
+         * Cada skill es una tarea que reconstruye su ranking (con ordenación
+         * paralela si es grande), publica el resultado y escribe sus páginas.
+         * Los rankings no comparten datos, así que las tareas no se bloquean
+         * entre sí.
+         */
+        RankingRefreshReport refreshAll(std::span<const Player *const> players, size_t pageSize,
+                                        WorkerPool &pool, const std::filesystem::path &directory = {})
+        {
+            using Clock = std::chrono::steady_clock;
+            const auto start = Clock::now();
+
+            std::vector<std::future<RankingRefreshReport::SkillTiming>> tasks;
+            forEachRanking([&](auto &ranking)
+            {
+                tasks.push_back(pool.submit([&ranking, &pool, players, pageSize, &directory]()
+                {
+                    RankingRefreshReport::SkillTiming timing;
+                    timing.skill = ranking.getSkillType();
+                    timing.players = players.size();
+                    const auto rebuildStart = Clock::now();
+                    ranking.refresh(players, pool);
+                    auto snapshot = ranking.publish();
+                    const auto exportStart = Clock::now();
+                    timing.pages = snapshot->exportPages(pageSize, directory);
+                    timing.rebuild = std::chrono::duration_cast<std::chrono::microseconds>(exportStart - rebuildStart);
+                    timing.exportTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - exportStart);
+                    return timing;
+                }));
+            });
+
+            RankingRefreshReport report;
+            report.threads = pool.getThreadCount();
+            for (auto &task : tasks)
+            {
+                report.skills.push_back(pool.wait(task));
+            }
+            report.total = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+
+            for (const auto &timing : report.skills)
+            {
+                LM.log<Level::Info>("Ranking-{} refresh: {} players, rebuild {} us, export {} us ({} pages)",
+                                    SkillToString(timing.skill), timing.players, timing.rebuild.count(),
+                                    timing.exportTime.count(), timing.pages);
+            }
+            LM.log<Level::Info>("RankingManager::refreshAll: {} us with {} threads", report.total.count(), report.threads);
+            return report;
+        }
+
+        /**
+         * @brief Igual que refreshAll con pool, pero una skill detrás de otra en este hilo
+         */
+        RankingRefreshReport refreshAll(std::span<const Player *const> players, size_t pageSize,
+                                        const std::filesystem::path &directory = {})
+        {
+            WorkerPool callerOnly{0};
+            return refreshAll(players, pageSize, callerOnly, directory);
+        }
+
+        /**
+         * @brief Escribe la última instantánea de cada ranking en Ranking-<SKILL>.csv o .jsonl
+         * @return Número total de filas escritas
+         */
+        size_t exportRankings(ExportFormat format, const std::filesystem::path &directory = {})
+        {
+            size_t rows = 0;
+            forEachRanking([&](auto &ranking)
+            {
+                auto snapshot = ranking.getSnapshot();
+                const auto path = directory / ("Ranking-" + SkillToString(snapshot->getSkillType()) + std::string(ExportFormatExtension(format)));
+                std::ofstream out(path, std::ios::out | std::ios::trunc);
+                if (!out.is_open())
+                {
+                    LM.log<Level::Error>("Failed to open ranking export: {}", path.string());
+                    return;
+                }
+                rows += exportRanking(*snapshot, out, format);
+            });
+            return rows;
+        }
+
+        /**
+         * @brief Publica una instantánea de cada ranking que haya cambiado
+         * @return Número de rankings publicados
+         */
+        size_t publishSnapshots()
+        {
+            size_t published = 0;
+            forEachRanking([&published](auto &ranking)
+            {
+                if (ranking.hasUnpublishedChanges())
+                {
+                    ranking.publish();
+                    ++published;
+                }
+            });
+            _ticksSincePublish = 0;
+            return published;
+        }
+
+        /**
+         * @brief Cada cuántos ticks se publican las instantáneas; 0 solo con publishSnapshots()
+         */
+        void setSnapshotCadence(size_t ticks) noexcept { _snapshotCadence = ticks; }
+        [[nodiscard]] size_t getSnapshotCadence() const noexcept { return _snapshotCadence; }
+
+        /**
+         * @brief Llamado al final de cada tick de la simulación
+         */
+        void onTick()
         {
-            switch (skill)
+            if (_snapshotCadence != 0 && ++_ticksSincePublish >= _snapshotCadence)
             {
-            case SkillType::FIST:
-                return RANKING_FIST.getPlayerRanking(playerId);
-                break;
-            case SkillType::SWORD:
-                return RANKING_SWORD.getPlayerRanking(playerId);
-                break;
-            case SkillType::AXE:
-                return RANKING_AXE.getPlayerRanking(playerId);
-                break;
-            case SkillType::CLUB:
-                return RANKING_CLUB.getPlayerRanking(playerId);
-                break;
-            case SkillType::DISTANCE:
-                return RANKING_DISTANCE.getPlayerRanking(playerId);
-                break;
-            case SkillType::SHIELDING:
-                return RANKING_SHIELDING.getPlayerRanking(playerId);
-                break;
-            default:
-                return -1;
-                break;
+                publishSnapshots();
             }
         }
 
         void printAllRankings()
         {
             LM.writeLog(Level::Debug, "RankingManager::printAllRankings");
-            updateAllRankings();
             RANKING_FIST.printRanking();
             RANKING_SWORD.printRanking();
             RANKING_AXE.printRanking();
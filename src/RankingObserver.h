@@ -0,0 +1,77 @@
+#ifndef __RANKING_OBSERVER_H__
+#define __RANKING_OBSERVER_H__
+
+#include "EventObserver.h"
+#include "Ranking.h"
+#include <string>
+
+namespace noname
+{
+    /**
+     * @brief Observer que mantiene los rankings al día
+     *
+     * Con SKILL_IMPROVED mueve al personaje en el ranking de esa skill y con
+     * LEVEL_UP actualiza su nivel en todos. Los personajes que no se han
+     * añadido a los rankings se ignoran.
+     */
+    class RankingObserver : public EventObserver {
+    private:
+        unsigned long long appliedUpdates_{0};
+
+    public:
+        void onEvent(const Event& event) override {
+            switch (event.getType()) {
+                case EventType::SKILL_IMPROVED: {
+                    const auto* skill = event.tryPayload<SkillPayload>();
+                    if (skill && withSkillRanking(skill->skill, false, [skill](auto& ranking) {
+                            return ranking.updateSkill(skill->characterId, static_cast<short>(skill->value));
+                        })) {
+                        ++appliedUpdates_;
+                    }
+                    break;
+                }
+
+                case EventType::LEVEL_UP: {
+                    const auto* level = event.tryPayload<LevelPayload>();
+                    if (level) {
+                        updateLevel(level->characterId, static_cast<short>(level->newLevel));
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+        bool handlesEventType(EventType eventType) const override {
+            return eventType == EventType::SKILL_IMPROVED || eventType == EventType::LEVEL_UP;
+        }
+
+        std::string getObserverId() const override {
+            return "RankingObserver";
+        }
+
+        /**
+         * @brief Número de cambios de skill aplicados a algún ranking
+         */
+        unsigned long long getAppliedUpdates() const noexcept {
+            return appliedUpdates_;
+        }
+
+    private:
+        void updateLevel(int characterId, short level) {
+            bool updated = RANKING_FIST.updateLevel(characterId, level);
+            updated |= RANKING_SWORD.updateLevel(characterId, level);
+            updated |= RANKING_AXE.updateLevel(characterId, level);
+            updated |= RANKING_CLUB.updateLevel(characterId, level);
+            updated |= RANKING_DISTANCE.updateLevel(characterId, level);
+            updated |= RANKING_SHIELDING.updateLevel(characterId, level);
+            if (updated) {
+                ++appliedUpdates_;
+            }
+        }
+    };
+}
+
+#endif // __RANKING_OBSERVER_H__
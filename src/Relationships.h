@@ -2,10 +2,19 @@
 #define __RELATIONSHIPS_H__
 
 // System includes
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <tuple>
-#include <functional> // std::reference_wrapper
+#include <span>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+// Local includes
+#include "FlatIdMap.h"
 
 namespace noname
 {
@@ -21,133 +30,194 @@ namespace noname
         LAST_RELATIONSHIP
     };
 
+    /**
+     * @brief Grafo de relaciones entre entidades, indexado por id
+     *
+     * Cada entidad es un nodo con una lista de adyacencia de salida y otra de
+     * entrada por tipo de relación, así que las consultas cuestan O(grado) y
+     * devuelven ids sin copiar las entidades. Solo se guarda el id y el nombre
+     * de cada una (T necesita getId() y getNameView()); el nombre se indexa
+     * para las consultas por nombre, que agregan todas las entidades que lo
+     * comparten.
+     *
+     * Las aristas son dirigidas: PARENT va de padre a hijo, MARRIED de marido
+     * a mujer y ENEMY de depredador a presa. Añadir una arista repetida no
+     * tiene efecto.
+     */
     template <class T>
     class Relationships
     {
+    public:
+        static constexpr size_t RELATIONSHIP_COUNT = static_cast<size_t>(Relationship::LAST_RELATIONSHIP);
+
     private:
-        std::vector<std::tuple<T, Relationship, T>> _familyRelations;
-        std::vector<std::tuple<T, Relationship, T>> _predatoryRelations;
+        struct Node
+        {
+            int id;
+            std::string name;
+            std::array<std::vector<int>, RELATIONSHIP_COUNT> out;
+            std::array<std::vector<int>, RELATIONSHIP_COUNT> in;
+        };
+
+        // Permite buscar en el índice de nombres con string_view sin crear un std::string
+        struct NameHash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+        };
+
+        std::vector<Node> _nodes;
+        FlatIdMap<std::uint32_t> _index;
+        std::unordered_map<std::string, std::vector<int>, NameHash, std::equal_to<>> _names;
+        size_t _edges{0};
+
+        Node &node(const T &entity);
+        const Node *findNode(int id) const noexcept;
+        void addEdge(const T &from, Relationship relationship, const T &to);
+        std::span<const int> outgoing(int id, Relationship relationship) const noexcept;
+        std::span<const int> incoming(int id, Relationship relationship) const noexcept;
+        std::vector<int> collect(std::string_view name, Relationship relationship, bool fromName) const;
 
     public:
         void add_parents_and_child(const T &father, const T &mother, const T &child);
         void add_husband_and_wife(const T &husband, const T &wife);
         void add_predator_and_prey(const T &predator, const T &prey);
 
-        std::vector<T> find_all_children_of(const std::string &name);
-        std::vector<T> find_parents_of(const std::string &name);
-        std::vector<T> find_husband_of(const std::string &name);
-        std::vector<T> find_wife_of(const std::string &name);
-        std::vector<T> find_prey_of(const std::string &name);
-        std::vector<T> find_predator_of(const std::string &name);
+        // Consultas por id: vistas sobre las listas de adyacencia, válidas hasta el siguiente add_*
+        std::span<const int> children_of(int id) const noexcept { return outgoing(id, Relationship::PARENT); }
+        std::span<const int> parents_of(int id) const noexcept { return incoming(id, Relationship::PARENT); }
+        std::span<const int> husbands_of(int id) const noexcept { return incoming(id, Relationship::MARRIED); }
+        std::span<const int> wives_of(int id) const noexcept { return outgoing(id, Relationship::MARRIED); }
+        std::span<const int> prey_of(int id) const noexcept { return outgoing(id, Relationship::ENEMY); }
+        std::span<const int> predators_of(int id) const noexcept { return incoming(id, Relationship::ENEMY); }
+
+        // Consultas por nombre: ids de todas las entidades con ese nombre
+        std::vector<int> find_all_children_of(std::string_view name) const { return collect(name, Relationship::PARENT, true); }
+        std::vector<int> find_parents_of(std::string_view name) const { return collect(name, Relationship::PARENT, false); }
+        std::vector<int> find_husband_of(std::string_view name) const { return collect(name, Relationship::MARRIED, false); }
+        std::vector<int> find_wife_of(std::string_view name) const { return collect(name, Relationship::MARRIED, true); }
+        std::vector<int> find_prey_of(std::string_view name) const { return collect(name, Relationship::ENEMY, true); }
+        std::vector<int> find_predator_of(std::string_view name) const { return collect(name, Relationship::ENEMY, false); }
+
+        /**
+         * @brief Ids de las entidades registradas con ese nombre
+         */
+        std::span<const int> find_ids_named(std::string_view name) const noexcept;
+
+        /**
+         * @brief Nombre con el que se registró la entidad, o vacío si no está
+         */
+        std::string_view get_name(int id) const noexcept;
+
+        bool contains(int id) const noexcept { return _index.contains(id); }
+        size_t node_count() const noexcept { return _nodes.size(); }
+        size_t edge_count() const noexcept { return _edges; }
     };
 }
 
 namespace noname
 {
     template <class T>
-    void Relationships<T>::add_parents_and_child(const T &father, const T &mother, const T &child)
+    typename Relationships<T>::Node &Relationships<T>::node(const T &entity)
     {
-        _familyRelations.push_back({father, Relationship::PARENT, child});
-        _familyRelations.push_back({child, Relationship::CHILD, father});
-        _familyRelations.push_back({mother, Relationship::PARENT, child});
-        _familyRelations.push_back({child, Relationship::CHILD, mother});
+        const int id = entity.getId();
+        auto [index, inserted] = _index.tryEmplace(id, static_cast<std::uint32_t>(_nodes.size()));
+        if (inserted)
+        {
+            _nodes.push_back(Node{id, std::string(entity.getNameView()), {}, {}});
+            auto named = _names.find(entity.getNameView());
+            if (named == _names.end())
+            {
+                named = _names.emplace(std::string(entity.getNameView()), std::vector<int>{}).first;
+            }
+            named->second.push_back(id);
+        }
+        return _nodes[index];
     }
 
     template <class T>
-    void Relationships<T>::add_husband_and_wife(const T &husband, const T &wife)
+    const typename Relationships<T>::Node *Relationships<T>::findNode(int id) const noexcept
     {
-        _familyRelations.push_back({husband, Relationship::MARRIED, wife});
+        const std::uint32_t *index = _index.find(id);
+        return index ? &_nodes[*index] : nullptr;
     }
 
     template <class T>
-    void Relationships<T>::add_predator_and_prey(const T &predator, const T &prey)
+    void Relationships<T>::addEdge(const T &from, Relationship relationship, const T &to)
     {
-        _predatoryRelations.push_back({predator, Relationship::ENEMY, prey});
+        const size_t kind = static_cast<size_t>(relationship);
+        // node() puede hacer crecer _nodes: se resuelven los dos antes de guardar referencias
+        node(from);
+        node(to);
+        Node &source = _nodes[*_index.find(from.getId())];
+        auto &out = source.out[kind];
+        if (std::find(out.begin(), out.end(), to.getId()) != out.end())
+        {
+            return;
+        }
+        out.push_back(to.getId());
+        _nodes[*_index.find(to.getId())].in[kind].push_back(from.getId());
+        ++_edges;
     }
 
     template <class T>
-    std::vector<T> Relationships<T>::find_all_children_of(const std::string &name)
+    std::span<const int> Relationships<T>::outgoing(int id, Relationship relationship) const noexcept
     {
-        std::vector<T> result;
-        for (auto &&[first, rel, second] : _familyRelations)
-        {
-            if (first.getName() == name && rel == Relationship::PARENT)
-            {
-                result.push_back(second);
-            }
-        }
-        return result;
+        const Node *found = findNode(id);
+        return found ? std::span<const int>{found->out[static_cast<size_t>(relationship)]} : std::span<const int>{};
     }
 
     template <class T>
-    std::vector<T> Relationships<T>::find_parents_of(const std::string &name)
+    std::span<const int> Relationships<T>::incoming(int id, Relationship relationship) const noexcept
     {
-        std::vector<T> result;
-        for (auto &&[first, rel, second] : _familyRelations)
-        {
-            if (first.getName() == name && rel == Relationship::CHILD)
-            {
-                result.push_back(second);
-            }
-        }
-        return result;
+        const Node *found = findNode(id);
+        return found ? std::span<const int>{found->in[static_cast<size_t>(relationship)]} : std::span<const int>{};
     }
 
     template <class T>
-    std::vector<T> Relationships<T>::find_husband_of(const std::string &name)
+    std::vector<int> Relationships<T>::collect(std::string_view name, Relationship relationship, bool fromName) const
     {
-        std::vector<T> result;
-        for (auto &&[first, rel, second] : _familyRelations)
+        std::vector<int> result;
+        for (int id : find_ids_named(name))
         {
-            if (second.getName() == name && rel == Relationship::MARRIED)
-            {
-                result.push_back(first);
-            }
+            auto related = fromName ? outgoing(id, relationship) : incoming(id, relationship);
+            result.insert(result.end(), related.begin(), related.end());
         }
         return result;
     }
 
     template <class T>
-    std::vector<T> Relationships<T>::find_wife_of(const std::string &name)
+    std::span<const int> Relationships<T>::find_ids_named(std::string_view name) const noexcept
     {
-        std::vector<T> result;
-        for (auto &&[first, rel, second] : _familyRelations)
-        {
-            if (first.getName() == name && rel == Relationship::MARRIED)
-            {
-                result.push_back(second);
-            }
-        }
-        return result;
+        auto named = _names.find(name);
+        return named != _names.end() ? std::span<const int>{named->second} : std::span<const int>{};
     }
 
     template <class T>
-    std::vector<T> Relationships<T>::find_prey_of(const std::string &name)
+    std::string_view Relationships<T>::get_name(int id) const noexcept
     {
-        std::vector<T> result;
-        for (auto &&[first, rel, second] : _predatoryRelations)
-        {
-            if (first.getName() == name && rel == Relationship::ENEMY)
-            {
-                result.push_back(second);
-            }
-        }
-        return result;
+        const Node *found = findNode(id);
+        return found ? std::string_view{found->name} : std::string_view{};
     }
 
     template <class T>
-    std::vector<T> Relationships<T>::find_predator_of(const std::string &name)
+    void Relationships<T>::add_parents_and_child(const T &father, const T &mother, const T &child)
     {
-        std::vector<T> result;
-        for (auto &&[first, rel, second] : _predatoryRelations)
-        {
-            if (second.getName() == name && rel == Relationship::ENEMY)
-            {
-                result.push_back(first);
-            }
-        }
-        return result;
+        addEdge(father, Relationship::PARENT, child);
+        addEdge(mother, Relationship::PARENT, child);
+    }
+
+    template <class T>
+    void Relationships<T>::add_husband_and_wife(const T &husband, const T &wife)
+    {
+        addEdge(husband, Relationship::MARRIED, wife);
+    }
+
+    template <class T>
+    void Relationships<T>::add_predator_and_prey(const T &predator, const T &prey)
+    {
+        addEdge(predator, Relationship::ENEMY, prey);
     }
 }
 
-#endif // __RELATIONSHIPS_H__
\ No newline at end of file
+#endif // __RELATIONSHIPS_H__
@@ -0,0 +1,177 @@
+#ifndef __RNG_H__
+#define __RNG_H__
+
+// System includes
+#include <array>
+#include <atomic>
+#include <random>
+#include <cstdint>
+#include <limits>
+
+namespace noname
+{
+    /**
+     * @brief Generador pseudoaleatorio xoshiro256** con semilla explícita
+     *
+     * 32 bytes de estado (std::mt19937 ocupa 2.5 KB) y se siembra con
+     * splitmix64 a partir de un único entero, así que crear uno es barato y
+     * reproducible. Cumple UniformRandomBitGenerator, de modo que también
+     * sirve con las distribuciones de <random>.
+     *
+     * threadLocal() da un generador por hilo. Su semilla sale de una semilla
+     * base (aleatoria al arrancar, o la de setDefaultSeed()) y del orden en
+     * que cada hilo lo pide. setDefaultSeed() cambia de época y todos los
+     * hilos, también los que ya lo usaban, se resiembran en su siguiente uso,
+     * así que la secuencia solo depende de la semilla y de ese orden. Si el
+     * orden entre hilos no es fijo, hay que pasar un Rng propio.
+     */
+    class Rng
+    {
+    public:
+        using result_type = std::uint64_t;
+
+    private:
+        std::array<std::uint64_t, 4> _state{};
+
+        static constexpr std::uint64_t rotl(std::uint64_t value, int shift) noexcept
+        {
+            return (value << shift) | (value >> (64 - shift));
+        }
+
+        static std::atomic<std::uint64_t> &defaultSeed() noexcept
+        {
+            static std::atomic<std::uint64_t> seed{std::random_device{}()};
+            return seed;
+        }
+
+        static std::atomic<std::uint64_t> &threadCounter() noexcept
+        {
+            static std::atomic<std::uint64_t> counter{0};
+            return counter;
+        }
+
+        // Cambia con cada setDefaultSeed(); los generadores por hilo de otra época se resiembran
+        static std::atomic<std::uint64_t> &seedEpoch() noexcept
+        {
+            static std::atomic<std::uint64_t> epoch{0};
+            return epoch;
+        }
+
+        static Rng &threadRng() noexcept
+        {
+            thread_local Rng rng;
+            return rng;
+        }
+
+        // Época de la semilla con la que se sembró threadRng(); ninguna al empezar
+        static std::uint64_t &threadEpoch() noexcept
+        {
+            thread_local std::uint64_t epoch{~std::uint64_t{0}};
+            return epoch;
+        }
+
+    public:
+        explicit Rng(std::uint64_t seedValue = 0) noexcept { seed(seedValue); }
+
+        /**
+         * @brief Mezcla de 64 bits de splitmix64; también sirve para derivar semillas
+         */
+        static constexpr std::uint64_t mix(std::uint64_t value) noexcept
+        {
+            value += 0x9E3779B97F4A7C15ULL;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+            return value ^ (value >> 31);
+        }
+
+        void seed(std::uint64_t value) noexcept
+        {
+            for (auto &word : _state)
+            {
+                value += 0x9E3779B97F4A7C15ULL;
+                word = mix(value);
+            }
+        }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() noexcept
+        {
+            const std::uint64_t result = rotl(_state[1] * 5, 7) * 9;
+            const std::uint64_t shifted = _state[1] << 17;
+            _state[2] ^= _state[0];
+            _state[3] ^= _state[1];
+            _state[1] ^= _state[2];
+            _state[0] ^= _state[3];
+            _state[2] ^= shifted;
+            _state[3] = rotl(_state[3], 45);
+            return result;
+        }
+
+        /**
+         * @brief Entero uniforme en [0, range), sin sesgo (método de Lemire); range > 0
+         */
+        std::uint64_t uniformIndex(std::uint64_t range) noexcept
+        {
+            unsigned __int128 product = static_cast<unsigned __int128>((*this)()) * range;
+            auto fraction = static_cast<std::uint64_t>(product);
+            if (fraction < range)
+            {
+                const std::uint64_t threshold = (0 - range) % range;
+                while (fraction < threshold)
+                {
+                    product = static_cast<unsigned __int128>((*this)()) * range;
+                    fraction = static_cast<std::uint64_t>(product);
+                }
+            }
+            return static_cast<std::uint64_t>(product >> 64);
+        }
+
+        /**
+         * @brief Entero uniforme en [low, high], sin sesgo
+         */
+        int uniformInt(int low, int high) noexcept
+        {
+            const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(high) - low) + 1;
+            return static_cast<int>(low + static_cast<std::int64_t>(uniformIndex(range)));
+        }
+
+        // Real uniforme en [0, 1) con 53 bits de precisión
+        double uniformReal() noexcept { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+        double uniformReal(double low, double high) noexcept { return low + (high - low) * uniformReal(); }
+        bool chance(double probability) noexcept { return uniformReal() < probability; }
+
+        /**
+         * @brief Generador del hilo actual
+         */
+        static Rng &threadLocal() noexcept
+        {
+            Rng &rng = threadRng();
+            const std::uint64_t epoch = seedEpoch().load(std::memory_order_acquire);
+            if (threadEpoch() != epoch)
+            {
+                threadEpoch() = epoch;
+                rng.seed(mix(defaultSeed().load(std::memory_order_relaxed) ^ mix(threadCounter().fetch_add(1, std::memory_order_relaxed))));
+            }
+            return rng;
+        }
+
+        /**
+         * @brief Fija la semilla base de los generadores por hilo
+         *
+         * Resiembra el del hilo que llama con ella tal cual; el resto de hilos
+         * resiembra el suyo en su siguiente threadLocal(), a partir de ella y
+         * de su orden de llegada tras el cambio (1, 2, ...).
+         */
+        static void setDefaultSeed(std::uint64_t seedValue) noexcept
+        {
+            defaultSeed().store(seedValue, std::memory_order_relaxed);
+            threadCounter().store(1, std::memory_order_relaxed);
+            threadEpoch() = seedEpoch().fetch_add(1, std::memory_order_acq_rel) + 1;
+            threadRng().seed(seedValue);
+        }
+    };
+}
+
+#endif // __RNG_H__
@@ -3,6 +3,7 @@
 
 // System includes
 #include <string>
+#include <string_view>
 
 namespace noname
 {
@@ -17,7 +18,8 @@ namespace noname
         LAST_SKILL
     };
 
-    static std::string SkillToString(SkillType s)
+    // Nombre del skill sin reservar memoria (lo usa el formateo diferido del log)
+    constexpr std::string_view toLogString(SkillType s)
     {
         switch (s)
         {
@@ -36,6 +38,11 @@ namespace noname
         default:
             return "";
         }
+    }
+
+    static std::string SkillToString(SkillType s)
+    {
+        return std::string(toLogString(s));
     };
 
     class Skill
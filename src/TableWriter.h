@@ -0,0 +1,233 @@
+#ifndef __TABLE_WRITER_H__
+#define __TABLE_WRITER_H__
+
+// System includes
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <charconv>
+#include <type_traits>
+#include <cstddef>
+
+namespace noname
+{
+    /**
+     * @brief Formatos de exportación para herramientas externas
+     */
+    enum class ExportFormat
+    {
+        Csv,       // Cabecera y una línea por fila, separadas por comas
+        JsonLines  // Un objeto JSON por línea
+    };
+
+    inline std::string_view ExportFormatExtension(ExportFormat format)
+    {
+        return format == ExportFormat::Csv ? ".csv" : ".jsonl";
+    }
+
+    /**
+     * @brief Escritor de tablas en CSV o JSON lines, fila a fila
+     *
+     * Las columnas se fijan al crearlo; cada fila es beginRow(), un field()
+     * por columna en ese orden y endRow(). Escribe en un búfer interno que se
+     * vuelca al stream por bloques, sin construir nada por fila.
+     *
+     * Los nombres de columna se guardan como string_view: deben seguir vivos
+     * mientras exista el writer (normalmente son un array estático).
+     */
+    class TableWriter
+    {
+    public:
+        static constexpr size_t DEFAULT_FLUSH_THRESHOLD = 64 * 1024;
+
+    private:
+        std::ostream &_stream;
+        ExportFormat _format;
+        std::span<const std::string_view> _columns;
+        std::string _buffer;
+        size_t _flushThreshold;
+        size_t _field{0};
+        size_t _rows{0};
+
+        void separator()
+        {
+            if (_format == ExportFormat::Csv)
+            {
+                if (_field > 0)
+                {
+                    _buffer.push_back(',');
+                }
+            }
+            else
+            {
+                _buffer.append(_field > 0 ? ",\"" : "\"");
+                _buffer.append(_field < _columns.size() ? _columns[_field] : std::string_view{"extra"});
+                _buffer.append("\":");
+            }
+            ++_field;
+        }
+
+        void appendCsv(std::string_view value)
+        {
+            if (value.find_first_of(",\"\r\n") == std::string_view::npos)
+            {
+                _buffer.append(value);
+                return;
+            }
+            _buffer.push_back('"');
+            for (char c : value)
+            {
+                if (c == '"')
+                {
+                    _buffer.push_back('"');
+                }
+                _buffer.push_back(c);
+            }
+            _buffer.push_back('"');
+        }
+
+        void appendJson(std::string_view value)
+        {
+            static constexpr char HEX[] = "0123456789abcdef";
+            _buffer.push_back('"');
+            for (char c : value)
+            {
+                switch (c)
+                {
+                case '"':
+                    _buffer.append("\\\"");
+                    break;
+                case '\\':
+                    _buffer.append("\\\\");
+                    break;
+                case '\n':
+                    _buffer.append("\\n");
+                    break;
+                case '\r':
+                    _buffer.append("\\r");
+                    break;
+                case '\t':
+                    _buffer.append("\\t");
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        _buffer.append("\\u00");
+                        _buffer.push_back(HEX[(c >> 4) & 0xF]);
+                        _buffer.push_back(HEX[c & 0xF]);
+                    }
+                    else
+                    {
+                        _buffer.push_back(c);
+                    }
+                    break;
+                }
+            }
+            _buffer.push_back('"');
+        }
+
+    public:
+        /**
+         * @brief En CSV escribe la cabecera en cuanto se crea
+         */
+        TableWriter(std::ostream &stream, ExportFormat format, std::span<const std::string_view> columns,
+                    size_t flushThreshold = DEFAULT_FLUSH_THRESHOLD)
+            : _stream(stream), _format(format), _columns(columns), _flushThreshold(flushThreshold)
+        {
+            _buffer.reserve(flushThreshold + 1024);
+            if (_format == ExportFormat::Csv)
+            {
+                for (size_t i = 0; i < _columns.size(); ++i)
+                {
+                    if (i > 0)
+                    {
+                        _buffer.push_back(',');
+                    }
+                    _buffer.append(_columns[i]);
+                }
+                _buffer.push_back('\n');
+            }
+        }
+
+        ~TableWriter()
+        {
+            flush();
+        }
+
+        TableWriter(const TableWriter &) = delete;
+        TableWriter &operator=(const TableWriter &) = delete;
+
+        TableWriter &beginRow()
+        {
+            _field = 0;
+            if (_format == ExportFormat::JsonLines)
+            {
+                _buffer.push_back('{');
+            }
+            return *this;
+        }
+
+        TableWriter &field(std::string_view value)
+        {
+            separator();
+            if (_format == ExportFormat::Csv)
+            {
+                appendCsv(value);
+            }
+            else
+            {
+                appendJson(value);
+            }
+            return *this;
+        }
+
+        template <typename T>
+            requires std::is_arithmetic_v<T>
+        TableWriter &field(T value)
+        {
+            separator();
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                _buffer.append(value ? "true" : "false");
+            }
+            else
+            {
+                std::array<char, 32> digits;
+                auto [end, error] = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+                _buffer.append(digits.data(), end);
+            }
+            return *this;
+        }
+
+        TableWriter &endRow()
+        {
+            if (_format == ExportFormat::JsonLines)
+            {
+                _buffer.push_back('}');
+            }
+            _buffer.push_back('\n');
+            ++_rows;
+            if (_buffer.size() >= _flushThreshold)
+            {
+                flush();
+            }
+            return *this;
+        }
+
+        [[nodiscard]] size_t getRowCount() const noexcept { return _rows; }
+        [[nodiscard]] ExportFormat getFormat() const noexcept { return _format; }
+
+        void flush()
+        {
+            if (!_buffer.empty())
+            {
+                _stream.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+                _buffer.clear();
+            }
+        }
+    };
+}
+
+#endif // __TABLE_WRITER_H__
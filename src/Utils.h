@@ -1,9 +1,10 @@
 #ifndef __UTILS_H__
 #define __UTILS_H__
 
-#include <random>
 #include <type_traits>
 
+#include "Rng.h"
+
 namespace noname
 {
     class Utils
@@ -11,10 +12,7 @@ namespace noname
     public:
         static int rollDie(int min, int max)
         {
-            static thread_local std::random_device dev;
-            static thread_local std::mt19937 rng(dev());
-            std::uniform_int_distribution<int> dist(min, max);
-            return dist(rng);
+            return Rng::threadLocal().uniformInt(min, max);
         }
 
         template <typename T>
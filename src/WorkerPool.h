@@ -0,0 +1,275 @@
+#ifndef __WORKER_POOL_H__
+#define __WORKER_POOL_H__
+
+// System includes
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <exception>
+#include <memory>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+namespace noname
+{
+    /**
+     * @brief Grupo fijo de hilos que ejecutan tareas de una cola común
+     *
+     * El hilo que espera un resultado con wait() no se bloquea: mientras el
+     * resultado no está listo ejecuta tareas pendientes. Así una tarea puede
+     * lanzar subtareas y esperarlas sin agotar los hilos, y un pool sin
+     * hilos (WorkerPool{0}) ejecuta todo en el hilo que espera, en orden.
+     */
+    class WorkerPool
+    {
+    private:
+        std::vector<std::thread> _threads;
+        std::deque<std::function<void()>> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _wakeUp;
+        bool _stopping{false};
+
+        void workerLoop()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _wakeUp.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                    if (_tasks.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(_tasks.front());
+                    _tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+    public:
+        /**
+         * @param threadCount Hilos propios del pool; 0 ejecuta las tareas en quien espera
+         */
+        explicit WorkerPool(size_t threadCount = std::max(1u, std::thread::hardware_concurrency()))
+        {
+            _threads.reserve(threadCount);
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                _threads.emplace_back([this]() { workerLoop(); });
+            }
+        }
+
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _wakeUp.notify_all();
+            for (auto &thread : _threads)
+            {
+                thread.join();
+            }
+        }
+
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        [[nodiscard]] size_t getThreadCount() const noexcept { return _threads.size(); }
+
+        /**
+         * @brief Encola una tarea
+         * @return Futuro con el resultado; esperarlo con wait()
+         */
+        template <typename F>
+        auto submit(F &&function) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+        {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            // std::function necesita algo copiable
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(function));
+            auto future = task->get_future();
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _tasks.emplace_back([task]() { (*task)(); });
+            }
+            _wakeUp.notify_one();
+            return future;
+        }
+
+        /**
+         * @brief Ejecuta en este hilo una tarea pendiente, si hay alguna
+         */
+        bool runPendingTask()
+        {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_tasks.empty())
+                {
+                    return false;
+                }
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+            return true;
+        }
+
+        /**
+         * @brief Espera un resultado ejecutando tareas pendientes mientras tanto
+         *
+         * Relanza la excepción de la tarea, como std::future::get().
+         */
+        template <typename T>
+        T wait(std::future<T> &future)
+        {
+            while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                if (!runPendingTask())
+                {
+                    future.wait_for(std::chrono::microseconds(50));
+                }
+            }
+            return future.get();
+        }
+
+        /**
+         * @brief Espera todos los resultados, aunque alguno falle
+         *
+         * Relanza la primera excepción, pero solo cuando ya no queda ninguna
+         * tarea en marcha: pueden usar variables locales de quien espera.
+         */
+        template <typename T>
+        void waitAll(std::vector<std::future<T>> &futures)
+        {
+            std::exception_ptr error;
+            for (auto &future : futures)
+            {
+                try
+                {
+                    wait(future);
+                }
+                catch (...)
+                {
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        /**
+         * @brief Llama a body(begin, end) sobre trozos de [0, count) en paralelo
+         *
+         * Los trozos tienen al menos minChunk elementos; si solo sale uno se
+         * ejecuta directamente en el hilo que llama. Si body lanza, la
+         * excepción sale cuando han terminado todos los trozos.
+         */
+        template <typename F>
+        void parallelFor(size_t count, size_t minChunk, F &&body)
+        {
+            const size_t maxChunks = std::max<size_t>(1, getThreadCount() + 1);
+            const size_t chunks = std::clamp<size_t>(count / std::max<size_t>(minChunk, 1), 1, maxChunks);
+            if (chunks == 1)
+            {
+                body(size_t{0}, count);
+                return;
+            }
+            std::vector<std::future<void>> futures;
+            futures.reserve(chunks - 1);
+            const size_t step = count / chunks;
+            for (size_t chunk = 1; chunk < chunks; ++chunk)
+            {
+                const size_t begin = chunk * step;
+                const size_t end = chunk + 1 == chunks ? count : begin + step;
+                futures.push_back(submit([&body, begin, end]() { body(begin, end); }));
+            }
+            // Los trozos del pool usan body por referencia: hay que esperarlos aunque este falle
+            std::exception_ptr error;
+            try
+            {
+                body(size_t{0}, step);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            if (error)
+            {
+                try
+                {
+                    waitAll(futures);
+                }
+                catch (...)
+                {
+                }
+                std::rethrow_exception(error);
+            }
+            waitAll(futures);
+        }
+    };
+
+    /**
+     * @brief Ordena por trozos en el pool y mezcla los trozos por parejas
+     *
+     * Con menos de minParallel elementos, o un pool sin hilos, equivale a std::sort.
+     */
+    template <typename RandomIt, typename Compare>
+    void parallelSort(WorkerPool &pool, RandomIt first, RandomIt last, Compare less, size_t minParallel = size_t{1} << 15)
+    {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        const size_t maxChunks = pool.getThreadCount() + 1;
+        if (count < minParallel || maxChunks < 2)
+        {
+            std::sort(first, last, less);
+            return;
+        }
+        // Límites de los trozos: [bounds[i], bounds[i + 1])
+        const size_t chunks = std::min(maxChunks, count / (minParallel / 2));
+        std::vector<size_t> bounds;
+        for (size_t chunk = 0; chunk <= chunks; ++chunk)
+        {
+            bounds.push_back(count * chunk / chunks);
+        }
+
+        std::vector<std::future<void>> futures;
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            futures.push_back(pool.submit([=]() { std::sort(first + bounds[chunk], first + bounds[chunk + 1], less); }));
+        }
+        pool.waitAll(futures);
+
+        // Cada ronda mezcla parejas vecinas y reduce los trozos a la mitad
+        while (bounds.size() > 2)
+        {
+            futures.clear();
+            std::vector<size_t> merged{0};
+            for (size_t i = 0; i + 2 < bounds.size(); i += 2)
+            {
+                const size_t begin = bounds[i], middle = bounds[i + 1], end = bounds[i + 2];
+                futures.push_back(pool.submit([=]() { std::inplace_merge(first + begin, first + middle, first + end, less); }));
+                merged.push_back(end);
+            }
+            if (merged.back() != bounds.back())
+            {
+                merged.push_back(bounds.back()); // Trozo impar: pasa tal cual
+            }
+            pool.waitAll(futures);
+            bounds.swap(merged);
+        }
+    }
+}
+
+#endif // __WORKER_POOL_H__
@@ -11,6 +11,10 @@
 #include "Creature.h"
 #include "CreaturesManager.h"
 #include "Player.h"
+#include "CharacterStore.h"
+#include "CharacterReportCache.h"
+#include "EventQueue.h"
+#include "RankingManager.h"
 
 // Two-letter acronym for easier access to manager
 #define World noname::WorldManager::getInstance()
@@ -20,8 +24,15 @@ namespace noname
     class WorldManager : public Manager, public Singleton<WorldManager>
     {
     private:
+        // Los datos de las criaturas del mundo viven en un almacén SoA propio
+        std::shared_ptr<CharacterStore> _store{std::make_shared<CharacterStore>()};
         std::vector<std::unique_ptr<Creature>> _creatures;
         std::unique_ptr<Player> _player;
+        CharacterReportCache _reports;
+        bool _deferredEvents{false};
+
+        static constexpr int HEALTH_REGEN_PER_TICK = 1;
+        static constexpr int MANA_REGEN_PER_TICK = 1;
 
     public:
         ~WorldManager() override = default;
@@ -37,6 +48,7 @@ namespace noname
 
         void shutDown() noexcept override
         {
+            _reports.clear();
             _creatures.clear();
             Manager::shutDown();
             LM.writeLog(Level::Debug, "WorldManager::shutDown");
@@ -46,13 +58,81 @@ namespace noname
         {
             for (const auto &creature : CM.getCreaturesList())
             {
-                _creatures.push_back(std::make_unique<Creature>(*creature.second));
+                _creatures.push_back(std::make_unique<Creature>(*creature.second, _store));
+                _creatures.back()->setDeferredNotifications(_deferredEvents);
+                _reports.track(*_creatures.back());
+                CM.getFactions().copyMembership(creature.second->getId(), _creatures.back()->getId());
+            }
+        }
+
+        /**
+         * @brief Crea count copias de una criatura en el almacén del mundo
+         *
+         * Las copias entran en la facción del prototipo.
+         */
+        void spawnCreatures(const Creature &prototype, size_t count)
+        {
+            _store->reserve(_store->size() + count);
+            _creatures.reserve(_creatures.size() + count);
+            _reports.reserve(_reports.size() + count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                _creatures.push_back(std::make_unique<Creature>(prototype, _store));
+                _creatures.back()->setDeferredNotifications(_deferredEvents);
+                _reports.track(*_creatures.back());
+                CM.getFactions().copyMembership(prototype.getId(), _creatures.back()->getId());
+            }
+        }
+
+        /**
+         * @brief Pasada masiva por tick: recorre el almacén de forma lineal
+         * y al final entrega los eventos diferidos del tick y publica los rankings
+         */
+        void tick() noexcept
+        {
+            _store->regenerate(HEALTH_REGEN_PER_TICK, MANA_REGEN_PER_TICK);
+            EQ.flush();
+            // Los eventos ya han actualizado los rankings: los lectores ven el tick completo
+            RM.onTick();
+        }
+
+        /**
+         * @brief Los eventos de las criaturas y del jugador se entregan al final del tick
+         */
+        void setDeferredEvents(bool deferred)
+        {
+            _deferredEvents = deferred;
+            for (auto &creature : _creatures)
+            {
+                creature->setDeferredNotifications(deferred);
+            }
+            if (_player)
+            {
+                _player->setDeferredNotifications(deferred);
             }
         }
 
+        [[nodiscard]] bool isDeferredEvents() const noexcept { return _deferredEvents; }
+
+        /**
+         * @brief Encola en RS los informes de las criaturas que han cambiado
+         * desde la última llamada
+         * @return Número de informes regenerados
+         */
+        size_t exportChangedReports()
+        {
+            return _reports.exportChanged(*_store);
+        }
+
+        [[nodiscard]] const CharacterReportCache &getReportCache() const noexcept { return _reports; }
+
+        [[nodiscard]] CharacterStore &getStore() noexcept { return *_store; }
+        [[nodiscard]] const std::vector<std::unique_ptr<Creature>> &getCreatures() const noexcept { return _creatures; }
+
         void addPlayer()
         {
             _player = std::make_unique<Player>("Vagadonnaego");
+            _player->setDeferredNotifications(_deferredEvents);
         }
     };
 }
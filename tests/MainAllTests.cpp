@@ -1,22 +1,35 @@
 #include "gtest/gtest.h"
 
+#include "TestBreeding.cpp"
 #include "TestCharacter.cpp"
+#include "TestCharacterReportCache.cpp"
+#include "TestCharacterReportSink.cpp"
+#include "TestCharacterStore.cpp"
 #include "TestContainer.cpp"
 #include "TestCreature.cpp"
 #include "TestCreatureManager.cpp"
+#include "TestEventQueue.cpp"
+#include "TestExporters.cpp"
+#include "TestFactions.cpp"
 #include "TestFileManager.cpp"
+#include "TestFlatIdMap.cpp"
 #include "TestFlyweightPattern.cpp"
 #include "TestGameManager.cpp"
+#include "TestGenealogy.cpp"
 #include "TestHeritables.cpp"
 #include "TestHtmlBuilder.cpp"
+#include "TestHtmlWriter.cpp"
 #include "TestInventory.cpp"
 #include "TestItem.cpp"
 #include "TestItemEnumTypes.cpp"
 #include "TestItemManager.cpp"
 #include "TestLogManager.cpp"
 #include "TestManager.cpp"
+#include "TestMatchmaking.cpp"
 #include "TestObserverPattern.cpp"
+#include "TestOrderStatisticTree.cpp"
 #include "TestPlayer.cpp"
+#include "TestPopulationStats.cpp"
 #include "TestProperty.cpp"
 #include "TestRanking.cpp"
 #include "TestRankingManager.cpp"
@@ -26,6 +39,7 @@
 #include "TestUtils.cpp"
 #include "TestWeapon.cpp"
 #include "TestWeaponsManager.cpp"
+#include "TestWorkerPool.cpp"
 
 int main(int argc, char **argv)
 {
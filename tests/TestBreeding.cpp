@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "Breeding.h"
+#include "WorkerPool.h"
+
+using namespace noname;
+using namespace testing;
+
+namespace
+{
+    BreedingSimulator::Config smallConfig()
+    {
+        BreedingSimulator::Config config;
+        config.population = 50000; // Varios trozos de MIN_CHUNK
+        config.seed = 17;
+        return config;
+    }
+}
+
+TEST(TestBreeding, resultDoesNotDependOnThreadCount)
+{
+    WorkerPool serial{0}, parallel{3};
+    BreedingSimulator first{smallConfig()}, second{smallConfig()};
+    first.seedFounders(serial);
+    second.seedFounders(parallel);
+    for (int generation = 0; generation < 5; ++generation)
+    {
+        const GenerationStats &a = first.step(serial);
+        const GenerationStats &b = second.step(parallel);
+        ASSERT_EQ(a.generation, b.generation);
+        ASSERT_EQ(a.mean, b.mean);
+        ASSERT_EQ(a.stddev, b.stddev);
+    }
+    auto a = first.getPopulation(), b = second.getPopulation();
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_EQ(a[i].values(), b[i].values());
+    }
+}
+
+TEST(TestBreeding, statsMatchThePopulation)
+{
+    WorkerPool pool{2};
+    BreedingSimulator simulator{smallConfig()};
+    simulator.seedFounders(pool);
+    const GenerationStats &stats = simulator.step(pool);
+    ASSERT_EQ(stats.generation, 1u);
+    ASSERT_EQ(stats.population, 50000u);
+
+    for (size_t gene = 0; gene < Heritables::COUNT; ++gene)
+    {
+        double sum = 0.0, sumSquares = 0.0;
+        int min = 255, max = 0;
+        for (const auto &individual : simulator.getPopulation())
+        {
+            const int value = individual.values()[gene];
+            sum += value;
+            sumSquares += static_cast<double>(value) * value;
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+        const double mean = sum / 50000.0;
+        ASSERT_NEAR(stats.mean[gene], mean, 1e-9);
+        ASSERT_NEAR(stats.stddev[gene], std::sqrt(sumSquares / 50000.0 - mean * mean), 1e-9);
+        ASSERT_EQ(stats.min[gene], min);
+        ASSERT_EQ(stats.max[gene], max);
+    }
+}
+
+TEST(TestBreeding, seedChangesTheOutcome)
+{
+    WorkerPool pool{0};
+    auto config = smallConfig();
+    BreedingSimulator first{config};
+    config.seed = 18;
+    BreedingSimulator second{config};
+    ASSERT_NE(first.seedFounders(pool).mean, second.seedFounders(pool).mean);
+}
+
+TEST(TestBreeding, tournamentSelectsForWeightedHeritables)
+{
+    WorkerPool pool{0};
+    auto config = smallConfig();
+    config.population = 20000;
+    config.tournament = 4;
+    config.weights = {1, 0, 0, 0, 0, 0}; // Solo cuenta STRENGTH
+    BreedingSimulator simulator{config};
+    const double founders = simulator.seedFounders(pool).mean[0];
+    double strength = founders;
+    for (int generation = 0; generation < 10; ++generation)
+    {
+        strength = simulator.step(pool).mean[0];
+    }
+    ASSERT_GT(strength, founders + 20.0);
+}
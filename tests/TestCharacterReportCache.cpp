@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "CharacterReportCache.h"
+#include "CharacterReportSink.h"
+#include "Character.h"
+
+// System includes
+#include <memory>
+#include <vector>
+
+using namespace noname;
+using namespace testing;
+
+struct TestCharacterReportCache : Test
+{
+    std::shared_ptr<CharacterStore> store{std::make_shared<CharacterStore>()};
+    std::vector<std::unique_ptr<Character>> characters;
+    CharacterReportCache cache;
+
+    void SetUp() override
+    {
+        RS.setShardCount(1);
+        RS.startUp();
+        for (int i = 0; i < 10; ++i)
+        {
+            characters.push_back(std::make_unique<Character>("Hero", store));
+            cache.track(*characters.back());
+        }
+    }
+    void TearDown() override
+    {
+        RS.shutDown();
+    }
+};
+
+TEST_F(TestCharacterReportCache, firstExportRendersEveryone)
+{
+    EXPECT_EQ(cache.exportChanged(*store), characters.size());
+    EXPECT_EQ(RS.getPendingCount(), characters.size());
+    for (const auto &character : characters)
+    {
+        const std::string *report = cache.getReport(character->getId());
+        ASSERT_NE(report, nullptr);
+        EXPECT_NE(report->find("Character Info: " + std::to_string(character->getId())), std::string::npos);
+    }
+}
+
+TEST_F(TestCharacterReportCache, onlyChangedCharactersAreRendered)
+{
+    cache.exportChanged(*store);
+    const size_t renders = cache.getRenderCount();
+    EXPECT_EQ(cache.exportChanged(*store), 0);
+
+    characters[3]->takeDamage(7);
+    characters[8]->gainExperience(10);
+    EXPECT_EQ(cache.exportChanged(*store), 2);
+    EXPECT_EQ(cache.getRenderCount(), renders + 2);
+
+    const std::string *report = cache.getReport(characters[3]->getId());
+    ASSERT_NE(report, nullptr);
+    std::string expected;
+    characters[3]->renderCharacterInfo(expected);
+    EXPECT_EQ(*report, expected);
+}
+
+TEST_F(TestCharacterReportCache, exportAllComparesVersions)
+{
+    EXPECT_EQ(cache.exportAll(), characters.size());
+    characters[0]->gainMana(1);
+    characters[0]->takeDamage(1);
+    EXPECT_EQ(cache.exportAll(), 1);
+    EXPECT_EQ(cache.exportAll(), 0);
+}
+
+TEST_F(TestCharacterReportCache, untrackedCharactersAreSkipped)
+{
+    cache.exportChanged(*store);
+    const int id = characters[5]->getId();
+    EXPECT_TRUE(cache.untrack(id));
+    EXPECT_FALSE(cache.contains(id));
+    characters[5]->takeDamage(3);
+    characters[9]->takeDamage(3);
+    EXPECT_EQ(cache.exportChanged(*store), 1);
+    EXPECT_EQ(cache.size(), characters.size() - 1);
+    // El último ocupa el hueco del eliminado
+    EXPECT_NE(cache.getReport(characters[9]->getId()), nullptr);
+}
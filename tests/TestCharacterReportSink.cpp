@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "CharacterReportSink.h"
+#include "Character.h"
+
+// System includes
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+using namespace noname;
+using namespace testing;
+
+struct TestCharacterReportSink : Test
+{
+    void SetUp() override
+    {
+        RS.setShardCount(1);
+        RS.startUp();
+    }
+    void TearDown() override
+    {
+        RS.shutDown();
+        RS.setShardCount(1);
+        RS.setReportOnChange(false);
+    }
+
+    static std::string readFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+};
+
+TEST_F(TestCharacterReportSink, constructionDoesNotQueueReports)
+{
+    auto pending = RS.getPendingCount();
+    Character character{"Silent"};
+    EXPECT_EQ(RS.getPendingCount(), pending);
+}
+
+TEST_F(TestCharacterReportSink, reportOnChangeQueuesReports)
+{
+    RS.setReportOnChange(true);
+    auto pending = RS.getPendingCount();
+    Character character{"Loud"};
+    EXPECT_EQ(RS.getPendingCount(), pending + 1);
+}
+
+TEST_F(TestCharacterReportSink, flushWritesConsolidatedFile)
+{
+    Character character{"Reported"};
+    character.writeCharacterInfo();
+    RS.flush();
+    EXPECT_EQ(RS.getPendingCount(), 0);
+
+    auto content = readFile(RS.getShardPath(0));
+    EXPECT_NE(content.find("Character Info: " + std::to_string(character.getId())), std::string::npos);
+}
+
+TEST_F(TestCharacterReportSink, reportsAreShardedById)
+{
+    RS.setShardCount(4);
+    std::vector<std::unique_ptr<Character>> characters;
+    for (int i = 0; i < 8; ++i)
+    {
+        characters.push_back(std::make_unique<Character>());
+        characters.back()->writeCharacterInfo();
+    }
+    RS.flush();
+
+    for (const auto &character : characters)
+    {
+        auto content = readFile(RS.getShardPath(character->getId() % 4));
+        EXPECT_NE(content.find("Character Info: " + std::to_string(character->getId())), std::string::npos);
+    }
+}
+
+TEST_F(TestCharacterReportSink, backgroundFlushDrainsQueue)
+{
+    RS.setBatchSize(1);
+    RS.startBackgroundFlush(std::chrono::milliseconds(5));
+    Character character{"Background"};
+    character.writeCharacterInfo();
+    RS.stopBackgroundFlush();
+    EXPECT_EQ(RS.getPendingCount(), 0);
+    auto content = readFile(RS.getShardPath(0));
+    EXPECT_NE(content.find("Character Info: " + std::to_string(character.getId())), std::string::npos);
+    RS.flush();
+    RS.setBatchSize(1024);
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include "CharacterStore.h"
+#include "Character.h"
+#include "WorldManager.h"
+
+// System includes
+#include <thread>
+
+using namespace noname;
+using namespace testing;
+
+TEST(TestCharacterStore, allocateAndRelease)
+{
+    CharacterStore store;
+    auto first = store.allocate(10);
+    auto second = store.allocate(11);
+    EXPECT_EQ(store.size(), 2);
+    EXPECT_EQ(store.liveCount(), 2);
+    EXPECT_EQ(store.id(second), 11);
+
+    store.release(first);
+    EXPECT_EQ(store.liveCount(), 1);
+    EXPECT_FALSE(store.isLive(first));
+
+    // El slot liberado se reutiliza con valores por defecto
+    store.health(second).takeDamage(30);
+    auto third = store.allocate(12);
+    EXPECT_EQ(third, first);
+    EXPECT_EQ(store.size(), 2);
+    EXPECT_EQ(store.health(third).current, HealthData{}.current);
+}
+
+TEST(TestCharacterStore, bulkPassesSkipReleasedRows)
+{
+    CharacterStore store;
+    auto alive = store.allocate(1);
+    auto released = store.allocate(2);
+    store.release(released);
+
+    store.applyDamage(10);
+    EXPECT_EQ(store.health(alive).current, HealthData{}.current - 10);
+
+    store.regenerate(4, 0);
+    EXPECT_EQ(store.health(alive).current, HealthData{}.current - 6);
+}
+
+TEST(TestCharacterStore, characterIsFacadeOverRow)
+{
+    auto store = std::make_shared<CharacterStore>();
+    Character character{"Hero", store};
+    EXPECT_EQ(store->liveCount(), 1);
+    EXPECT_EQ(store->id(character.getStoreSlot()), character.getId());
+
+    character.takeDamage(5);
+    EXPECT_EQ(store->health(character.getStoreSlot()).current, character.getCurrentHealth());
+
+    Character copy{character};
+    EXPECT_EQ(store->liveCount(), 2);
+    EXPECT_EQ(copy.getCurrentHealth(), character.getCurrentHealth());
+
+    Character moved{std::move(copy)};
+    EXPECT_EQ(store->liveCount(), 2);
+}
+
+TEST(TestCharacterStore, rowIsReleasedOnDestruction)
+{
+    auto store = std::make_shared<CharacterStore>();
+    {
+        Character character{"Ephemeral", store};
+        EXPECT_EQ(store->liveCount(), 1);
+    }
+    EXPECT_EQ(store->liveCount(), 0);
+}
+
+TEST(TestCharacterStore, worldTickRegeneratesCreatures)
+{
+    Creature prototype{"Wolf", CreatureType::BEAST};
+    World.spawnCreatures(prototype, 100);
+    auto &store = World.getStore();
+    EXPECT_GE(store.liveCount(), 100);
+
+    store.applyDamage(3);
+    World.tick();
+    for (const auto &creature : World.getCreatures())
+    {
+        EXPECT_LE(creature->getCurrentHealth(), creature->getMaxHealth());
+        EXPECT_FALSE(creature->isDead());
+    }
+    World.shutDown();
+    EXPECT_EQ(World.getStore().liveCount(), 0);
+}
+
+TEST(TestCharacterStore, touchedRowsAreListedOnce)
+{
+    CharacterStore store;
+    auto first = store.allocate(1);
+    auto second = store.allocate(2);
+    std::vector<CharacterStore::Slot> dirty;
+    store.takeDirtySlots(dirty);
+    EXPECT_EQ(dirty.size(), 2);
+    EXPECT_EQ(store.dirtyCount(), 0);
+
+    const auto version = store.version(first);
+    store.touch(first);
+    store.touch(first);
+    EXPECT_EQ(store.version(first), version + 2);
+    store.takeDirtySlots(dirty);
+    ASSERT_EQ(dirty.size(), 1);
+    EXPECT_EQ(dirty[0], first);
+
+    // Las filas que ya están al máximo no se marcan al regenerar
+    store.health(second).takeDamage(5);
+    store.regenerate(1, 0);
+    store.takeDirtySlots(dirty);
+    ASSERT_EQ(dirty.size(), 1);
+    EXPECT_EQ(dirty[0], second);
+}
+
+TEST(TestCharacterStore, characterChangesBumpStateVersion)
+{
+    auto store = std::make_shared<CharacterStore>();
+    Character character{"Hero", store};
+    auto version = character.getStateVersion();
+
+    character.takeDamage(5);
+    EXPECT_GT(character.getStateVersion(), version);
+    version = character.getStateVersion();
+
+    character.gainExperience(10);
+    EXPECT_GT(character.getStateVersion(), version);
+    version = character.getStateVersion();
+
+    character.useMana(1);
+    EXPECT_GT(character.getStateVersion(), version);
+    version = character.getStateVersion();
+
+    character.pick(std::make_shared<Item>("Amulet", ItemType::AMULET, ItemRank::NORMAL), ItemSlotType::AMULET);
+    EXPECT_GT(character.getStateVersion(), version);
+    version = character.getStateVersion();
+
+    // Leer no cambia la versión
+    EXPECT_EQ(character.getCurrentHealth(), character.getCurrentHealth());
+    EXPECT_EQ(character.getStateVersion(), version);
+}
+
+TEST(TestCharacterStore, storeBelongsToOneThread)
+{
+    CharacterStore store;
+    store.allocate(1);
+    bool threw = false;
+    std::thread{[&]
+                {
+                    try
+                    {
+                        store.allocate(2);
+                    }
+                    catch (const std::logic_error &)
+                    {
+                        threw = true;
+                    }
+                }}
+        .join();
+    EXPECT_TRUE(threw);
+    EXPECT_EQ(store.size(), 1);
+
+    // Liberar desde otro hilo no toca la lista de libres
+    const auto slot = store.allocate(3);
+    std::thread{[&store, slot]
+                { store.release(slot); }}
+        .join();
+    EXPECT_EQ(store.liveCount(), 2);
+    store.release(slot);
+    EXPECT_EQ(store.liveCount(), 1);
+
+    // Cada hilo tiene su propio almacén por defecto
+    const CharacterStore *mine = CharacterStore::defaultStore().get();
+    const CharacterStore *theirs = nullptr;
+    std::thread{[&theirs]
+                { theirs = CharacterStore::defaultStore().get(); }}
+        .join();
+    EXPECT_NE(mine, theirs);
+}
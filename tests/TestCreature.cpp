@@ -28,4 +28,20 @@ TEST_F(TestCreature, findPredatorOf)
 TEST_F(TestCreature, findPreyOf)
 {
     EXPECT_TRUE(CM.findPreyOf("Cat").size() > 0);
-}
\ No newline at end of file
+}
+TEST_F(TestCreature, findPreyOfReturnsRegisteredCreatures)
+{
+    auto prey = CM.findPreyOf("Cat");
+    ASSERT_EQ(prey.size(), 1);
+    EXPECT_EQ(prey[0], CM.getCreature("Rat"));
+    EXPECT_EQ(CM.findPredatorOf("Rat")[0], CM.getCreature("Cat"));
+    EXPECT_EQ(CM.findCreature(prey[0]->getId()), prey[0]);
+}
+
+TEST_F(TestCreature, predatorsMayAttackPrey)
+{
+    const auto &cat = *CM.getCreature("Cat");
+    const auto &rat = *CM.getCreature("Rat");
+    EXPECT_TRUE(CM.mayAttack(cat, rat));
+    EXPECT_FALSE(CM.mayAttack(cat, cat));
+}
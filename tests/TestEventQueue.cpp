@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include "EventQueue.h"
+#include "EventSubject.h"
+#include "Character.h"
+
+// System includes
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace noname;
+using namespace testing;
+
+// Guarda cuántas veces se llamó a onEvents y el tamaño de cada lote
+class TestBatchObserver : public EventObserver
+{
+public:
+    void onEvent(const Event &event) override { types.push_back(event.getType()); }
+    void onEvents(std::span<const Event> events) override
+    {
+        batches.push_back(events.size());
+        EventObserver::onEvents(events);
+    }
+
+    std::vector<size_t> batches;
+    std::vector<EventType> types;
+};
+
+struct TestEventQueue : Test
+{
+    void SetUp() override { EQ.startUp(); }
+    void TearDown() override { EQ.shutDown(); }
+};
+
+TEST_F(TestEventQueue, deferredEventsAreDeliveredInOneBatch)
+{
+    auto observer = std::make_shared<TestBatchObserver>();
+    std::vector<std::unique_ptr<Character>> characters;
+    for (int i = 0; i < 10; ++i)
+    {
+        characters.push_back(std::make_unique<Character>("Deferred"));
+        characters.back()->setDeferredNotifications(true);
+        characters.back()->subscribe(observer);
+    }
+
+    for (auto &character : characters)
+    {
+        character->takeDamage(1); // DAMAGE_TAKEN + HEALTH_CHANGED
+    }
+    EXPECT_TRUE(observer->types.empty());
+    EXPECT_EQ(EQ.getPendingCount(), 20u);
+
+    EXPECT_EQ(EQ.flush(), 20u);
+    ASSERT_EQ(observer->batches, (std::vector<size_t>{20}));
+    EXPECT_EQ(observer->types.front(), EventType::DAMAGE_TAKEN);
+    EXPECT_EQ(observer->types.back(), EventType::HEALTH_CHANGED);
+    EXPECT_EQ(EQ.getPendingCount(), 0u);
+    EXPECT_EQ(EQ.flush(), 0u);
+}
+
+TEST_F(TestEventQueue, destroyedSubjectDiscardsPendingEvents)
+{
+    auto observer = std::make_shared<TestBatchObserver>();
+    auto kept = std::make_unique<Character>("Kept");
+    auto dropped = std::make_unique<Character>("Dropped");
+    for (auto *character : {kept.get(), dropped.get()})
+    {
+        character->setDeferredNotifications(true);
+        character->subscribe(observer);
+        character->gainExperience(10);
+    }
+    EXPECT_EQ(EQ.getPendingCount(), 2u);
+
+    dropped.reset();
+    EXPECT_EQ(EQ.getPendingCount(), 1u);
+    EXPECT_EQ(EQ.flush(), 1u);
+    EXPECT_EQ(observer->types, (std::vector<EventType>{EventType::EXPERIENCE_GAINED}));
+}
+
+TEST_F(TestEventQueue, immediateModeStillNotifiesSynchronously)
+{
+    auto observer = std::make_shared<TestBatchObserver>();
+    Character character{"Immediate"};
+    character.subscribe(observer);
+    character.gainExperience(10);
+    EXPECT_EQ(observer->types.size(), 1u);
+    EXPECT_TRUE(observer->batches.empty());
+    EXPECT_EQ(EQ.getPendingCount(), 0u);
+}
+
+TEST_F(TestEventQueue, movedSubjectKeepsPendingEvents)
+{
+    auto observer = std::make_shared<TestBatchObserver>();
+    auto source = std::make_unique<Character>("Moved");
+    source->setDeferredNotifications(true);
+    source->subscribe(observer);
+    source->gainExperience(10);
+
+    auto target = std::make_unique<Character>(std::move(*source));
+    source.reset();
+    EXPECT_EQ(EQ.getPendingCount(), 1u);
+
+    // Asignar por movimiento descarta los eventos que tenía el destino
+    Character other{"Other"};
+    other.setDeferredNotifications(true);
+    other.subscribe(observer);
+    other.gainExperience(10);
+    EXPECT_EQ(EQ.getPendingCount(), 2u);
+    other = std::move(*target);
+    target.reset();
+    EXPECT_EQ(EQ.getPendingCount(), 1u);
+
+    EXPECT_EQ(EQ.flush(), 1u);
+    EXPECT_EQ(observer->types, (std::vector<EventType>{EventType::EXPERIENCE_GAINED}));
+}
+
+TEST_F(TestEventQueue, observerAtReusedAddressGetsItsOwnBatch)
+{
+    // Los dos observers ocupan la misma memoria, uno después del otro
+    alignas(TestBatchObserver) unsigned char storage[sizeof(TestBatchObserver)];
+    auto place = [&storage]()
+    {
+        return std::shared_ptr<TestBatchObserver>(new (storage) TestBatchObserver,
+                                                  [](TestBatchObserver *observer) { observer->~TestBatchObserver(); });
+    };
+
+    auto first = place();
+    EQ.enqueue(nullptr, first, first.get(), Event(EventType::LEVEL_UP));
+    first.reset();
+
+    auto second = place();
+    ASSERT_EQ(static_cast<void *>(second.get()), static_cast<void *>(storage));
+    EQ.enqueue(nullptr, second, second.get(), Event(EventType::SKILL_USED));
+
+    EQ.flush();
+    EXPECT_EQ(second->types, (std::vector<EventType>{EventType::SKILL_USED}));
+}
+
+TEST_F(TestEventQueue, queuedEventsOwnTheirNames)
+{
+    std::vector<std::string> names;
+    class NameObserver : public EventObserver
+    {
+    public:
+        explicit NameObserver(std::vector<std::string> &names) : names_(names) {}
+        void onEvent(const Event &event) override
+        {
+            const auto &payload = event.payload<EventType::DAMAGE_DEALT>();
+            names_.emplace_back(payload.sourceName);
+            names_.emplace_back(payload.targetName);
+        }
+
+    private:
+        std::vector<std::string> &names_;
+    };
+    auto observer = std::make_shared<NameObserver>(names);
+
+    auto attacker = std::make_unique<std::string>("An attacker with a long name");
+    auto target = std::make_unique<std::string>("A target with a long name");
+    EQ.enqueue(nullptr, observer, observer.get(),
+               Event::make<EventType::DAMAGE_DEALT>({1, 2, 5, 10, 1, false, *attacker, *target}));
+    // Los personajes pueden desaparecer o renombrarse antes del flush
+    *attacker = "Renamed attacker with another long name";
+    target.reset();
+
+    EXPECT_EQ(EQ.flush(), 1u);
+    EXPECT_EQ(names, (std::vector<std::string>{"An attacker with a long name", "A target with a long name"}));
+}
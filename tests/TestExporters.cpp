@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include "Exporters.h"
+#include "RankingManager.h"
+
+// System includes
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace noname;
+using namespace testing;
+
+namespace
+{
+    std::vector<std::string> splitLines(const std::string &text)
+    {
+        std::vector<std::string> lines;
+        std::istringstream in(text);
+        for (std::string line; std::getline(in, line);)
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+}
+
+TEST(TestExporters, tableWriterEscapesEachFormat)
+{
+    static constexpr std::array<std::string_view, 2> columns{"id", "name"};
+    std::ostringstream csv;
+    {
+        TableWriter writer{csv, ExportFormat::Csv, columns};
+        writer.beginRow().field(1).field("plain").endRow();
+        writer.beginRow().field(2).field("a,\"b\"").endRow();
+    }
+    EXPECT_EQ(csv.str(), "id,name\n1,plain\n2,\"a,\"\"b\"\"\"\n");
+
+    std::ostringstream json;
+    {
+        TableWriter writer{json, ExportFormat::JsonLines, columns};
+        writer.beginRow().field(-3).field("q\"\\\n\x01").endRow();
+        EXPECT_EQ(writer.getRowCount(), 1u);
+    }
+    EXPECT_EQ(json.str(), "{\"id\":-3,\"name\":\"q\\\"\\\\\\n\\u0001\"}\n");
+}
+
+TEST(TestExporters, characterStatsComeFromStoreColumns)
+{
+    auto store = std::make_shared<CharacterStore>();
+    std::vector<std::unique_ptr<Character>> characters;
+    for (int i = 0; i < 3; ++i)
+    {
+        characters.push_back(std::make_unique<Character>("Exported", store));
+    }
+    characters[1]->takeDamage(7);
+
+    std::ostringstream csv;
+    EXPECT_EQ(exportCharacterStats(*store, csv, ExportFormat::Csv), 3u);
+    auto lines = splitLines(csv.str());
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_EQ(lines[0].substr(0, 24), "id,health,max_health,man");
+    const auto expected = std::to_string(characters[1]->getId()) + "," + std::to_string(characters[1]->getCurrentHealth()) + ",";
+    EXPECT_EQ(lines[2].substr(0, expected.size()), expected);
+
+    std::ostringstream json;
+    EXPECT_EQ(exportCharacterStats(*store, json, ExportFormat::JsonLines), 3u);
+    EXPECT_NE(json.str().find("\"id\":" + std::to_string(characters[0]->getId()) + ",\"health\":"), std::string::npos);
+
+    std::vector<const Character *> view;
+    for (const auto &character : characters)
+    {
+        view.push_back(character.get());
+    }
+    std::ostringstream profiles;
+    EXPECT_EQ(exportCharacterProfiles(view, profiles, ExportFormat::JsonLines), 3u);
+    EXPECT_NE(profiles.str().find("\"name\":\"Exported\",\"level\":"), std::string::npos);
+    EXPECT_NE(profiles.str().find("\"good_looking\":"), std::string::npos);
+}
+
+TEST(TestExporters, inventoriesListOccupiedSlots)
+{
+    Character character{"Collector"};
+    character.pick(std::make_shared<Item>("Amulet, \"lucky\"", ItemType::AMULET, ItemRank::NORMAL), ItemSlotType::AMULET);
+    std::vector<const Character *> view{&character};
+
+    std::ostringstream csv;
+    EXPECT_EQ(exportInventories(view, csv, ExportFormat::Csv), 1u);
+    auto lines = splitLines(csv.str());
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_NE(lines[1].find(",AMULET,"), std::string::npos);
+    EXPECT_NE(lines[1].find("\"Amulet, \"\"lucky\"\"\""), std::string::npos);
+}
+
+TEST(TestExporters, rankingsExportPerSkillFile)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "noname_ranking_export";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    RM.startUp();
+    RANKING_DISTANCE.updatePlayer(5, 30, 2);
+    RANKING_DISTANCE.updatePlayer(6, 40, 3);
+    RM.publishSnapshots();
+    EXPECT_EQ(RM.exportRankings(ExportFormat::JsonLines, directory), 2u);
+
+    std::ifstream file(directory / "Ranking-DISTANCE.jsonl");
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), "{\"rank\":1,\"player_id\":6,\"level\":3,\"skill\":40}\n"
+                             "{\"rank\":2,\"player_id\":5,\"level\":2,\"skill\":30}\n");
+    EXPECT_TRUE(std::filesystem::exists(directory / "Ranking-CLUB.jsonl"));
+    RM.shutDown();
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include "Factions.h"
+
+// System includes
+#include <array>
+#include <vector>
+
+using namespace noname;
+using namespace testing;
+
+struct TestFactions : Test
+{
+    Factions factions;
+    Factions::FactionId humans{}, elves{}, dwarves{}, orcs{};
+
+    void SetUp() override
+    {
+        humans = factions.addFaction("Humans");
+        elves = factions.addFaction("Elves");
+        dwarves = factions.addFaction("Dwarves");
+        orcs = factions.addFaction("Orcs");
+        factions.join(1, humans);
+        factions.join(2, elves);
+        factions.join(3, dwarves);
+        factions.join(4, orcs);
+    }
+};
+
+TEST_F(TestFactions, hostilityIsSymmetric)
+{
+    factions.setHostile(humans, orcs);
+    EXPECT_TRUE(factions.mayAttack(1, 4));
+    EXPECT_TRUE(factions.mayAttack(4, 1));
+    EXPECT_FALSE(factions.mayAttack(1, 2));
+    EXPECT_EQ(factions.getRelationship(humans, elves), Relationship::NEUTRAL);
+    EXPECT_EQ(factions.getRelationship(humans, orcs), Relationship::ENEMY);
+    EXPECT_EQ(factions.getRelationship(humans, humans), Relationship::FRIEND);
+}
+
+TEST_F(TestFactions, unknownFactionsAreIgnored)
+{
+    factions.setHostile(humans, Factions::NO_FACTION);
+    factions.setHostile(Factions::FactionId{200}, orcs);
+    factions.declareWar(Factions::NO_FACTION, orcs);
+    for (auto faction : {humans, elves, dwarves})
+    {
+        EXPECT_FALSE(factions.areHostile(faction, orcs));
+    }
+}
+
+TEST_F(TestFactions, joiningUnknownFactionIsRejected)
+{
+    factions.setHostile(humans, orcs);
+    EXPECT_FALSE(factions.join(4, Factions::FactionId{300}));
+    EXPECT_FALSE(factions.join(5, Factions::NO_FACTION));
+    EXPECT_EQ(factions.getFaction(4), orcs);
+    EXPECT_EQ(factions.getFaction(5), Factions::NO_FACTION);
+    EXPECT_TRUE(factions.mayAttack(1, 4));
+    EXPECT_FALSE(factions.mayAttack(1, 5));
+}
+
+TEST_F(TestFactions, unknownFactionsHaveNoAlliance)
+{
+    factions.ally(humans, Factions::NO_FACTION);
+    const std::array<std::pair<Factions::FactionId, Factions::FactionId>, 2> pairs{{{Factions::FactionId{300}, elves}, {dwarves, orcs}}};
+    factions.mergeAlliances(pairs);
+    EXPECT_EQ(factions.getAlliance(humans), humans);
+    EXPECT_EQ(factions.getAlliance(elves), elves);
+    EXPECT_TRUE(factions.areAllied(dwarves, orcs));
+
+    factions.leaveAlliance(Factions::NO_FACTION);
+    const std::array<Factions::FactionId, 2> leaving{Factions::FactionId{300}, orcs};
+    factions.splitAlliances(leaving);
+    EXPECT_FALSE(factions.areAllied(dwarves, orcs));
+
+    EXPECT_EQ(factions.getAlliance(Factions::NO_FACTION), Factions::NO_FACTION);
+    EXPECT_FALSE(factions.areAllied(Factions::NO_FACTION, Factions::NO_FACTION));
+    EXPECT_FALSE(factions.areAllied(humans, Factions::FactionId{300}));
+}
+
+TEST_F(TestFactions, unknownFactionsAreNeutral)
+{
+    EXPECT_FALSE(factions.areHostile(humans, Factions::NO_FACTION));
+    EXPECT_FALSE(factions.areHostile(Factions::FactionId{300}, humans));
+    EXPECT_EQ(factions.getRelationship(humans, Factions::NO_FACTION), Relationship::NEUTRAL);
+    EXPECT_EQ(factions.getRelationship(Factions::FactionId{300}, Factions::FactionId{300}), Relationship::NEUTRAL);
+}
+
+TEST_F(TestFactions, entitiesWithoutFactionAreNeverTargets)
+{
+    factions.setHostile(humans, orcs);
+    EXPECT_FALSE(factions.mayAttack(1, 99));
+    EXPECT_FALSE(factions.mayAttack(99, 1));
+    EXPECT_TRUE(factions.leave(4));
+    EXPECT_FALSE(factions.mayAttack(1, 4));
+    EXPECT_EQ(factions.getFaction(4), Factions::NO_FACTION);
+}
+
+TEST_F(TestFactions, alliesAreNeverHostile)
+{
+    factions.setHostile(humans, elves);
+    factions.ally(humans, elves);
+    EXPECT_TRUE(factions.areAllied(humans, elves));
+    EXPECT_FALSE(factions.mayAttack(1, 2));
+    EXPECT_EQ(factions.getRelationship(elves, humans), Relationship::FRIEND);
+
+    // Al romper la alianza vuelve la hostilidad anterior
+    factions.leaveAlliance(elves);
+    EXPECT_TRUE(factions.mayAttack(1, 2));
+}
+
+TEST_F(TestFactions, bulkMergeAndSplit)
+{
+    const std::array<std::pair<Factions::FactionId, Factions::FactionId>, 2> pairs{{{humans, elves}, {elves, dwarves}}};
+    factions.mergeAlliances(pairs);
+    EXPECT_TRUE(factions.areAllied(humans, dwarves));
+    EXPECT_FALSE(factions.areAllied(humans, orcs));
+
+    // Los humanos se van: elfos y enanos siguen aliados aunque se unieron a través de ellos
+    const std::array<Factions::FactionId, 1> leaving{humans};
+    factions.splitAlliances(leaving);
+    EXPECT_FALSE(factions.areAllied(humans, elves));
+    EXPECT_TRUE(factions.areAllied(elves, dwarves));
+}
+
+TEST_F(TestFactions, declareWarCoversWholeAlliances)
+{
+    factions.ally(humans, elves);
+    factions.declareWar(elves, orcs);
+    EXPECT_TRUE(factions.mayAttack(1, 4));
+    EXPECT_TRUE(factions.mayAttack(2, 4));
+    EXPECT_FALSE(factions.mayAttack(3, 4));
+}
+
+TEST_F(TestFactions, matrixGrowsPastOneWord)
+{
+    std::vector<Factions::FactionId> created;
+    for (int i = 0; i < 130; ++i)
+    {
+        created.push_back(factions.addFaction("Clan"));
+    }
+    factions.setHostile(humans, orcs);
+    factions.setHostile(created.back(), humans);
+    factions.join(500, created.back());
+    EXPECT_TRUE(factions.mayAttack(500, 1));
+    EXPECT_TRUE(factions.mayAttack(1, 4));
+    EXPECT_FALSE(factions.mayAttack(500, 4));
+    EXPECT_EQ(factions.findFaction("Orcs"), orcs);
+}
+
+TEST_F(TestFactions, filterTargets)
+{
+    factions.setHostile(humans, orcs);
+    factions.setHostile(humans, dwarves);
+    factions.join(5, orcs);
+    const std::vector<int> candidates{2, 3, 4, 5, 99};
+    std::vector<int> targets;
+    factions.filterTargets(1, candidates, targets);
+    EXPECT_EQ(targets, (std::vector<int>{3, 4, 5}));
+}
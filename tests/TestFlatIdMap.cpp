@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "FlatIdMap.h"
+
+// System includes
+#include <unordered_map>
+#include <random>
+
+using namespace noname;
+using namespace testing;
+
+TEST(TestFlatIdMap, insertFindErase)
+{
+    FlatIdMap<int> map;
+    EXPECT_EQ(map.find(3), nullptr);
+
+    auto [value, inserted] = map.tryEmplace(3, 30);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(value, 30);
+    EXPECT_FALSE(map.tryEmplace(3, 31).second);
+    EXPECT_EQ(*map.find(3), 30);
+
+    EXPECT_TRUE(map.erase(3));
+    EXPECT_FALSE(map.erase(3));
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(TestFlatIdMap, matchesUnorderedMap)
+{
+    FlatIdMap<int> map;
+    std::unordered_map<int, int> reference;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> ids(0, 5000);
+    for (int i = 0; i < 20000; ++i)
+    {
+        int id = ids(rng);
+        if (rng() % 3 == 0)
+        {
+            EXPECT_EQ(map.erase(id), reference.erase(id) == 1);
+        }
+        else
+        {
+            map.tryEmplace(id, id * 2);
+            reference.emplace(id, id * 2);
+        }
+    }
+    EXPECT_EQ(map.size(), reference.size());
+    size_t visited = 0;
+    map.forEach([&](int id, int value)
+    {
+        ++visited;
+        EXPECT_EQ(reference.at(id), value);
+    });
+    EXPECT_EQ(visited, reference.size());
+}
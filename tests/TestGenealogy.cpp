@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "Genealogy.h"
+#include "Character.h"
+
+using namespace noname;
+using namespace testing;
+
+// Fundadores 1-4; 5 y 6 hermanos (1 x 2), 7 hijo de 3 x 4,
+// 8 hijo de 5 x 7, 9 hijo de 6 x 7 y 10 hijo de los primos 8 x 9
+struct TestGenealogy : Test
+{
+    Genealogy genealogy;
+
+    void SetUp() override
+    {
+        for (int founder = 1; founder <= 4; ++founder)
+        {
+            genealogy.addMember(founder);
+        }
+        genealogy.addMember(5, 1, 2);
+        genealogy.addMember(6, 1, 2);
+        genealogy.addMember(7, 3, 4);
+        genealogy.addMember(8, 5, 7);
+        genealogy.addMember(9, 6, 7);
+        genealogy.addMember(10, 8, 9);
+    }
+};
+
+TEST_F(TestGenealogy, parentsMustBeRegisteredFirst)
+{
+    EXPECT_EQ(genealogy.addMember(11, 42, 1), Genealogy::NONE);
+    EXPECT_EQ(genealogy.addMember(5), Genealogy::NONE);
+    EXPECT_EQ(genealogy.size(), 10);
+}
+
+TEST_F(TestGenealogy, insertionOrderIsTopological)
+{
+    const auto &order = genealogy.getTopologicalOrder();
+    auto position = [&order](int id) { return std::find(order.begin(), order.end(), id) - order.begin(); };
+    EXPECT_LT(position(5), position(8));
+    EXPECT_LT(position(7), position(9));
+    EXPECT_LT(position(9), position(10));
+    EXPECT_EQ(genealogy.getGeneration(1), 0);
+    EXPECT_EQ(genealogy.getGeneration(7), 1);
+    EXPECT_EQ(genealogy.getGeneration(10), 3);
+}
+
+TEST_F(TestGenealogy, ancestorsWithinGenerationsHaveNoRepeats)
+{
+    auto parents = genealogy.getAncestors(10, 1);
+    EXPECT_EQ(parents, (std::vector<int>{8, 9}));
+
+    // 7 llega por las dos ramas pero aparece una sola vez
+    auto grandparents = genealogy.getAncestors(10, 2);
+    EXPECT_EQ(grandparents.size(), 5);
+    EXPECT_EQ(std::count(grandparents.begin(), grandparents.end(), 7), 1);
+
+    EXPECT_EQ(genealogy.getAncestors(10, 10).size(), 9);
+    EXPECT_TRUE(genealogy.getAncestors(1, 5).empty());
+}
+
+TEST_F(TestGenealogy, mostRecentCommonAncestor)
+{
+    EXPECT_EQ(genealogy.getMostRecentCommonAncestor(8, 9), 7);
+    EXPECT_EQ(genealogy.getMostRecentCommonAncestor(5, 6), 1);
+    EXPECT_EQ(genealogy.getMostRecentCommonAncestor(10, 5), 5);
+    EXPECT_EQ(genealogy.getMostRecentCommonAncestor(5, 7), std::nullopt);
+    EXPECT_EQ(genealogy.getMostRecentCommonAncestor(10, 1, 1), std::nullopt);
+}
+
+TEST_F(TestGenealogy, kinshipCoefficients)
+{
+    EXPECT_DOUBLE_EQ(genealogy.getKinship(1, 1), 0.5);
+    EXPECT_DOUBLE_EQ(genealogy.getKinship(1, 5), 0.25);
+    EXPECT_DOUBLE_EQ(genealogy.getKinship(5, 6), 0.25);
+    EXPECT_DOUBLE_EQ(genealogy.getKinship(1, 3), 0.0);
+    // Medio hermanos por 7 (1/8) y primos hermanos por 5 x 6 (1/16)
+    EXPECT_DOUBLE_EQ(genealogy.getKinship(8, 9), 0.1875);
+    EXPECT_DOUBLE_EQ(genealogy.getInbreeding(10), 0.1875);
+    EXPECT_DOUBLE_EQ(genealogy.getInbreeding(8), 0.0);
+    EXPECT_GT(genealogy.getCachedKinshipCount(), 0);
+}
+
+TEST_F(TestGenealogy, kinshipHorizonTreatsOlderMembersAsFounders)
+{
+    genealogy.setKinshipHorizon(2);
+    EXPECT_EQ(genealogy.getCachedKinshipCount(), 0);
+    // 7 pasa a ser un fundador compartido: solo quedan medio hermanos
+    EXPECT_DOUBLE_EQ(genealogy.getKinship(8, 9), 0.125);
+    genealogy.setKinshipHorizon(3);
+    EXPECT_DOUBLE_EQ(genealogy.getKinship(8, 9), 0.0);
+    genealogy.setKinshipHorizon(0);
+    EXPECT_DOUBLE_EQ(genealogy.getKinship(8, 9), 0.1875);
+}
+
+TEST_F(TestGenealogy, signaturesRejectUnrelatedMembers)
+{
+    EXPECT_TRUE(genealogy.mayShareRecentAncestor(8, 9));
+    EXPECT_TRUE(genealogy.mayShareRecentAncestor(10, 1));
+    // Las firmas nunca dan falsos negativos
+    for (int a = 1; a <= 10; ++a)
+    {
+        for (int b = 1; b <= 10; ++b)
+        {
+            if (genealogy.getMostRecentCommonAncestor(a, b, Genealogy::SIGNATURE_GENERATIONS))
+            {
+                EXPECT_TRUE(genealogy.mayShareRecentAncestor(a, b)) << a << " " << b;
+            }
+        }
+    }
+}
+
+TEST_F(TestGenealogy, addChildTakesCharacters)
+{
+    Character father{"Father"}, mother{"Mother"}, child{"Child"};
+    Genealogy family;
+    family.addMember(father.getId());
+    family.addMember(mother.getId());
+    EXPECT_NE(family.addChild(child, father, mother), Genealogy::NONE);
+    EXPECT_EQ(family.getAncestors(child.getId(), 1).size(), 2);
+}
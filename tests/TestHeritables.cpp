@@ -1,8 +1,167 @@
 #include <gtest/gtest.h>
 
-#include "FileManager.h"
+#include "Heritables.h"
+#include "Rng.h"
+
+// System includes
+#include <atomic>
+#include <limits>
+#include <thread>
 
 using namespace noname;
 using namespace testing;
 
-// TBD
\ No newline at end of file
+TEST(TestRng, sameSeedGivesSameSequence)
+{
+    Rng first{1234}, second{1234}, other{1235};
+    bool differs = false;
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto value = first();
+        ASSERT_EQ(value, second());
+        differs |= value != other();
+    }
+    ASSERT_TRUE(differs);
+}
+
+TEST(TestRng, uniformIntStaysInRangeAndCoversIt)
+{
+    Rng rng{7};
+    std::array<int, 7> counts{};
+    for (int i = 0; i < 7000; ++i)
+    {
+        const int value = rng.uniformInt(-3, 3);
+        ASSERT_GE(value, -3);
+        ASSERT_LE(value, 3);
+        ++counts[static_cast<size_t>(value + 3)];
+    }
+    for (int count : counts)
+    {
+        ASSERT_GT(count, 800);
+        ASSERT_LT(count, 1200);
+    }
+    ASSERT_EQ(rng.uniformInt(5, 5), 5);
+}
+
+TEST(TestRng, uniformIndexCoversRangesPastInt)
+{
+    Rng rng{7};
+    const std::uint64_t range = std::uint64_t{1} << 40;
+    bool pastInt = false;
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto value = rng.uniformIndex(range);
+        ASSERT_LT(value, range);
+        pastInt |= value > static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+    }
+    ASSERT_TRUE(pastInt);
+
+    // uniformInt es uniformIndex desplazado: misma secuencia con la misma semilla
+    Rng ints{9}, indices{9};
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(ints.uniformInt(5, 104), 5 + static_cast<int>(indices.uniformIndex(100)));
+    }
+}
+
+TEST(TestRng, uniformRealIsInUnitInterval)
+{
+    Rng rng{7};
+    for (int i = 0; i < 1000; ++i)
+    {
+        const double value = rng.uniformReal();
+        ASSERT_GE(value, 0.0);
+        ASSERT_LT(value, 1.0);
+    }
+}
+
+TEST(TestRng, threadLocalEnginesAreIndependent)
+{
+    Rng &mine = Rng::threadLocal();
+    Rng *theirs = nullptr;
+    std::thread{[&theirs]
+                { theirs = &Rng::threadLocal(); }}
+        .join();
+    ASSERT_NE(&mine, theirs);
+
+    Rng::setDefaultSeed(99);
+    Rng expected{99};
+    ASSERT_EQ(Rng::threadLocal()(), expected());
+}
+
+TEST(TestRng, defaultSeedReseedsThreadsAlreadyRunning)
+{
+    // Un hilo que ya usaba su generador antes de fijar la semilla
+    std::atomic<int> step{0};
+    Rng::result_type before = 0, after = 0;
+    std::thread worker{[&]
+                       {
+                           before = Rng::threadLocal()();
+                           step = 1;
+                           while (step != 2)
+                           {
+                               std::this_thread::yield();
+                           }
+                           after = Rng::threadLocal()();
+                       }};
+    while (step != 1)
+    {
+        std::this_thread::yield();
+    }
+    Rng::setDefaultSeed(7);
+    step = 2;
+    worker.join();
+
+    Rng expected{Rng::mix(7 ^ Rng::mix(1))};
+    ASSERT_EQ(after, expected());
+    ASSERT_NE(before, after);
+}
+
+TEST(TestHeritables, sameSeedGivesSameHeritables)
+{
+    Rng first{42}, second{42};
+    Heritables a{first}, b{second};
+    ASSERT_EQ(a.values(), b.values());
+    for (auto value : a.values())
+    {
+        ASSERT_LE(value, Heritables::MAX_VALUE);
+    }
+}
+
+TEST(TestHeritables, childInheritsFromParents)
+{
+    Heritables father{Heritables::Values{10, 20, 30, 40, 50, 60}};
+    Heritables mother{Heritables::Values{90, 80, 70, 60, 50, 40}};
+    Rng rng{3};
+    size_t inherited = 0, genes = 0;
+    for (int child = 0; child < 1000; ++child)
+    {
+        Heritables offspring{Heritables::Values{}};
+        offspring.determineHeritablesValues(father, mother, rng);
+        for (size_t i = 0; i < Heritables::COUNT; ++i)
+        {
+            const auto value = offspring.values()[i];
+            ASSERT_GE(value, 1);
+            ASSERT_LE(value, Heritables::MAX_VALUE);
+            inherited += value == father.values()[i] || value == mother.values()[i];
+            ++genes;
+        }
+    }
+    // Un 10% de los genes mutan; algunas mutaciones dejan el valor igual
+    ASSERT_GT(inherited, genes * 85 / 100);
+    ASSERT_LT(inherited, genes * 97 / 100);
+}
+
+TEST(TestHeritables, breedingIsReproducible)
+{
+    Rng parents{5};
+    Heritables father{parents}, mother{parents};
+    Heritables first{Heritables::Values{}}, second{Heritables::Values{}};
+    Rng a{8}, b{8};
+    for (int generation = 0; generation < 20; ++generation)
+    {
+        first.determineHeritablesValues(father, mother, a);
+        second.determineHeritablesValues(father, mother, b);
+        ASSERT_EQ(first.values(), second.values());
+    }
+}
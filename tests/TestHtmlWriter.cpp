@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include "HtmlWriter.h"
+#include "HtmlBuilder.h"
+#include "Property.h"
+
+// System includes
+#include <sstream>
+#include <string>
+
+using namespace noname;
+using namespace testing;
+
+TEST(TestHtmlWriter, matchesHtmlBuilderLayout)
+{
+    HtmlBuilder table{"table"};
+    table.add_child("caption", "Ranking of: CLUB");
+    table.add_child(HtmlBuilder{"tr"}.add_child("td", "7").add_child("td", "12"));
+
+    std::string html;
+    HtmlWriter writer{html};
+    writer.open("table");
+    writer.element("caption", "Ranking of: CLUB");
+    writer.open("tr").element("td", 7).element("td", 12).close();
+    writer.close();
+
+    EXPECT_EQ(html, table.str());
+    EXPECT_EQ(writer.getDepth(), 0u);
+}
+
+TEST(TestHtmlWriter, escapesTextAndWritesNumbers)
+{
+    std::string html;
+    HtmlWriter writer{html};
+    writer.element("td", "<b>Tom & \"Jerry's\"</b>");
+    writer.open("td").text("hp: ", -5, " / ", 18446744073709551615ULL).closeAll();
+
+    EXPECT_EQ(html, "<td>\n  &lt;b&gt;Tom &amp; &quot;Jerry&#39;s&quot;&lt;/b&gt;\n</td>\n"
+                    "<td>\n  hp: -5 / 18446744073709551615\n</td>\n");
+}
+
+TEST(TestHtmlWriter, streamsIntoOstreamInChunks)
+{
+    std::ostringstream out;
+    {
+        HtmlWriter writer{out, 64};
+        writer.open("table");
+        for (int row = 0; row < 100; ++row)
+        {
+            writer.open("tr").element("td", row).close();
+            EXPECT_LT(writer.getDepth(), 3u);
+        }
+        writer.close();
+        // Lo ya vaciado está en el stream antes de terminar
+        EXPECT_FALSE(out.str().empty());
+    }
+    const auto html = out.str();
+    EXPECT_EQ(html.rfind("</table>\n"), html.size() - 9);
+    EXPECT_NE(html.find("    <td>\n      99\n    </td>\n"), std::string::npos);
+}
+
+TEST(TestHtmlWriter, propertyRowMatchesHtmlBuilder)
+{
+    Property<int> health{42};
+    Property<std::string> name{"A<B"};
+
+    std::string html;
+    HtmlWriter writer{html};
+    health.writeHtml(writer, "Health");
+    EXPECT_EQ(html, health.toHtmlBuilder("Health").str());
+
+    html.clear();
+    name.writeHtml(writer, "Name");
+    EXPECT_NE(html.find("A&lt;B"), std::string::npos);
+}
+
+TEST(TestHtmlWriter, elementsBeyondMaxDepthAreSkipped)
+{
+    std::string html;
+    HtmlWriter writer{html};
+    for (size_t i = 0; i < HtmlWriter::MAX_DEPTH; ++i)
+    {
+        writer.open("div");
+    }
+    const size_t written = html.size();
+    writer.open("span").element("b", "lost").text("lost").close();
+    EXPECT_EQ(html.size(), written);
+    EXPECT_EQ(writer.getDepth(), HtmlWriter::MAX_DEPTH);
+
+    writer.closeAll();
+    EXPECT_EQ(writer.getDepth(), 0u);
+    EXPECT_EQ(html.find("</>"), std::string::npos);
+    EXPECT_EQ(html.find("span"), std::string::npos);
+}
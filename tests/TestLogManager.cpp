@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
 
 #include "LogManager.h"
+#include "Skill.h"
+
+// System includes
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <thread>
+#include <vector>
+#include <csignal>
+#include <unistd.h>
 
 using namespace noname;
 using namespace testing;
@@ -16,4 +26,262 @@ TEST(TestLogManager, setLevel)
     LogManager::getInstance().setLevel(Level::Error);
     auto level{LogManager::getInstance().getLevel()};
     EXPECT_EQ(level, Level::Error);
-}
\ No newline at end of file
+}
+
+TEST(TestLogManager, ringBufferKeepsOrderAndCapacity)
+{
+    LogRingBuffer ring{4};
+    EXPECT_EQ(ring.capacity(), 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(ring.tryPush({Level::Info, std::chrono::system_clock::now(), std::to_string(i)}));
+    }
+    EXPECT_FALSE(ring.tryPush({Level::Info, std::chrono::system_clock::now(), "overflow"}));
+
+    LogRecord record;
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.tryPop(record));
+        EXPECT_EQ(record.message, std::to_string(i));
+    }
+    EXPECT_FALSE(ring.tryPop(record));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(TestLogManager, asyncModeDrainsEveryRecordOnShutDown)
+{
+    std::filesystem::remove(LOGFILE_NAME);
+    LM.setLevel(Level::Debug);
+    LM.setOverflowPolicy(OverflowPolicy::Block);
+    LM.setAsync(true, 64);
+    LM.startUp();
+
+    constexpr int THREADS = 4;
+    constexpr int RECORDS = 500;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        producers.emplace_back([t]()
+        {
+            for (int i = 0; i < RECORDS; ++i)
+            {
+                LM.writeLog(Level::Debug, "worker " + std::to_string(t) + " record " + std::to_string(i));
+            }
+        });
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    LM.shutDown();
+    LM.setAsync(false);
+
+    std::ifstream log(LOGFILE_NAME);
+    std::string line;
+    int workerLines = 0;
+    while (std::getline(log, line))
+    {
+        if (line.find(" : worker ") != std::string::npos)
+        {
+            ++workerLines;
+        }
+    }
+    EXPECT_EQ(workerLines, THREADS * RECORDS);
+}
+
+TEST(TestLogManager, togglingAsyncWhileLoggingKeepsEveryRecord)
+{
+    std::filesystem::remove(LOGFILE_NAME);
+    LM.setLevel(Level::Debug);
+    LM.setOverflowPolicy(OverflowPolicy::Block);
+    LM.setAsync(true, 16);
+    LM.startUp();
+
+    constexpr int THREADS = 3;
+    constexpr int RECORDS = 2000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        producers.emplace_back([]()
+        {
+            for (int i = 0; i < RECORDS; ++i)
+            {
+                LM.writeLog(Level::Debug, "toggle record");
+            }
+        });
+    }
+    // Cada cambio para el escritor y, si cambia la capacidad, sustituye la cola
+    for (int i = 0; i < 50; ++i)
+    {
+        LM.setAsync(i % 3 != 0, i % 2 ? 16 : 32);
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    LM.shutDown();
+    LM.setAsync(false);
+
+    std::ifstream log(LOGFILE_NAME);
+    std::string line;
+    int records = 0;
+    while (std::getline(log, line))
+    {
+        records += line.find(" : toggle record") != std::string::npos;
+    }
+    EXPECT_EQ(records, THREADS * RECORDS);
+}
+
+TEST(TestLogManager, fatalSignalChainsToPreviousHandler)
+{
+    std::filesystem::remove(LOGFILE_NAME);
+    EXPECT_EXIT(
+        {
+            std::signal(SIGABRT, [](int)
+                        { _exit(3); });
+            LM.setLevel(Level::Debug);
+            LM.setAsync(true);
+            LM.startUp();
+            LM.writeLog(Level::Error, "last words");
+            std::raise(SIGABRT);
+        },
+        ExitedWithCode(3), "");
+
+    std::ifstream log(LOGFILE_NAME);
+    std::stringstream content;
+    content << log.rdbuf();
+    EXPECT_NE(content.str().find("last words"), std::string::npos);
+}
+
+TEST(TestLogManager, dropAndCountPolicyCountsDrops)
+{
+    LM.setLevel(Level::Debug);
+    LM.setOverflowPolicy(OverflowPolicy::DropAndCount);
+    LM.setAsync(true, 2);
+    LM.startUp();
+    for (int i = 0; i < 10000; ++i)
+    {
+        LM.writeLog(Level::Debug, "burst");
+    }
+    LM.flush();
+    auto dropped = LM.getDroppedCount();
+    LM.shutDown();
+    LM.setAsync(false);
+    LM.setOverflowPolicy(OverflowPolicy::Block);
+    // Con una cola de 2 registros el escritor no puede seguir el ritmo de la ráfaga
+    EXPECT_GT(dropped, 0);
+}
+
+TEST(TestLogManager, deferredFormatFillsPlaceholders)
+{
+    std::string out;
+    logformat::formatTo(out, "base({}) + skill({}) = {} {}", 3, short(4), 7ULL, "ok");
+    EXPECT_EQ(out, "base(3) + skill(4) = 7 ok");
+
+    out.clear();
+    logformat::formatTo(out, "{{literal}} {} {}", SkillType::CLUB, 1.5);
+    EXPECT_EQ(out, "{literal} CLUB 1.5");
+
+    out.clear();
+    logformat::formatTo(out, "missing {} and {}", 1);
+    EXPECT_EQ(out, "missing 1 and {}");
+}
+
+TEST(TestLogManager, deferredFormatSkipsDisabledLevels)
+{
+    LM.setLevel(Level::Error);
+    bool evaluated = false;
+    LM.log<Level::Debug>("expensive {}", [&evaluated]()
+                         { evaluated = true; return std::string("value"); });
+    EXPECT_FALSE(evaluated);
+    EXPECT_FALSE(LM.isEnabled(Level::Debug));
+    LM.setLevel(Level::Debug);
+}
+
+TEST(TestLogManager, binaryRecordsDecodeToText)
+{
+    std::string data;
+    binarylog::encodeSession<std::chrono::system_clock>(data);
+    binarylog::encodeRecord(data, 0, static_cast<std::uint8_t>(Level::Warning), 1, 42, "Orc", SkillType::CLUB, true);
+    // A definition may come after the first record that uses it
+    binarylog::encodeFormat(data, 1, "hit {} on {} with {}: {}");
+
+    std::ostringstream out;
+    binarylog::Decoder decoder;
+    ASSERT_TRUE(decoder.decode(data, out)) << decoder.getError();
+    EXPECT_EQ(decoder.getRecordCount(), 1u);
+    EXPECT_NE(out.str().find("[Warning] : hit 42 on Orc with CLUB: true\n"), std::string::npos);
+
+    data.resize(data.size() - 3);
+    EXPECT_FALSE(decoder.decode(data, out));
+}
+
+TEST(TestLogManager, binaryDecoderRendersRecordsBeforeTruncatedTail)
+{
+    std::string data;
+    binarylog::encodeSession<std::chrono::system_clock>(data);
+    binarylog::encodeFormat(data, 1, "record {}");
+    binarylog::encodeRecord(data, 0, static_cast<std::uint8_t>(Level::Info), 1, 1);
+    binarylog::encodeRecord(data, 0, static_cast<std::uint8_t>(Level::Info), 1, 2);
+    const size_t complete = data.size();
+    binarylog::encodeRecord(data, 0, static_cast<std::uint8_t>(Level::Info), 1, 3);
+    data.resize(complete + 5);
+
+    std::ostringstream out;
+    binarylog::Decoder decoder;
+    EXPECT_FALSE(decoder.decode(data, out));
+    EXPECT_EQ(decoder.getError(), "truncated record at offset " + std::to_string(complete));
+    EXPECT_EQ(decoder.getRecordCount(), 2u);
+    EXPECT_NE(out.str().find("[Info] : record 1\n"), std::string::npos);
+    EXPECT_NE(out.str().find("[Info] : record 2\n"), std::string::npos);
+}
+
+TEST(TestLogManager, binaryOutputRoundTrip)
+{
+    for (bool async : {false, true})
+    {
+        std::filesystem::remove(BINARY_LOGFILE_NAME);
+        LM.setOutput(LogOutput::Binary);
+        LM.setAsync(async);
+        LM.startUp();
+        for (int i = 0; i < 3; ++i)
+        {
+            LM.log<Level::Info>("binary {} of {}", i, std::string("three"));
+        }
+        LM.writeLog(Level::Error, "plain message");
+        LM.shutDown();
+        LM.setAsync(false);
+        LM.setOutput(LogOutput::Text);
+
+        std::ifstream file(BINARY_LOGFILE_NAME, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+
+        std::ostringstream out;
+        binarylog::Decoder decoder;
+        ASSERT_TRUE(decoder.decode(content.str(), out)) << decoder.getError();
+        auto text = out.str();
+        for (int i = 0; i < 3; ++i)
+        {
+            EXPECT_NE(text.find("[Info] : binary " + std::to_string(i) + " of three\n"), std::string::npos);
+        }
+        EXPECT_NE(text.find("[Error] : plain message\n"), std::string::npos);
+        EXPECT_NE(text.find("-- Closing the game --"), std::string::npos);
+    }
+}
+
+TEST(TestLogManager, setOutputWaitsForNextStartUp)
+{
+    std::filesystem::remove(LOGFILE_NAME);
+    LM.setLevel(Level::Debug);
+    LM.startUp();
+    LM.setOutput(LogOutput::Binary);
+    LM.writeLog(Level::Info, "still text");
+    LM.shutDown();
+    LM.setOutput(LogOutput::Text);
+
+    std::ifstream log(LOGFILE_NAME);
+    std::stringstream content;
+    content << log.rdbuf();
+    EXPECT_NE(content.str().find(" : still text\n"), std::string::npos);
+}
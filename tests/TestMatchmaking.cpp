@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "Matchmaking.h"
+#include "Character.h"
+
+// System includes
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace noname;
+using namespace testing;
+
+struct TestMatchmaking : Test
+{
+    using HeritableArray = std::array<short, HeritablesKdTree::DIMENSIONS>;
+
+    std::vector<HeritableArray> population;
+    Matchmaker matchmaker;
+
+    void SetUp() override
+    {
+        std::mt19937 rng{11};
+        std::uniform_int_distribution<int> value{1, 100};
+        for (int id = 0; id < 2000; ++id)
+        {
+            HeritableArray heritables;
+            for (short &heritable : heritables)
+            {
+                heritable = static_cast<short>(value(rng));
+            }
+            population.push_back(heritables);
+            matchmaker.add(id, heritables);
+        }
+        matchmaker.build();
+    }
+
+    float weightedDistance(int a, int b) const
+    {
+        float sum = 0.0f;
+        for (size_t axis = 0; axis < HeritablesKdTree::DIMENSIONS; ++axis)
+        {
+            const float diff = static_cast<float>(population[a][axis] - population[b][axis]);
+            sum += Matchmaker::DEFAULT_WEIGHTS[axis] * diff * diff;
+        }
+        return sum;
+    }
+};
+
+TEST_F(TestMatchmaking, partnersMatchBruteForce)
+{
+    for (int id : {0, 17, 1999})
+    {
+        auto partners = matchmaker.findPartners(id, 5);
+        ASSERT_EQ(partners.size(), 5);
+
+        std::vector<float> expected;
+        for (int other = 0; other < static_cast<int>(population.size()); ++other)
+        {
+            if (other != id)
+            {
+                expected.push_back(weightedDistance(id, other));
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        for (size_t i = 0; i < partners.size(); ++i)
+        {
+            EXPECT_NE(partners[i].id, id);
+            EXPECT_NEAR(partners[i].distance, expected[i], 1e-2f);
+            EXPECT_NEAR(partners[i].distance, weightedDistance(id, partners[i].id), 1e-2f);
+        }
+    }
+}
+
+TEST_F(TestMatchmaking, acceptFilterIsApplied)
+{
+    std::vector<MatchCandidate> partners;
+    matchmaker.findPartners(3, 10, [](int, int candidate) { return candidate % 2 == 0; }, partners);
+    ASSERT_EQ(partners.size(), 10);
+    for (const auto &partner : partners)
+    {
+        EXPECT_EQ(partner.id % 2, 0);
+    }
+    EXPECT_TRUE(matchmaker.findPartners(-5, 3).empty());
+}
+
+TEST_F(TestMatchmaking, generationPairsAreDisjoint)
+{
+    WorkerPool pool{2};
+    auto pairs = matchmaker.pairGeneration(pool);
+    std::set<int> seen;
+    for (const auto &[a, b] : pairs)
+    {
+        EXPECT_NE(a, b);
+        EXPECT_TRUE(seen.insert(a).second);
+        EXPECT_TRUE(seen.insert(b).second);
+    }
+    // Con varias rondas casi nadie se queda sin pareja
+    EXPECT_GE(pairs.size(), population.size() / 2 - population.size() / 50);
+}
+
+TEST_F(TestMatchmaking, pairingDoesNotDependOnThreadCount)
+{
+    WorkerPool inline_{0};
+    WorkerPool threaded{3};
+    EXPECT_EQ(matchmaker.pairGeneration(inline_), matchmaker.pairGeneration(threaded));
+}
+
+TEST_F(TestMatchmaking, pairingRespectsAccept)
+{
+    WorkerPool pool{0};
+    auto pairs = matchmaker.pairGeneration(pool, [](int a, int b) { return (a % 2) != (b % 2); });
+    ASSERT_FALSE(pairs.empty());
+    for (const auto &[a, b] : pairs)
+    {
+        EXPECT_NE(a % 2, b % 2);
+    }
+}
+
+TEST(TestMatchmakingCharacters, charactersAreIndexedByHeritables)
+{
+    Character first{"First"}, second{"Second"}, third{"Third"};
+    const std::vector<const Character *> characters{&first, &second, &third};
+    Matchmaker matchmaker;
+    matchmaker.addAll<Character>(characters);
+    matchmaker.build();
+    EXPECT_EQ(matchmaker.size(), 3);
+    auto partners = matchmaker.findPartners(first.getId(), 5);
+    EXPECT_EQ(partners.size(), 2);
+}
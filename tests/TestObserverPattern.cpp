@@ -126,3 +126,255 @@ TEST_F(TestObserverPattern, CustomObserver) {
     EXPECT_EQ(counter->getEventCount(), 2);
     EXPECT_EQ(counter->getLastEventType(), EventType::DAMAGE_TAKEN);
 }
+
+TEST_F(TestObserverPattern, TypedPayloadAccessors) {
+    DamagePayload damage{};
+    damage.targetId = 7;
+    damage.damage = 12;
+    damage.remainingHealth = 30;
+    damage.targetName = "Victim";
+    Event event = Event::make<EventType::DAMAGE_TAKEN>(damage);
+
+    const auto& payload = event.payload<EventType::DAMAGE_TAKEN>();
+    EXPECT_EQ(payload.targetId, 7);
+    EXPECT_EQ(payload.damage, 12);
+    EXPECT_EQ(payload.targetName, "Victim");
+    EXPECT_NE(event.tryPayload<DamagePayload>(), nullptr);
+    EXPECT_EQ(event.tryPayload<LevelPayload>(), nullptr);
+
+    // Mismo payload, distinto EventType
+    EXPECT_THROW(event.payload<EventType::DAMAGE_DEALT>(), std::runtime_error);
+}
+
+TEST_F(TestObserverPattern, StringKeyAdapterReadsPayload) {
+    Event event(EventType::LEVEL_UP, LevelPayload{3, 4, 5, "Hero"});
+
+    EXPECT_EQ(event.getData<std::string>("character_name"), "Hero");
+    EXPECT_EQ(event.getData<int>("new_level"), 5);
+    EXPECT_EQ(event.getData<int>("old_level"), 4);
+    EXPECT_TRUE(event.hasData("character_id"));
+    EXPECT_FALSE(event.hasData("new_magic_level"));
+    EXPECT_THROW(event.getData<bool>("new_level"), std::runtime_error);
+    EXPECT_THROW(event.getData<int>("missing"), std::runtime_error);
+    EXPECT_EQ(event.getDataOrDefault<int>("missing", -1), -1);
+
+    // Los datos añadidos con setData siguen funcionando y tienen preferencia
+    event.setData<int>("new_level", 6);
+    event.setData<std::string>("note", "extra");
+    EXPECT_EQ(event.getData<int>("new_level"), 6);
+    EXPECT_EQ(event.getData<std::string>("note"), "extra");
+}
+
+TEST_F(TestObserverPattern, AchievementObserverReadsTypedEvents) {
+    DamagePayload dealt{};
+    dealt.sourceId = character->getId();
+    dealt.damage = 150;
+    dealt.sourceName = character->getNameView();
+    dealt.targetName = target->getNameView();
+    achievementTracker->onEvent(Event::make<EventType::DAMAGE_DEALT>(dealt));
+
+    EXPECT_EQ(achievementTracker->getTotalDamageDealt("TestHero"), 150);
+    auto achievements = achievementTracker->getUnlockedAchievements("TestHero");
+    EXPECT_NE(std::find(achievements.begin(), achievements.end(), "First Blood"), achievements.end());
+}
+
+// Observer que registra el orden de llegada y solo maneja un tipo de evento
+class TestOrderedObserver : public EventObserver {
+public:
+    TestOrderedObserver(std::vector<int>& log, int tag, int priority, EventType handled)
+        : log_(log), tag_(tag), priority_(priority), handled_(handled) {}
+
+    void onEvent(const Event&) override { log_.push_back(tag_); }
+    int getPriority() const override { return priority_; }
+    bool handlesEventType(EventType type) const override { return type == handled_; }
+
+    void setHandled(EventType type) {
+        handled_ = type;
+        invalidateSubscriptions();
+    }
+
+private:
+    std::vector<int>& log_;
+    int tag_;
+    int priority_;
+    EventType handled_;
+};
+
+TEST_F(TestObserverPattern, DispatchByTypeAndPriority) {
+    EventSubject subject;
+    std::vector<int> log;
+    auto low = std::make_shared<TestOrderedObserver>(log, 3, 300, EventType::LEVEL_UP);
+    auto high = std::make_shared<TestOrderedObserver>(log, 1, 10, EventType::LEVEL_UP);
+    auto other = std::make_shared<TestOrderedObserver>(log, 2, 50, EventType::DAMAGE_TAKEN);
+    subject.subscribe(low);
+    subject.subscribe(other);
+    subject.subscribe(high);
+
+    subject.notifyObservers(Event(EventType::LEVEL_UP));
+    EXPECT_EQ(log, (std::vector<int>{1, 3}));
+    EXPECT_EQ(subject.getObserverCountForEventType(EventType::LEVEL_UP), 2u);
+    EXPECT_EQ(subject.getObserverCountForEventType(EventType::MANA_CHANGED), 0u);
+
+    // Un cambio en handlesEventType se refleja tras invalidateSubscriptions()
+    log.clear();
+    other->setHandled(EventType::LEVEL_UP);
+    subject.notifyObservers(Event(EventType::LEVEL_UP));
+    EXPECT_EQ(log, (std::vector<int>{1, 2, 3}));
+
+    // Los observers destruidos se ignoran
+    log.clear();
+    high.reset();
+    subject.notifyObservers(Event(EventType::LEVEL_UP));
+    EXPECT_EQ(log, (std::vector<int>{2, 3}));
+    EXPECT_EQ(subject.getObserverCount(), 2u);
+
+    log.clear();
+    subject.unsubscribe(low);
+    subject.notifyObservers(Event(EventType::LEVEL_UP));
+    EXPECT_EQ(log, (std::vector<int>{2}));
+}
+
+// Suscribe otro observer al recibir el primer evento
+class TestSubscribingObserver : public EventObserver {
+public:
+    TestSubscribingObserver(EventSubject& subject, std::shared_ptr<EventObserver> next)
+        : subject_(subject), next_(std::move(next)) {}
+
+    void onEvent(const Event&) override {
+        ++count;
+        if (next_) {
+            subject_.subscribe(std::move(next_));
+            next_.reset();
+        }
+    }
+
+    int count = 0;
+
+private:
+    EventSubject& subject_;
+    std::shared_ptr<EventObserver> next_;
+};
+
+TEST_F(TestObserverPattern, SubscribeDuringNotification) {
+    EventSubject subject;
+    auto late = std::make_shared<TestSubscribingObserver>(subject, nullptr);
+    auto first = std::make_shared<TestSubscribingObserver>(subject, late);
+    subject.subscribe(first);
+
+    subject.notifyObservers(Event(EventType::SKILL_USED));
+    EXPECT_EQ(first->count, 1);
+    EXPECT_EQ(late->count, 0);
+
+    subject.notifyObservers(Event(EventType::SKILL_USED));
+    EXPECT_EQ(first->count, 2);
+    EXPECT_EQ(late->count, 1);
+}
+
+// Suelta el último shared_ptr a sí mismo dentro de su propio callback
+class TestSelfReleasingObserver : public EventObserver {
+public:
+    TestSelfReleasingObserver(std::shared_ptr<EventObserver>& holder, bool& destroyed, bool& aliveAfterRelease)
+        : holder_(holder), destroyed_(destroyed), aliveAfterRelease_(aliveAfterRelease) {}
+    ~TestSelfReleasingObserver() override { destroyed_ = true; }
+
+    void onEvent(const Event&) override {
+        holder_.reset();
+        aliveAfterRelease_ = !destroyed_;
+    }
+
+private:
+    std::shared_ptr<EventObserver>& holder_;
+    bool& destroyed_;
+    bool& aliveAfterRelease_;
+};
+
+TEST_F(TestObserverPattern, ObserverReleasedDuringItsCallbackStaysAlive) {
+    EventSubject subject;
+    bool destroyed = false, aliveAfterRelease = false;
+    // El subject solo guarda un weak_ptr: holder es la única referencia
+    std::shared_ptr<EventObserver> holder =
+        std::make_shared<TestSelfReleasingObserver>(holder, destroyed, aliveAfterRelease);
+    auto next = std::make_shared<TestSubscribingObserver>(subject, nullptr);
+    subject.subscribe(holder);
+    subject.subscribe(next);
+
+    subject.notifyObservers(Event(EventType::SKILL_USED));
+    EXPECT_TRUE(aliveAfterRelease);
+    EXPECT_TRUE(destroyed);
+    EXPECT_EQ(next->count, 1);
+
+    subject.notifyObservers(Event(EventType::SKILL_USED));
+    EXPECT_EQ(next->count, 2);
+}
+
+TEST_F(TestObserverPattern, WantsEventFollowsSubscriptions) {
+    EventSubject subject;
+    EXPECT_FALSE(subject.wantsEvent(EventType::LEVEL_UP));
+
+    std::vector<int> log;
+    auto observer = std::make_shared<TestOrderedObserver>(log, 1, 100, EventType::LEVEL_UP);
+    subject.subscribe(observer);
+    EXPECT_TRUE(subject.wantsEvent(EventType::LEVEL_UP));
+    EXPECT_FALSE(subject.wantsEvent(EventType::DAMAGE_TAKEN));
+
+    // La fábrica solo se invoca para los tipos con observers
+    int built = 0;
+    auto factory = [&built](EventType type) {
+        return [&built, type]() { ++built; return Event(type); };
+    };
+    subject.notifyObservers(EventType::DAMAGE_TAKEN, factory(EventType::DAMAGE_TAKEN));
+    EXPECT_EQ(built, 0);
+    subject.notifyObservers(EventType::LEVEL_UP, factory(EventType::LEVEL_UP));
+    EXPECT_EQ(built, 1);
+    EXPECT_EQ(log, (std::vector<int>{1}));
+
+    subject.unsubscribe(observer);
+    EXPECT_FALSE(subject.wantsEvent(EventType::LEVEL_UP));
+}
+
+TEST_F(TestObserverPattern, UnobservedCharacterBuildsNoEvents) {
+    Character loner{"Loner"};
+    EXPECT_FALSE(loner.wantsEvent(EventType::DAMAGE_TAKEN));
+    EXPECT_FALSE(loner.wantsEvent(EventType::HEALTH_CHANGED));
+    EXPECT_NO_THROW(loner.takeDamage(5));
+    EXPECT_NO_THROW(loner.gainExperience(5));
+}
+
+TEST_F(TestObserverPattern, AchievementsAreKeyedById) {
+    AchievementObserver achievements;
+    auto dealt = [](int id, int amount) {
+        DamagePayload payload{};
+        payload.sourceId = id;
+        payload.damage = amount;
+        payload.sourceName = "Twin";
+        return Event::make<EventType::DAMAGE_DEALT>(payload);
+    };
+
+    // Mismo nombre, personajes distintos
+    achievements.onEvent(dealt(1, 60));
+    achievements.onEvent(dealt(2, 60));
+    achievements.onEvent(dealt(1, 60));
+    EXPECT_EQ(achievements.getTotalDamageDealt(1), 120);
+    EXPECT_EQ(achievements.getTotalDamageDealt(2), 60);
+    EXPECT_TRUE(achievements.hasAchievement(1, AchievementObserver::Achievement::FIRST_BLOOD));
+    EXPECT_FALSE(achievements.hasAchievement(2, AchievementObserver::Achievement::FIRST_BLOOD));
+    EXPECT_EQ(achievements.getTrackedCharacterCount(), 2u);
+
+    // Un salto grande desbloquea todos los umbrales superados
+    achievements.onEvent(dealt(2, 6000));
+    EXPECT_EQ(achievements.getUnlockedAchievements(2),
+              (std::vector<std::string>{"First Blood", "Warrior", "Veteran Fighter"}));
+
+    achievements.onEvent(Event(EventType::LEVEL_UP, LevelPayload{1, 9, 10, "Twin"}));
+    EXPECT_EQ(achievements.getLevelsGained(1), 1);
+    EXPECT_TRUE(achievements.hasAchievement(1, AchievementObserver::Achievement::APPRENTICE));
+    EXPECT_TRUE(achievements.hasAchievement(1, AchievementObserver::Achievement::JOURNEYMAN));
+    EXPECT_FALSE(achievements.hasAchievement(1, AchievementObserver::Achievement::EXPERT));
+
+    for (int i = 0; i < 5; ++i) {
+        achievements.onEvent(Event(EventType::CHARACTER_DIED, CharacterPayload{2, 1, "Twin"}));
+    }
+    EXPECT_EQ(achievements.getDeaths(2), 5);
+    EXPECT_TRUE(achievements.hasAchievement(2, AchievementObserver::Achievement::PERSISTENT));
+    EXPECT_EQ(achievements.getDeaths(99), 0);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "OrderStatisticTree.h"
+
+// System includes
+#include <set>
+#include <random>
+#include <iterator>
+
+using namespace noname;
+using namespace testing;
+
+TEST(TestOrderStatisticTree, rankAndSelect)
+{
+    OrderStatisticTree<int> tree;
+    for (int key : {50, 10, 40, 20, 30})
+    {
+        EXPECT_TRUE(tree.insert(key));
+    }
+    EXPECT_FALSE(tree.insert(30));
+    EXPECT_EQ(tree.size(), 5u);
+    EXPECT_EQ(tree.rank(10), 0u);
+    EXPECT_EQ(tree.rank(50), 4u);
+    EXPECT_EQ(tree.rank(35), std::nullopt);
+    EXPECT_EQ(tree.select(2), 30);
+
+    EXPECT_TRUE(tree.erase(10));
+    EXPECT_FALSE(tree.erase(10));
+    EXPECT_EQ(tree.rank(20), 0u);
+    EXPECT_FALSE(tree.contains(10));
+
+    std::vector<int> page;
+    tree.forEachInRange(1, 2, [&page](size_t, int key) { page.push_back(key); });
+    EXPECT_EQ(page, (std::vector<int>{30, 40}));
+}
+
+TEST(TestOrderStatisticTree, matchesStdSet)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> keys(0, 3000);
+    OrderStatisticTree<int, std::greater<int>> tree;
+    std::set<int, std::greater<int>> reference;
+    for (int i = 0; i < 20000; ++i)
+    {
+        const int key = keys(rng);
+        if (i % 3 == 0)
+        {
+            EXPECT_EQ(tree.erase(key), reference.erase(key) == 1);
+        }
+        else
+        {
+            EXPECT_EQ(tree.insert(key), reference.insert(key).second);
+        }
+    }
+    ASSERT_EQ(tree.size(), reference.size());
+
+    size_t position = 0;
+    for (int key : reference)
+    {
+        ASSERT_EQ(tree.rank(key), position);
+        ASSERT_EQ(tree.select(position), key);
+        ++position;
+    }
+
+    // Un rango a mitad del árbol
+    std::vector<int> page;
+    tree.forEachInRange(100, 25, [&page](size_t, int key) { page.push_back(key); });
+    std::vector<int> expected(std::next(reference.begin(), 100), std::next(reference.begin(), 125));
+    EXPECT_EQ(page, expected);
+
+    // La carga masiva deja el mismo orden y admite cambios después
+    OrderStatisticTree<int, std::greater<int>> bulk;
+    bulk.assignSorted(std::vector<int>(reference.begin(), reference.end()));
+    ASSERT_EQ(bulk.size(), reference.size());
+    EXPECT_EQ(bulk.select(reference.size() / 2), *std::next(reference.begin(), static_cast<long>(reference.size() / 2)));
+    EXPECT_TRUE(bulk.insert(5000));
+    EXPECT_EQ(bulk.rank(5000), 0u);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include "PopulationStats.h"
+#include "Breeding.h"
+#include "Exporters.h"
+
+// System includes
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace noname;
+using namespace testing;
+
+namespace
+{
+    template <typename T, size_t N>
+    void expectSameMoments(const populationstats::Moments<T, N> &a, const populationstats::Moments<T, N> &b)
+    {
+        ASSERT_EQ(a.count, b.count);
+        ASSERT_EQ(a.sum, b.sum);
+        ASSERT_EQ(a.sumSquares, b.sumSquares);
+        ASSERT_EQ(a.min, b.min);
+        ASSERT_EQ(a.max, b.max);
+    }
+
+    std::vector<std::int16_t> randomSkills(size_t records, unsigned seed)
+    {
+        std::mt19937 rng{seed};
+        std::uniform_int_distribution<int> value{std::numeric_limits<std::int16_t>::min(), std::numeric_limits<std::int16_t>::max()};
+        std::vector<std::int16_t> values(records * CharacterStore::MAX_SKILLS);
+        for (auto &v : values)
+        {
+            v = static_cast<std::int16_t>(value(rng));
+        }
+        return values;
+    }
+}
+
+#ifdef NONAME_SIMD_SSE2
+TEST(TestPopulationStats, sse2MatchesScalarOnBytes)
+{
+    std::mt19937 rng{1};
+    std::vector<std::uint8_t> values(100003 * Heritables::COUNT);
+    for (auto &v : values)
+    {
+        v = static_cast<std::uint8_t>(rng());
+    }
+    for (size_t records : {size_t{0}, size_t{5}, size_t{16}, size_t{37}, size_t{100003}})
+    {
+        populationstats::Moments<std::uint8_t, Heritables::COUNT> scalar, simd;
+        populationstats::accumulateScalar(values.data(), records, scalar);
+        populationstats::accumulateSse2(values.data(), records, simd);
+        expectSameMoments(scalar, simd);
+    }
+}
+
+TEST(TestPopulationStats, sse2MatchesScalarOnShorts)
+{
+    // Valores extremos incluidos y bastantes bloques como para volcar las sumas de 32 bits
+    auto values = randomSkills(300007, 2);
+    values[0] = std::numeric_limits<std::int16_t>::min();
+    values[7] = std::numeric_limits<std::int16_t>::max();
+    for (size_t records : {size_t{3}, size_t{8}, size_t{300007}})
+    {
+        populationstats::Moments<std::int16_t, CharacterStore::MAX_SKILLS> scalar, simd;
+        populationstats::accumulateScalar(values.data(), records, scalar);
+        populationstats::accumulateSse2(values.data(), records, simd);
+        expectSameMoments(scalar, simd);
+    }
+}
+#endif
+
+TEST(TestPopulationStats, quantilesAreExact)
+{
+    auto values = randomSkills(5001, 3);
+    auto stats = populationstats::compute<std::int16_t, CharacterStore::MAX_SKILLS>(values.data(), 5001, {}, true, nullptr);
+    for (size_t skill = 0; skill < CharacterStore::MAX_SKILLS; ++skill)
+    {
+        std::vector<int> column;
+        for (size_t record = 0; record < 5001; ++record)
+        {
+            column.push_back(values[record * CharacterStore::MAX_SKILLS + skill]);
+        }
+        std::sort(column.begin(), column.end());
+        ASSERT_EQ(stats[skill].count, 5001u);
+        ASSERT_EQ(stats[skill].min, column.front());
+        ASSERT_EQ(stats[skill].max, column.back());
+        ASSERT_EQ(stats[skill].quantile(0.0), column.front());
+        ASSERT_EQ(stats[skill].quantile(0.5), column[2500]);
+        ASSERT_EQ(stats[skill].quantile(0.9), column[4500]);
+        ASSERT_EQ(stats[skill].quantile(1.0), column.back());
+    }
+}
+
+TEST(TestPopulationStats, storeStatsSkipFreeRows)
+{
+    CharacterStore store;
+    std::vector<CharacterStore::Slot> slots;
+    for (int id = 0; id < 1000; ++id)
+    {
+        slots.push_back(store.allocate(id));
+        store.heritables(slots.back()) = Heritables{Heritables::Values{10, 20, 30, 40, 50, 60}};
+        store.skills(slots.back()).fill(static_cast<short>(id % 2 ? 7 : 3));
+    }
+    // Filas liberadas (50 pares y 50 impares) con valores que no deben contar
+    for (int tens = 0; tens < 100; ++tens)
+    {
+        const int id = tens * 10 + tens % 2;
+        store.heritables(slots[id]) = Heritables{Heritables::Values{99, 99, 99, 99, 99, 99}};
+        store.release(slots[id]);
+    }
+
+    const PopulationReport report = computePopulationReport(store);
+    for (size_t heritable = 0; heritable < Heritables::COUNT; ++heritable)
+    {
+        ASSERT_EQ(report.heritables[heritable].count, 900u);
+        ASSERT_EQ(report.heritables[heritable].min, static_cast<int>(10 * (heritable + 1)));
+        ASSERT_EQ(report.heritables[heritable].max, static_cast<int>(10 * (heritable + 1)));
+        ASSERT_DOUBLE_EQ(report.heritables[heritable].variance(), 0.0);
+    }
+    for (const auto &skill : report.skills)
+    {
+        ASSERT_DOUBLE_EQ(skill.mean(), 5.0);
+        ASSERT_DOUBLE_EQ(skill.stddev(), 2.0);
+        ASSERT_EQ(skill.histogram, (std::vector<std::uint32_t>{450, 0, 0, 0, 450}));
+        ASSERT_EQ(skill.quantile(0.5), 3);
+        ASSERT_EQ(skill.quantile(0.51), 7);
+    }
+}
+
+TEST(TestPopulationStats, breedingPopulationStatsMatchGenerationStats)
+{
+    WorkerPool pool{2};
+    BreedingSimulator::Config config;
+    config.population = 200000;
+    BreedingSimulator simulator{config};
+    simulator.seedFounders(pool);
+    const GenerationStats &generation = simulator.step(pool);
+
+    const HeritableStats serial = computeHeritableStats(simulator.getPopulation());
+    const HeritableStats parallel = computeHeritableStats(simulator.getPopulation(), {true, &pool});
+    for (size_t heritable = 0; heritable < Heritables::COUNT; ++heritable)
+    {
+        ASSERT_NEAR(serial[heritable].mean(), generation.mean[heritable], 1e-9);
+        ASSERT_NEAR(serial[heritable].stddev(), generation.stddev[heritable], 1e-9);
+        ASSERT_EQ(serial[heritable].min, generation.min[heritable]);
+        ASSERT_EQ(serial[heritable].max, generation.max[heritable]);
+        ASSERT_EQ(serial[heritable].sum, parallel[heritable].sum);
+        ASSERT_EQ(serial[heritable].sumSquares, parallel[heritable].sumSquares);
+        ASSERT_EQ(serial[heritable].histogram, parallel[heritable].histogram);
+    }
+}
+
+TEST(TestPopulationStats, withoutHistogramsQuantilesFallBackToMin)
+{
+    std::vector<std::int16_t> values{1, 2, 3, 4, 5, 6, 11, 12, 13, 14, 15, 16};
+    auto stats = populationstats::compute<std::int16_t, CharacterStore::MAX_SKILLS>(values.data(), 2, {}, false, nullptr);
+    ASSERT_TRUE(stats[0].histogram.empty());
+    ASSERT_DOUBLE_EQ(stats[0].mean(), 6.0);
+    ASSERT_EQ(stats[0].quantile(0.5), 1);
+}
+
+TEST(TestPopulationStats, exportWritesOneRowPerAttribute)
+{
+    CharacterStore store;
+    store.allocate(1);
+    std::ostringstream out;
+    ASSERT_EQ(exportPopulationStats(computePopulationReport(store), out, ExportFormat::Csv), 12u);
+    ASSERT_EQ(out.str().rfind("group,attribute,count,mean,stddev,min,p25,p50,p75,p90,p99,max\n", 0), 0u);
+    ASSERT_NE(out.str().find("skill,SHIELDING,1,"), std::string::npos);
+}
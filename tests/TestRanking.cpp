@@ -5,6 +5,13 @@
 #include "Utils.h"
 #include "GameManager.h"
 
+// System includes
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+
 using namespace noname;
 using namespace testing;
 
@@ -29,9 +36,78 @@ TEST_F(TestRanking, addPlayer)
     RANKING_CLUB.startUp();
     Player player{};
     RANKING_CLUB.addPlayer(player);
-    std::vector<Player> ranking{RANKING_CLUB.getRanking()};
-    std::vector<Player> myRanking{std::move(player)};
+    RANKING_CLUB.publish();
+    std::vector<RankingEntry> ranking{RANKING_CLUB.getRanking()};
+    std::vector<RankingEntry> myRanking{{player.getId(), player.getSkill(SkillType::CLUB), player.getLevel()}};
     ASSERT_EQ(myRanking, ranking);
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(player.getId()), 0);
+    RANKING_CLUB.shutDown();
+}
+
+TEST_F(TestRanking, updateAndRemoveKeepOrder)
+{
+    RANKING_CLUB.startUp();
+    RANKING_CLUB.updatePlayer(1, 10, 3);
+    RANKING_CLUB.updatePlayer(2, 30, 5);
+    RANKING_CLUB.updatePlayer(3, 20, 4);
+    RANKING_CLUB.updatePlayer(4, 20, 1); // Empate: gana el id menor
+    // Las consultas leen la instantánea: sin publicar no ven los cambios
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(2), -1);
+    RANKING_CLUB.publish();
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(2), 0);
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(3), 1);
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(4), 2);
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(1), 3);
+
+    RANKING_CLUB.updatePlayer(1, 40, 6);
+    RANKING_CLUB.publish();
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(1), 0);
+    EXPECT_EQ(RANKING_CLUB.getRanking().front(), (RankingEntry{1, 40, 6}));
+
+    EXPECT_TRUE(RANKING_CLUB.removePlayer(2));
+    EXPECT_FALSE(RANKING_CLUB.removePlayer(2));
+    RANKING_CLUB.publish();
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(2), -1);
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(3), 1);
+    EXPECT_EQ(RANKING_CLUB.size(), 3u);
+    RANKING_CLUB.shutDown();
+}
+
+TEST_F(TestRanking, matchesSortedReference)
+{
+    RANKING_CLUB.startUp();
+    std::vector<RankingEntry> reference;
+    for (int id = 0; id < 2000; ++id)
+    {
+        RankingEntry entry{id, static_cast<short>(Utils::rollDie(1, 100)), 1};
+        reference.push_back(entry);
+        RANKING_CLUB.updatePlayer(entry.playerId, entry.skill, entry.level);
+    }
+    // Cambiar y borrar algunos
+    for (int id = 0; id < 2000; id += 7)
+    {
+        reference[id].skill = static_cast<short>(Utils::rollDie(1, 100));
+        RANKING_CLUB.updatePlayer(id, reference[id].skill, reference[id].level);
+    }
+    for (int id = 3; id < 2000; id += 11)
+    {
+        RANKING_CLUB.removePlayer(id);
+    }
+    std::erase_if(reference, [](const RankingEntry &entry) { return entry.playerId % 11 == 3; });
+    std::sort(reference.begin(), reference.end(), RankingOrder{});
+
+    RANKING_CLUB.publish();
+    EXPECT_EQ(RANKING_CLUB.getRanking(), reference);
+    for (size_t i = 0; i < reference.size(); i += 97)
+    {
+        EXPECT_EQ(RANKING_CLUB.getPlayerRanking(reference[i].playerId), static_cast<int>(i));
+    }
+
+    // La carga masiva da el mismo resultado
+    RANKING_CLUB.assignPlayers(reference);
+    RANKING_CLUB.publish();
+    EXPECT_EQ(RANKING_CLUB.getRanking(), reference);
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(reference.back().playerId), static_cast<int>(reference.size() - 1));
     RANKING_CLUB.shutDown();
 }
 
@@ -55,4 +131,137 @@ TEST_F(TestRanking, add100Players)
     RANKING_CLUB.shutDown();
     WM.shutDown();
     LM.shutDown();
-}
\ No newline at end of file
+}
+TEST_F(TestRanking, topKRangeAndAround)
+{
+    RANKING_CLUB.startUp();
+    for (int id = 0; id < 10; ++id)
+    {
+        RANKING_CLUB.updatePlayer(id, static_cast<short>(100 - id), 1); // El id 0 es el primero
+    }
+    RANKING_CLUB.publish();
+    auto top = RANKING_CLUB.topK(3);
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_EQ(top[0].playerId, 0);
+    EXPECT_EQ(top[2].playerId, 2);
+    EXPECT_EQ(RANKING_CLUB.topK(50).size(), 10u);
+
+    auto page = RANKING_CLUB.range(4, 3);
+    ASSERT_EQ(page.size(), 3u);
+    EXPECT_EQ(page.front().playerId, 4);
+    EXPECT_TRUE(RANKING_CLUB.range(10, 3).empty());
+
+    auto near = RANKING_CLUB.around(5, 2);
+    ASSERT_EQ(near.size(), 5u);
+    EXPECT_EQ(near.front().playerId, 3);
+    EXPECT_EQ(near.back().playerId, 7);
+    EXPECT_EQ(RANKING_CLUB.around(1, 3).size(), 5u); // Recortado por arriba
+    EXPECT_EQ(RANKING_CLUB.around(9, 3).size(), 4u); // Recortado por abajo
+    EXPECT_TRUE(RANKING_CLUB.around(42, 3).empty());
+    RANKING_CLUB.shutDown();
+}
+
+TEST_F(TestRanking, exportPagesWritesOneFilePerPage)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "noname_ranking_pages";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    RANKING_CLUB.startUp();
+    for (int id = 0; id < 25; ++id)
+    {
+        RANKING_CLUB.updatePlayer(id, static_cast<short>(id), 1);
+    }
+    RANKING_CLUB.publish();
+    EXPECT_EQ(RANKING_CLUB.getPageCount(10), 3u);
+    EXPECT_EQ(RANKING_CLUB.exportPages(10, directory), 3u);
+    EXPECT_FALSE(RANKING_CLUB.exportPage(4, 10, directory));
+
+    auto readPage = [&](size_t page)
+    {
+        std::ifstream file(RANKING_CLUB.getPagePath(page, directory));
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    };
+    auto last = readPage(3);
+    EXPECT_NE(last.find("Ranking of: CLUB (page 3 of 3)"), std::string::npos);
+    // La última página tiene las posiciones 21 a 25
+    EXPECT_NE(last.find("      21\n"), std::string::npos);
+    EXPECT_EQ(last.find("      20\n"), std::string::npos);
+    EXPECT_NE(readPage(1).find("      24\n"), std::string::npos); // Id del primero
+    RANKING_CLUB.shutDown();
+    std::filesystem::remove_all(directory);
+}
+
+TEST_F(TestRanking, snapshotsChangeOnlyOnPublish)
+{
+    RANKING_CLUB.startUp();
+    RANKING_CLUB.updatePlayer(1, 10, 1);
+    auto before = RANKING_CLUB.getSnapshot();
+    EXPECT_TRUE(RANKING_CLUB.hasUnpublishedChanges());
+
+    auto published = RANKING_CLUB.publish();
+    EXPECT_FALSE(RANKING_CLUB.hasUnpublishedChanges());
+    EXPECT_EQ(RANKING_CLUB.publish(), published); // Sin cambios no se copia otra vez
+    EXPECT_EQ(published->getRanking(), RANKING_CLUB.getRanking());
+    EXPECT_GT(published->getVersion(), before->getVersion());
+
+    // Los cambios posteriores no alteran la instantánea que ya tiene un lector
+    RANKING_CLUB.updatePlayer(2, 20, 1);
+    EXPECT_EQ(published->size(), 1u);
+    // Ni las consultas ni las exportaciones publican
+    EXPECT_EQ(RANKING_CLUB.getPlayerRanking(2), -1);
+    EXPECT_TRUE(RANKING_CLUB.hasUnpublishedChanges());
+    EXPECT_EQ(published->getPlayerRanking(2), -1);
+    auto next = RANKING_CLUB.publish();
+    EXPECT_EQ(next->getPlayerRanking(2), 0);
+    EXPECT_EQ(next->around(1, 1).size(), 2u);
+    RANKING_CLUB.shutDown();
+    EXPECT_EQ(RANKING_CLUB.getSnapshot()->size(), 0u);
+}
+
+TEST_F(TestRanking, readersSeeConsistentSnapshotsWhileWriting)
+{
+    RANKING_CLUB.startUp();
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r)
+    {
+        readers.emplace_back([&]()
+        {
+            std::uint64_t lastVersion = 0;
+            while (!done.load())
+            {
+                auto snapshot = RANKING_CLUB.getSnapshot();
+                const auto &rows = snapshot->getRanking();
+                // Cada instantánea está ordenada, indexada y nunca retrocede
+                bool ok = snapshot->getVersion() >= lastVersion &&
+                          std::is_sorted(rows.begin(), rows.end(), RankingOrder{});
+                for (size_t i = 0; ok && i < rows.size(); i += 17)
+                {
+                    ok = snapshot->getPlayerRanking(rows[i].playerId) == static_cast<int>(i);
+                }
+                inconsistent += ok ? 0 : 1;
+                lastVersion = snapshot->getVersion();
+            }
+        });
+    }
+    for (int tick = 0; tick < 200; ++tick)
+    {
+        for (int i = 0; i < 50; ++i)
+        {
+            RANKING_CLUB.updatePlayer(Utils::rollDie(0, 499), static_cast<short>(Utils::rollDie(1, 100)), 1);
+        }
+        RANKING_CLUB.publish();
+    }
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(inconsistent.load(), 0);
+    EXPECT_EQ(RANKING_CLUB.getSnapshot()->getRanking(), RANKING_CLUB.getRanking());
+    RANKING_CLUB.shutDown();
+}
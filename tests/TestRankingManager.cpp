@@ -1,8 +1,162 @@
 #include <gtest/gtest.h>
 
 #include "FileManager.h"
+#include "RankingManager.h"
+#include "EventQueue.h"
+
+// System includes
+#include <filesystem>
+#include <memory>
+#include <random>
 
 using namespace noname;
 using namespace testing;
 
-// TBD
\ No newline at end of file
+TEST(TestRankingManager, queriesRouteToSkillRanking)
+{
+    RM.startUp();
+    RANKING_SWORD.updatePlayer(1, 10, 1);
+    RANKING_SWORD.updatePlayer(2, 20, 1);
+    RANKING_AXE.updatePlayer(3, 5, 1);
+    RM.publishSnapshots();
+
+    auto top = RM.topK(SkillType::SWORD, 1);
+    ASSERT_EQ(top.size(), 1u);
+    EXPECT_EQ(top.front().playerId, 2);
+    EXPECT_EQ(RM.range(SkillType::SWORD, 1, 5).size(), 1u);
+    EXPECT_EQ(RM.around(SkillType::AXE, 3, 4).size(), 1u);
+    EXPECT_TRUE(RM.around(SkillType::AXE, 1, 4).empty());
+    EXPECT_EQ(RM.getPlayerRanking(1, SkillType::SWORD), 1);
+    EXPECT_EQ(RM.getPlayerRanking(1, SkillType::LAST_SKILL), -1);
+    RM.shutDown();
+}
+
+namespace
+{
+    // Expone setSkill para preparar los valores del ranking
+    struct RankedPlayer : Player
+    {
+        using Player::Player;
+        using Character::setSkill;
+        using Character::updateTries;
+    };
+}
+
+TEST(TestRankingManager, parallelRefreshMatchesSequential)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "noname_ranking_refresh";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    std::vector<std::unique_ptr<RankedPlayer>> owned;
+    std::vector<const Player *> players;
+    for (int i = 0; i < 300; ++i)
+    {
+        owned.push_back(std::make_unique<RankedPlayer>("Player" + std::to_string(i)));
+        owned.back()->setSkill(SkillType::SWORD, static_cast<short>(i % 37));
+        players.push_back(owned.back().get());
+    }
+
+    RM.startUp();
+    auto sequential = RM.refreshAll(players, 100, directory);
+    auto expected = RANKING_SWORD.getRanking();
+    EXPECT_EQ(sequential.threads, 0u);
+
+    WorkerPool pool{3};
+    auto parallel = RM.refreshAll(players, 100, pool, directory);
+    EXPECT_EQ(RANKING_SWORD.getRanking(), expected);
+    ASSERT_EQ(parallel.skills.size(), static_cast<size_t>(SkillType::LAST_SKILL));
+    for (const auto &timing : parallel.skills)
+    {
+        EXPECT_EQ(timing.players, players.size());
+        EXPECT_EQ(timing.pages, 3u);
+        EXPECT_TRUE(std::filesystem::exists(directory / ("Ranking-" + SkillToString(timing.skill) + "-page-3.html")));
+    }
+    EXPECT_EQ(parallel.threads, 3u);
+    RM.shutDown();
+    std::filesystem::remove_all(directory);
+}
+
+TEST(TestRankingManager, skillEventsKeepRankingsCurrent)
+{
+    LM.setLevel(Level::Error);
+    RM.startUp();
+    EQ.startUp();
+    auto observer = RM.getObserver();
+    const auto appliedBefore = observer->getAppliedUpdates();
+
+    std::vector<std::unique_ptr<RankedPlayer>> players;
+    for (int i = 0; i < 2000; ++i)
+    {
+        players.push_back(std::make_unique<RankedPlayer>("Stress" + std::to_string(i)));
+        players.back()->setDeferredNotifications(i % 2 == 0); // Mitad diferidos, como en el mundo
+        RM.addPlayer(*players.back());
+    }
+
+    // Cada tick todos los personajes entrenan; unos cuantos suben de skill
+    std::mt19937 rng(11);
+    unsigned long long expectedUpdates = 0;
+    for (int tick = 0; tick < 30; ++tick)
+    {
+        for (auto &player : players)
+        {
+            const auto skill = static_cast<SkillType>(rng() % static_cast<unsigned>(SkillType::LAST_SKILL));
+            const short before = player->getSkill(skill);
+            for (int tries = 0; tries < 20; ++tries)
+            {
+                player->updateTries(skill);
+            }
+            expectedUpdates += static_cast<unsigned long long>(player->getSkill(skill) - before);
+        }
+        EQ.flush();
+    }
+    ASSERT_GT(expectedUpdates, 0u);
+    EXPECT_EQ(observer->getAppliedUpdates() - appliedBefore, expectedUpdates);
+    RM.publishSnapshots();
+
+    for (int s = 0; s < static_cast<int>(SkillType::LAST_SKILL); ++s)
+    {
+        const auto skill = static_cast<SkillType>(s);
+        std::vector<RankingEntry> expected;
+        for (const auto &player : players)
+        {
+            expected.push_back({player->getId(), player->getSkill(skill), player->getLevel()});
+        }
+        std::sort(expected.begin(), expected.end(), RankingOrder{});
+        EXPECT_EQ(RM.topK(skill, expected.size()), expected) << SkillToString(skill);
+    }
+
+    // Los que salen del ranking dejan de recibir actualizaciones
+    RM.removePlayer(*players.front());
+    RM.publishSnapshots();
+    EXPECT_EQ(RM.getPlayerRanking(players.front()->getId(), SkillType::CLUB), -1);
+    players.front()->setSkill(SkillType::CLUB, 99);
+    EQ.flush();
+    EXPECT_EQ(RM.getPlayerRanking(players.front()->getId(), SkillType::CLUB), -1);
+
+    EQ.shutDown();
+    RM.shutDown();
+    LM.setLevel(Level::Debug);
+}
+
+TEST(TestRankingManager, snapshotsFollowTickCadence)
+{
+    RM.startUp();
+    RM.setSnapshotCadence(2);
+    RANKING_AXE.updatePlayer(7, 3, 1);
+    RM.onTick();
+    EXPECT_TRUE(RANKING_AXE.hasUnpublishedChanges());
+    RM.onTick();
+    EXPECT_FALSE(RANKING_AXE.hasUnpublishedChanges());
+    EXPECT_EQ(RANKING_AXE.getSnapshot()->getPlayerRanking(7), 0);
+
+    RM.setSnapshotCadence(0);
+    RANKING_AXE.updatePlayer(8, 4, 1);
+    RM.onTick();
+    RM.onTick();
+    EXPECT_TRUE(RANKING_AXE.hasUnpublishedChanges());
+    EXPECT_EQ(RM.publishSnapshots(), 1u);
+    EXPECT_EQ(RANKING_AXE.getSnapshot()->getPlayerRanking(8), 0);
+    RM.setSnapshotCadence(1);
+    RM.shutDown();
+}
@@ -60,3 +60,46 @@ TEST_F(TestRelationships, findWifeOf)
 {
     EXPECT_TRUE(relationships.find_wife_of("Husband").size() == 1);
 }
+
+TEST_F(TestRelationships, findReturnsIds)
+{
+    auto children = relationships.find_all_children_of("Husband");
+    ASSERT_EQ(children.size(), 2);
+    EXPECT_EQ(children[0], child1.getId());
+    EXPECT_EQ(children[1], child2.getId());
+    EXPECT_EQ(relationships.find_husband_of("Wife").front(), parent1.getId());
+    EXPECT_EQ(relationships.get_name(child1.getId()), "Child1");
+}
+
+TEST_F(TestRelationships, idQueriesFollowEdgeDirection)
+{
+    auto parents = relationships.parents_of(child2.getId());
+    ASSERT_EQ(parents.size(), 2);
+    EXPECT_EQ(parents[0], parent1.getId());
+    EXPECT_EQ(parents[1], parent2.getId());
+    EXPECT_EQ(relationships.wives_of(parent1.getId()).size(), 1);
+    EXPECT_TRUE(relationships.husbands_of(parent1.getId()).empty());
+    EXPECT_TRUE(relationships.children_of(-1).empty());
+}
+
+TEST_F(TestRelationships, repeatedEdgesAreIgnored)
+{
+    const size_t edges = relationships.edge_count();
+    relationships.add_husband_and_wife(parent1, parent2);
+    relationships.add_parents_and_child(parent1, parent2, child1);
+    EXPECT_EQ(relationships.edge_count(), edges);
+    EXPECT_EQ(relationships.node_count(), 4);
+}
+
+TEST_F(TestRelationships, namesSharedBySeveralEntitiesAreAggregated)
+{
+    Character cat1{"Cat"};
+    Character cat2{"Cat"};
+    Character rat{"Rat"};
+    Relationships<Character> hunting;
+    hunting.add_predator_and_prey(cat1, rat);
+    hunting.add_predator_and_prey(cat2, rat);
+    EXPECT_EQ(hunting.find_ids_named("Cat").size(), 2);
+    EXPECT_EQ(hunting.find_predator_of("Rat").size(), 2);
+    EXPECT_EQ(hunting.find_prey_of("Cat").size(), 2);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "WorkerPool.h"
+
+// System includes
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+using namespace noname;
+using namespace testing;
+
+TEST(TestWorkerPool, submitAndWait)
+{
+    for (size_t threads : {0, 1, 4})
+    {
+        WorkerPool pool{threads};
+        EXPECT_EQ(pool.getThreadCount(), threads);
+        auto answer = pool.submit([]() { return 42; });
+        EXPECT_EQ(pool.wait(answer), 42);
+
+        // Una tarea que espera subtareas no bloquea el pool, ni siquiera con un hilo
+        auto outer = pool.submit([&pool]()
+        {
+            std::vector<std::future<int>> inner;
+            for (int i = 1; i <= 8; ++i)
+            {
+                inner.push_back(pool.submit([i]() { return i; }));
+            }
+            int sum = 0;
+            for (auto &future : inner)
+            {
+                sum += pool.wait(future);
+            }
+            return sum;
+        });
+        EXPECT_EQ(pool.wait(outer), 36);
+
+        auto failing = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+        EXPECT_THROW(pool.wait(failing), std::runtime_error);
+    }
+}
+
+TEST(TestWorkerPool, parallelForCoversEveryIndex)
+{
+    WorkerPool pool{3};
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallelFor(hits.size(), 10, [&hits](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            ++hits[i];
+        }
+    });
+    for (const auto &hit : hits)
+    {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(TestWorkerPool, parallelForWaitsForEveryChunkBeforeThrowing)
+{
+    WorkerPool pool{3};
+    std::atomic<int> running{0}, finished{0};
+    // El primer trozo es el del hilo que llama: falla mientras los demás siguen
+    auto body = [&running, &finished](size_t begin, size_t)
+    {
+        if (begin == 0)
+        {
+            throw std::runtime_error("first chunk");
+        }
+        ++running;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ++finished;
+    };
+    EXPECT_THROW(pool.parallelFor(4000, 10, body), std::runtime_error);
+    EXPECT_EQ(finished.load(), running.load());
+    EXPECT_EQ(finished.load(), 3);
+}
+
+TEST(TestWorkerPool, parallelSortMatchesStdSort)
+{
+    std::mt19937 rng(3);
+    std::vector<int> values(50000);
+    for (auto &value : values)
+    {
+        value = static_cast<int>(rng() % 1000);
+    }
+    for (size_t threads : {0, 2, 4})
+    {
+        WorkerPool pool{threads};
+        auto sorted = values;
+        parallelSort(pool, sorted.begin(), sorted.end(), std::greater<int>{}, 1000);
+        auto expected = values;
+        std::sort(expected.begin(), expected.end(), std::greater<int>{});
+        EXPECT_EQ(sorted, expected);
+    }
+}
@@ -0,0 +1,42 @@
+// Renders a binary log written with LogOutput::Binary as text.
+//
+// Usage: noname_logdump [file]   (defaults to noname.binlog)
+
+// System includes
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Local includes
+#include "BinaryLog.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc > 2)
+    {
+        std::cerr << "Usage: noname_logdump [file]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string path = argc == 2 ? argv[1] : "noname.binlog";
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << "Error: cannot open " << path << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    const std::string data = content.str();
+
+    std::ios::sync_with_stdio(false);
+    noname::binarylog::Decoder decoder;
+    if (!decoder.decode(data, std::cout))
+    {
+        std::cout.flush();
+        std::cerr << "Error: " << path << ": " << decoder.getError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}